@@ -0,0 +1,279 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BVH_COMPRESSED_INL_H
+#define FCL_BVH_COMPRESSED_INL_H
+
+#include "fcl/geometry/bvh/BVH_compressed.h"
+
+#include "fcl/geometry/bvh/BVH_utility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+/// @brief Lower bound of a quantized interval inside [lo, hi]. q == 0 decodes
+/// exactly to lo.
+template <typename Q>
+float decodeQuantizedLower(float lo, float hi, Q q)
+{
+  if(q == 0) return lo;
+  const float step = (hi - lo) / static_cast<float>(std::numeric_limits<Q>::max());
+  return lo + static_cast<float>(q) * step;
+}
+
+//==============================================================================
+/// @brief Upper bound of a quantized interval inside [lo, hi]. q == max
+/// decodes exactly to hi.
+template <typename Q>
+float decodeQuantizedUpper(float lo, float hi, Q q)
+{
+  const Q q_max = std::numeric_limits<Q>::max();
+  if(q == q_max) return hi;
+  const float step = (hi - lo) / static_cast<float>(q_max);
+  return hi - static_cast<float>(q_max - q) * step;
+}
+
+//==============================================================================
+/// @brief Largest q such that the decoded lower bound does not exceed value
+template <typename Q, typename S>
+Q encodeQuantizedLower(float lo, float hi, S value)
+{
+  const int q_max = std::numeric_limits<Q>::max();
+  if(!(hi > lo)) return 0;
+
+  const S step = (static_cast<S>(hi) - static_cast<S>(lo)) / q_max;
+  int q = static_cast<int>(std::floor((value - static_cast<S>(lo)) / step));
+  q = std::max(0, std::min(q, q_max));
+
+  // the decoding is done in float, so check the result against it
+  while(q > 0 && static_cast<S>(decodeQuantizedLower<Q>(lo, hi, static_cast<Q>(q))) > value)
+    --q;
+  while(q < q_max && static_cast<S>(decodeQuantizedLower<Q>(lo, hi, static_cast<Q>(q + 1))) <= value)
+    ++q;
+
+  return static_cast<Q>(q);
+}
+
+//==============================================================================
+/// @brief Smallest q such that the decoded upper bound is not below value
+template <typename Q, typename S>
+Q encodeQuantizedUpper(float lo, float hi, S value)
+{
+  const int q_max = std::numeric_limits<Q>::max();
+  if(!(hi > lo)) return static_cast<Q>(q_max);
+
+  const S step = (static_cast<S>(hi) - static_cast<S>(lo)) / q_max;
+  int q = q_max - static_cast<int>(std::floor((static_cast<S>(hi) - value) / step));
+  q = std::max(0, std::min(q, q_max));
+
+  while(q < q_max && static_cast<S>(decodeQuantizedUpper<Q>(lo, hi, static_cast<Q>(q))) < value)
+    ++q;
+  while(q > 0 && static_cast<S>(decodeQuantizedUpper<Q>(lo, hi, static_cast<Q>(q - 1))) >= value)
+    --q;
+
+  return static_cast<Q>(q);
+}
+
+//==============================================================================
+/// @brief Round a value to float, toward -infinity (down = true) or +infinity
+template <typename S>
+float roundToFloat(S value, bool down)
+{
+  float r = static_cast<float>(value);
+  if(down && static_cast<S>(r) > value)
+    r = std::nextafter(r, -std::numeric_limits<float>::infinity());
+  else if(!down && static_cast<S>(r) < value)
+    r = std::nextafter(r, std::numeric_limits<float>::infinity());
+  return r;
+}
+
+} // namespace detail
+
+//==============================================================================
+template <typename Q>
+bool BVNodeCompressed<Q>::isLeaf() const
+{
+  return first_child < 0;
+}
+
+//==============================================================================
+template <typename Q>
+int BVNodeCompressed<Q>::primitiveId() const
+{
+  return -(first_child + 1);
+}
+
+//==============================================================================
+template <typename Q>
+int BVNodeCompressed<Q>::leftChild() const
+{
+  return first_child;
+}
+
+//==============================================================================
+template <typename Q>
+int BVNodeCompressed<Q>::rightChild() const
+{
+  return first_child + 1;
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+BVHCompressed<BV, Q>::BVHCompressed(const BVHModel<BV>& model)
+  : BVHTriangleCopy<BV>(model, "BVHCompressed")
+{
+  axis.setIdentity();
+  if(!this->isValid())
+    return;
+
+  axis = model.getBV(0).getOrientation();
+
+  // Tight boxes of the triangles in the shared frame
+  std::vector<AABB<S>> boxes;
+  BVHNodeBoxes(model, axis, boxes);
+
+  const int num_bvs = model.getNumBVs();
+  bvs.resize(num_bvs);
+  for(int i = 0; i < num_bvs; ++i)
+    bvs[i].first_child = model.getBV(i).first_child;
+
+  for(int j = 0; j < 3; ++j)
+  {
+    root_box.min_[j] = detail::roundToFloat(boxes[0].min_[j], true);
+    root_box.max_[j] = detail::roundToFloat(boxes[0].max_[j], false);
+    bvs[0].lower[j] = 0;
+    bvs[0].upper[j] = std::numeric_limits<Q>::max();
+  }
+
+  recursiveCompress(boxes, 0, root_box);
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+void BVHCompressed<BV, Q>::recursiveCompress(
+    const std::vector<AABB<S>>& boxes,
+    int bv_id,
+    const AABB<float>& decoded)
+{
+  const BVNodeCompressed<Q>& node = bvs[bv_id];
+  if(node.isLeaf())
+    return;
+
+  for(int c = node.leftChild(); c <= node.rightChild(); ++c)
+  {
+    for(int j = 0; j < 3; ++j)
+    {
+      bvs[c].lower[j] = detail::encodeQuantizedLower<Q>(
+            decoded.min_[j], decoded.max_[j], boxes[c].min_[j]);
+      bvs[c].upper[j] = detail::encodeQuantizedUpper<Q>(
+            decoded.min_[j], decoded.max_[j], boxes[c].max_[j]);
+    }
+
+    AABB<float> child;
+    decodeBox(c, decoded, child);
+    recursiveCompress(boxes, c, child);
+  }
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+const BVNodeCompressed<Q>& BVHCompressed<BV, Q>::getBV(int id) const
+{
+  return bvs[id];
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+int BVHCompressed<BV, Q>::getNumBVs() const
+{
+  return static_cast<int>(bvs.size());
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+const Matrix3<typename BV::S>& BVHCompressed<BV, Q>::getAxis() const
+{
+  return axis;
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+const AABB<float>& BVHCompressed<BV, Q>::getRootBox() const
+{
+  return root_box;
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+void BVHCompressed<BV, Q>::decodeBox(
+    int id, const AABB<float>& parent, AABB<float>& box) const
+{
+  const BVNodeCompressed<Q>& node = bvs[id];
+  for(int j = 0; j < 3; ++j)
+  {
+    box.min_[j] = detail::decodeQuantizedLower<Q>(
+          parent.min_[j], parent.max_[j], node.lower[j]);
+    box.max_[j] = detail::decodeQuantizedUpper<Q>(
+          parent.min_[j], parent.max_[j], node.upper[j]);
+  }
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+std::size_t BVHCompressed<BV, Q>::hierarchyMemUsage() const
+{
+  return sizeof(BVNodeCompressed<Q>) * bvs.size() + sizeof(root_box)
+      + sizeof(axis);
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+int BVHCompressed<BV, Q>::memUsage(int msg) const
+{
+  return this->printMemUsage("compressed", getNumBVs(), hierarchyMemUsage(),
+                             sizeof(BVHCompressed<BV, Q>), msg);
+}
+
+} // namespace fcl
+
+#endif
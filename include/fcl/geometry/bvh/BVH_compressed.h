@@ -0,0 +1,156 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BVH_COMPRESSED_H
+#define FCL_BVH_COMPRESSED_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "fcl/math/bv/AABB.h"
+#include "fcl/geometry/bvh/BVH_triangle_copy.h"
+
+namespace fcl
+{
+
+/// @brief A compressed node of BVHCompressed. The box is stored as integer
+/// offsets inside the decoded box of the parent node. The tree structure is
+/// the same as BVNodeBase, but the primitive range is dropped.
+template <typename Q>
+struct FCL_EXPORT BVNodeCompressed
+{
+  /// @brief Same encoding as BVNodeBase::first_child: non-negative values are
+  /// the index of the first child, negative values are -(primitive index + 1)
+  std::int32_t first_child;
+
+  /// @brief Quantized lower corner, relative to the parent box
+  Q lower[3];
+
+  /// @brief Quantized upper corner, relative to the parent box
+  Q upper[3];
+
+  /// @brief Whether current node is a leaf node
+  bool isLeaf() const;
+
+  /// @brief Return the primitive index of a leaf node
+  int primitiveId() const;
+
+  /// @brief Return the index of the first child
+  int leftChild() const;
+
+  /// @brief Return the index of the second child
+  int rightChild() const;
+};
+
+/// @brief A read-only, memory compact copy of the hierarchy of a triangle
+/// BVHModel.
+///
+/// All the nodes share one frame (the orientation of the root BV of the
+/// source model), and every node only stores its axis-aligned box in that
+/// frame, quantized to Q (std::uint16_t or std::uint8_t) relative to the box of
+/// its parent. The root box is kept in float, even for double models. Boxes
+/// are always rounded outward, both when they are encoded and when they are
+/// decoded during traversal, so every decoded box contains the triangles
+/// below it and the collision answers remain conservative. Leaf tests use the
+/// triangles in the precision of the source model.
+///
+/// Traversal is done by detail::MeshCompressedCollisionTraversalNode.
+template <typename BV, typename Q = std::uint16_t>
+class FCL_EXPORT BVHCompressed : public BVHTriangleCopy<BV>
+{
+public:
+
+  using S = typename BV::S;
+
+  static_assert(std::numeric_limits<Q>::is_integer
+                && !std::numeric_limits<Q>::is_signed,
+                "BVHCompressed requires an unsigned integer storage type");
+
+  /// @brief Compress the hierarchy of a BVHModel which is built from
+  /// triangles. The vertices and triangles are copied, so the source model can
+  /// be released afterwards.
+  explicit BVHCompressed(const BVHModel<BV>& model);
+
+  /// @brief Access the compressed node giving its index
+  const BVNodeCompressed<Q>& getBV(int id) const;
+
+  /// @brief Get the number of nodes in the hierarchy
+  int getNumBVs() const;
+
+  /// @brief The frame shared by all the boxes, expressed in the model frame
+  const Matrix3<S>& getAxis() const;
+
+  /// @brief The decoded box of the root node, in the shared frame
+  const AABB<float>& getRootBox() const;
+
+  /// @brief Decode the box of node id given the decoded box of its parent
+  void decodeBox(int id, const AABB<float>& parent, AABB<float>& box) const;
+
+  /// @brief Number of bytes used by the hierarchy (excluding the triangles)
+  std::size_t hierarchyMemUsage() const;
+
+  /// @brief Check the number of memory used
+  int memUsage(int msg) const;
+
+  using BVHTriangleCopy<BV>::vertices;
+  using BVHTriangleCopy<BV>::tri_indices;
+
+private:
+
+  /// @brief Recursive kernel for the quantization of the hierarchy
+  void recursiveCompress(
+      const std::vector<AABB<S>>& boxes,
+      int bv_id,
+      const AABB<float>& decoded);
+
+  Matrix3<S> axis;
+
+  AABB<float> root_box;
+
+  std::vector<BVNodeCompressed<Q>> bvs;
+};
+
+template <typename BV>
+using BVHCompressed16 = BVHCompressed<BV, std::uint16_t>;
+
+template <typename BV>
+using BVHCompressed8 = BVHCompressed<BV, std::uint8_t>;
+
+} // namespace fcl
+
+#include "fcl/geometry/bvh/BVH_compressed-inl.h"
+
+#endif
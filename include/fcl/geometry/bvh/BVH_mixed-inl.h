@@ -0,0 +1,116 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BVH_MIXED_INL_H
+#define FCL_BVH_MIXED_INL_H
+
+#include "fcl/geometry/bvh/BVH_mixed.h"
+
+#include <limits>
+
+namespace fcl
+{
+
+//==============================================================================
+template <typename BV>
+BVHMixed<BV>::BVHMixed(const BVHModel<BV>& model)
+  : BVHTriangleCopy<BV>(model, "BVHMixed"), padding(0)
+{
+  if(!this->isValid())
+    return;
+
+  // The rounding of the conversion and of the float BV tests is relative to
+  // the magnitude of the coordinates, which is bounded by the vertices. The
+  // factor leaves room for the corners of the BVs and for the accumulation
+  // of errors inside the overlap and distance tests.
+  S scale = 0;
+  for(const auto& v : vertices)
+    scale = std::max(scale, v.template lpNorm<Eigen::Infinity>());
+
+  padding = static_cast<float>(
+        64 * std::numeric_limits<float>::epsilon() * scale)
+      + std::numeric_limits<float>::min();
+
+  const int num_bvs = model.getNumBVs();
+  bvs.resize(num_bvs);
+  for(int i = 0; i < num_bvs; ++i)
+  {
+    const BVNode<BV>& node = model.getBV(i);
+    castBV(node.bv, padding, bvs[i].bv);
+    bvs[i].first_child = node.first_child;
+    bvs[i].first_primitive = node.first_primitive;
+    bvs[i].num_primitives = node.num_primitives;
+  }
+}
+
+//==============================================================================
+template <typename BV>
+const BVNode<typename BVHMixed<BV>::BVf>& BVHMixed<BV>::getBV(int id) const
+{
+  return bvs[id];
+}
+
+//==============================================================================
+template <typename BV>
+int BVHMixed<BV>::getNumBVs() const
+{
+  return static_cast<int>(bvs.size());
+}
+
+//==============================================================================
+template <typename BV>
+float BVHMixed<BV>::getPadding() const
+{
+  return padding;
+}
+
+//==============================================================================
+template <typename BV>
+std::size_t BVHMixed<BV>::hierarchyMemUsage() const
+{
+  return sizeof(BVNode<BVf>) * bvs.size();
+}
+
+//==============================================================================
+template <typename BV>
+int BVHMixed<BV>::memUsage(int msg) const
+{
+  return this->printMemUsage("mixed precision", getNumBVs(), hierarchyMemUsage(),
+                             sizeof(BVHMixed<BV>), msg);
+}
+
+} // namespace fcl
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BVH_MIXED_H
+#define FCL_BVH_MIXED_H
+
+#include <vector>
+
+#include "fcl/math/bv/utility.h"
+#include "fcl/geometry/bvh/BVH_triangle_copy.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief The bounding volume type BV with float scalar
+template <typename BV>
+struct FloatBV;
+
+template <template <typename> class BVT, typename S>
+struct FloatBV<BVT<S>>
+{
+  using type = BVT<float>;
+};
+
+} // namespace detail
+
+/// @brief A mixed precision copy of a triangle BVHModel: the hierarchy is
+/// stored and tested in float while the vertices, the leaf tests and the
+/// contacts stay in the precision of BV (usually double).
+///
+/// Every float BV is enlarged by getPadding(), which bounds the rounding of
+/// the conversion and of the float BV tests, so the culling remains
+/// conservative and the results match the ones of the source model. Supported
+/// BV types are OBB, RSS, OBBRSS and kIOS.
+///
+/// Traversal is done by detail::MeshMixedCollisionTraversalNode and
+/// detail::MeshMixedDistanceTraversalNode.
+template <typename BV>
+class FCL_EXPORT BVHMixed : public BVHTriangleCopy<BV>
+{
+public:
+
+  using S = typename BV::S;
+
+  /// @brief The bounding volume type of the hierarchy
+  using BVf = typename detail::FloatBV<BV>::type;
+
+  /// @brief Copy the geometry of a triangle BVHModel and convert its
+  /// hierarchy to float
+  explicit BVHMixed(const BVHModel<BV>& model);
+
+  /// @brief Access the float BV node giving its index
+  const BVNode<BVf>& getBV(int id) const;
+
+  /// @brief Get the number of nodes in the hierarchy
+  int getNumBVs() const;
+
+  /// @brief The amount by which every float BV is enlarged
+  float getPadding() const;
+
+  /// @brief Number of bytes used by the hierarchy (excluding the triangles)
+  std::size_t hierarchyMemUsage() const;
+
+  /// @brief Check the number of memory used
+  int memUsage(int msg) const;
+
+  using BVHTriangleCopy<BV>::vertices;
+  using BVHTriangleCopy<BV>::tri_indices;
+
+private:
+
+  float padding;
+
+  std::vector<BVNode<BVf>> bvs;
+};
+
+} // namespace fcl
+
+#include "fcl/geometry/bvh/BVH_mixed-inl.h"
+
+#endif
@@ -39,8 +39,13 @@
 #define FCL_BVH_MODEL_INL_H
 
 #include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/math/bv/utility.h"
 #include <new>
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <typeinfo>
 
 namespace fcl
 {
@@ -73,7 +78,11 @@ BVHModel<BV>::BVHModel() : vertices(nullptr),
   num_vertex_updated(0),
   primitive_indices(nullptr),
   bvs(nullptr),
-  num_bvs(0)
+  num_bvs(0),
+  bv_cost(0),
+  bv_build_cost(0),
+  rebuild_threshold(0),
+  rebuild_asynchronous(false)
 {
   // Do nothing
 }
@@ -88,7 +97,11 @@ BVHModel<BV>::BVHModel(const BVHModel<BV>& other)
     bv_splitter(other.bv_splitter),
     bv_fitter(other.bv_fitter),
     num_tris_allocated(other.num_tris),
-    num_vertices_allocated(other.num_vertices)
+    num_vertices_allocated(other.num_vertices),
+    bv_cost(other.bv_cost),
+    bv_build_cost(other.bv_build_cost),
+    rebuild_threshold(other.rebuild_threshold),
+    rebuild_asynchronous(other.rebuild_asynchronous)
 {
   if(other.vertices)
   {
@@ -155,6 +168,8 @@ BVHModel<BV>::~BVHModel()
 
   delete [] prev_vertices;
   delete [] primitive_indices;
+
+  dropRebuild();
 }
 
 //==============================================================================
@@ -700,7 +715,7 @@ int BVHModel<BV>::updateSubModel(const std::vector<Vector3<S>>& ps)
 
 //==============================================================================
 template <typename BV>
-int BVHModel<BV>::endUpdateModel(bool refit, bool bottomup)
+int BVHModel<BV>::endUpdateModel(bool refit, bool bottomup, int num_threads)
 {
   if(build_state != BVH_BUILD_STATE_UPDATE_BEGUN)
   {
@@ -716,7 +731,7 @@ int BVHModel<BV>::endUpdateModel(bool refit, bool bottomup)
 
   if(refit)  // refit, do not change BVH structure
   {
-    refitTree(bottomup);
+    refitTree(bottomup, num_threads);
   }
   else // reconstruct bvh tree based on current frame data
   {
@@ -724,15 +739,198 @@ int BVHModel<BV>::endUpdateModel(bool refit, bool bottomup)
 
     // then refit
 
-    refitTree(bottomup);
+    refitTree(bottomup, num_threads);
   }
 
+  maintainHierarchy();
 
   build_state = BVH_BUILD_STATE_UPDATED;
 
   return BVH_OK;
 }
 
+//==============================================================================
+template <typename BV>
+int BVHModel<BV>::updateVertices(const std::vector<int>& indices, const std::vector<Vector3<S>>& ps)
+{
+  if(build_state != BVH_BUILD_STATE_PROCESSED && build_state != BVH_BUILD_STATE_UPDATED)
+  {
+    std::cerr << "BVH Error! Call updateVertices() on a BVHModel that is not built.\n";
+    return BVH_ERR_BUILD_OUT_OF_SEQUENCE;
+  }
+
+  if(indices.size() != ps.size())
+  {
+    std::cerr << "BVH Error! updateVertices() requires one point per vertex index.\n";
+    return BVH_ERR_INCORRECT_DATA;
+  }
+
+  for(const int index : indices)
+  {
+    if(index < 0 || index >= num_vertices)
+    {
+      std::cerr << "BVH Error! updateVertices() was given an invalid vertex index.\n";
+      return BVH_ERR_INCORRECT_DATA;
+    }
+  }
+
+  std::vector<int> sorted_indices(indices);
+  std::sort(sorted_indices.begin(), sorted_indices.end());
+  if(std::adjacent_find(sorted_indices.begin(), sorted_indices.end()) != sorted_indices.end())
+  {
+    std::cerr << "BVH Error! updateVertices() was given the same vertex index twice.\n";
+    return BVH_ERR_INCORRECT_DATA;
+  }
+
+  BVHModelType type = getModelType();
+  if(type != BVH_MODEL_TRIANGLES && type != BVH_MODEL_POINTCLOUD)
+  {
+    std::cerr << "BVH Error: Model type not supported!\n";
+    return BVH_ERR_UNSUPPORTED_FUNCTION;
+  }
+
+  if(bv_parents.empty())
+    buildUpdateMaps();
+
+  // collect the leaves of the primitives using the moved vertices
+  std::vector<int> dirty_nodes;
+  for(const int index : indices)
+  {
+    if(type == BVH_MODEL_POINTCLOUD)
+    {
+      const int leaf = primitive_leaves[index];
+      if(!bv_dirty[leaf])
+      {
+        bv_dirty[leaf] = true;
+        dirty_nodes.push_back(leaf);
+      }
+    }
+    else
+    {
+      for(int j = vertex_triangle_offsets[index]; j < vertex_triangle_offsets[index + 1]; ++j)
+      {
+        const int leaf = primitive_leaves[vertex_triangles[j]];
+        if(!bv_dirty[leaf])
+        {
+          bv_dirty[leaf] = true;
+          dirty_nodes.push_back(leaf);
+        }
+      }
+    }
+  }
+
+  // This call is one motion step of the dirty primitives: all their vertices,
+  // moved or not, start it from their current position.
+  if(prev_vertices)
+  {
+    for(const int leaf : dirty_nodes)
+    {
+      const int primitive_id = bvs[leaf].primitiveId();
+      if(type == BVH_MODEL_POINTCLOUD)
+      {
+        prev_vertices[primitive_id] = vertices[primitive_id];
+      }
+      else
+      {
+        const Triangle& t = tri_indices[primitive_id];
+        for(int k = 0; k < 3; ++k)
+          prev_vertices[t[k]] = vertices[t[k]];
+      }
+    }
+  }
+
+  for(std::size_t i = 0; i < indices.size(); ++i)
+    vertices[indices[i]] = ps[i];
+
+  // the leaves must be refit after all the vertices are moved, since the
+  // same leaf can be reached through several vertices
+  const std::size_t num_dirty_leaves = dirty_nodes.size();
+  for(std::size_t i = 0; i < num_dirty_leaves; ++i)
+  {
+    bv_cost -= bvs[dirty_nodes[i]].bv.size();
+    refitLeaf(dirty_nodes[i]);
+    bv_cost += bvs[dirty_nodes[i]].bv.size();
+  }
+
+  for(std::size_t i = 0; i < num_dirty_leaves; ++i)
+  {
+    int parent = bv_parents[dirty_nodes[i]];
+    while(parent >= 0 && !bv_dirty[parent])
+    {
+      bv_dirty[parent] = true;
+      dirty_nodes.push_back(parent);
+      parent = bv_parents[parent];
+    }
+  }
+
+  // the children of a node always follow it in bvs, so merging in the
+  // order of decreasing indices is bottom-up
+  std::sort(dirty_nodes.begin() + num_dirty_leaves, dirty_nodes.end(), std::greater<int>());
+  for(std::size_t i = num_dirty_leaves; i < dirty_nodes.size(); ++i)
+  {
+    BVNode<BV>* bvnode = bvs + dirty_nodes[i];
+    bv_cost -= bvnode->bv.size();
+    bvnode->bv = bvs[bvnode->leftChild()].bv + bvs[bvnode->rightChild()].bv;
+    bv_cost += bvnode->bv.size();
+  }
+
+  for(const int id : dirty_nodes)
+    bv_dirty[id] = false;
+
+  maintainHierarchy();
+
+  build_state = BVH_BUILD_STATE_UPDATED;
+
+  return BVH_OK;
+}
+
+//==============================================================================
+template <typename BV>
+typename BV::S BVHModel<BV>::getHierarchyCost() const
+{
+  return bv_cost;
+}
+
+//==============================================================================
+template <typename BV>
+typename BV::S BVHModel<BV>::getQualityRatio() const
+{
+  if(bv_build_cost > 0)
+    return bv_cost / bv_build_cost;
+  return 1;
+}
+
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::setRebuildPolicy(S threshold, bool asynchronous)
+{
+  rebuild_threshold = threshold;
+  rebuild_asynchronous = asynchronous;
+}
+
+//==============================================================================
+template <typename BV>
+bool BVHModel<BV>::isRebuildPending() const
+{
+  return pending_rebuild.valid();
+}
+
+//==============================================================================
+template <typename BV>
+int BVHModel<BV>::finishRebuild()
+{
+  if(!pending_rebuild.valid())
+    return BVH_OK;
+
+  if(build_state != BVH_BUILD_STATE_PROCESSED && build_state != BVH_BUILD_STATE_UPDATED)
+  {
+    std::cerr << "BVH Error! Call finishRebuild() in the middle of a model update.\n";
+    return BVH_ERR_BUILD_OUT_OF_SEQUENCE;
+  }
+
+  return installRebuild();
+}
+
 //==============================================================================
 template <typename BV>
 int BVHModel<BV>::memUsage(int msg) const
@@ -853,10 +1051,27 @@ int BVHModel<BV>::buildTree()
     return BVH_ERR_UNSUPPORTED_FUNCTION;
   }
 
+  // a hierarchy built in the background for the previous geometry is
+  // dropped: the background build is told to stop, and releasing the future
+  // does not wait for it
+  dropRebuild();
+
   for(int i = 0; i < num_primitives; ++i)
     primitive_indices[i] = i;
   recursiveBuildTree(0, 0, num_primitives);
 
+  // the hierarchy of a cancelled background build is incomplete
+  if(build_cancel && build_cancel->load())
+  {
+    num_bvs = 0;
+    bv_fitter->clear();
+    bv_splitter->clear();
+    return BVH_ERR_UNUPDATED_MODEL;
+  }
+
+  clearUpdateMaps();
+  computeBuildCost();
+
   bv_fitter->clear();
   bv_splitter->clear();
 
@@ -867,6 +1082,9 @@ int BVHModel<BV>::buildTree()
 template <typename BV>
 int BVHModel<BV>::recursiveBuildTree(int bv_id, int first_primitive, int num_primitives)
 {
+  if(build_cancel && build_cancel->load(std::memory_order_relaxed))
+    return BVH_OK;
+
   BVHModelType type = getModelType();
   BVNode<BV>* bvnode = bvs + bv_id;
   unsigned int* cur_primitive_indices = primitive_indices + first_primitive;
@@ -939,12 +1157,19 @@ int BVHModel<BV>::recursiveBuildTree(int bv_id, int first_primitive, int num_pri
 
 //==============================================================================
 template <typename BV>
-int BVHModel<BV>::refitTree(bool bottomup)
+int BVHModel<BV>::refitTree(bool bottomup, int num_threads)
 {
+  int res;
   if(bottomup)
-    return refitTree_bottomup();
+    res = (num_threads > 1) ? refitTree_bottomup(num_threads) : refitTree_bottomup();
   else
-    return refitTree_topdown();
+    res = refitTree_topdown();
+
+  bv_cost = 0;
+  for(int i = 0; i < num_bvs; ++i)
+    bv_cost += bvs[i].bv.size();
+
+  return res;
 }
 
 //==============================================================================
@@ -956,6 +1181,71 @@ int BVHModel<BV>::refitTree_bottomup()
   return res;
 }
 
+//==============================================================================
+template <typename BV>
+int BVHModel<BV>::refitTree_bottomup(int num_threads)
+{
+  BVHModelType type = getModelType();
+  if(type != BVH_MODEL_TRIANGLES && type != BVH_MODEL_POINTCLOUD)
+  {
+    std::cerr << "BVH Error: Model type not supported!\n";
+    return BVH_ERR_UNSUPPORTED_FUNCTION;
+  }
+
+  // Split the tree level by level until there are a few subtrees per thread;
+  // the nodes above them are merged once the subtrees are done.
+  std::vector<int> subtrees(1, 0);
+  std::vector<int> top_nodes;
+  const std::size_t target = 4 * static_cast<std::size_t>(num_threads);
+  while(subtrees.size() < target)
+  {
+    std::vector<int> next;
+    bool split = false;
+    for(const int id : subtrees)
+    {
+      if(bvs[id].isLeaf())
+      {
+        next.push_back(id);
+      }
+      else
+      {
+        top_nodes.push_back(id);
+        next.push_back(bvs[id].leftChild());
+        next.push_back(bvs[id].rightChild());
+        split = true;
+      }
+    }
+
+    subtrees.swap(next);
+    if(!split) break;
+  }
+
+  std::vector<std::thread> threads;
+  for(int t = 1; t < num_threads; ++t)
+  {
+    threads.emplace_back([this, &subtrees, t, num_threads]()
+    {
+      for(std::size_t i = t; i < subtrees.size(); i += num_threads)
+        recursiveRefitTree_bottomup(subtrees[i]);
+    });
+  }
+
+  for(std::size_t i = 0; i < subtrees.size(); i += num_threads)
+    recursiveRefitTree_bottomup(subtrees[i]);
+
+  for(auto& thread : threads)
+    thread.join();
+
+  // top_nodes is in breadth-first order, so reverse order is bottom-up
+  for(auto it = top_nodes.rbegin(); it != top_nodes.rend(); ++it)
+  {
+    BVNode<BV>* bvnode = bvs + *it;
+    bvnode->bv = bvs[bvnode->leftChild()].bv + bvs[bvnode->rightChild()].bv;
+  }
+
+  return BVH_OK;
+}
+
 //==============================================================================
 template <typename BV>
 int BVHModel<BV>::recursiveRefitTree_bottomup(int bv_id)
@@ -963,66 +1253,264 @@ int BVHModel<BV>::recursiveRefitTree_bottomup(int bv_id)
   BVNode<BV>* bvnode = bvs + bv_id;
   if(bvnode->isLeaf())
   {
-    BVHModelType type = getModelType();
-    int primitive_id = -(bvnode->first_child + 1);
-    if(type == BVH_MODEL_POINTCLOUD)
+    return refitLeaf(bv_id);
+  }
+  else
+  {
+    recursiveRefitTree_bottomup(bvnode->leftChild());
+    recursiveRefitTree_bottomup(bvnode->rightChild());
+    bvnode->bv = bvs[bvnode->leftChild()].bv + bvs[bvnode->rightChild()].bv;
+  }
+
+  return BVH_OK;
+}
+
+//==============================================================================
+template <typename BV>
+int BVHModel<BV>::refitLeaf(int bv_id)
+{
+  BVHModelType type = getModelType();
+  if(type != BVH_MODEL_POINTCLOUD && type != BVH_MODEL_TRIANGLES)
+  {
+    std::cerr << "BVH Error: Model type not supported!\n";
+    return BVH_ERR_UNSUPPORTED_FUNCTION;
+  }
+
+  BVNode<BV>* bvnode = bvs + bv_id;
+  bvnode->bv = fitPrimitive(-(bvnode->first_child + 1));
+
+  return BVH_OK;
+}
+
+//==============================================================================
+template <typename BV>
+BV BVHModel<BV>::fitPrimitive(int primitive_id) const
+{
+  BV bv;
+  if(getModelType() == BVH_MODEL_POINTCLOUD)
+  {
+    if(prev_vertices)
     {
-      BV bv;
+      Vector3<S> v[2];
+      v[0] = prev_vertices[primitive_id];
+      v[1] = vertices[primitive_id];
+      fit(v, 2, bv);
+    }
+    else
+      fit(vertices + primitive_id, 1, bv);
+  }
+  else
+  {
+    const Triangle& triangle = tri_indices[primitive_id];
 
-      if(prev_vertices)
+    if(prev_vertices)
+    {
+      Vector3<S> v[6];
+      for(int i = 0; i < 3; ++i)
       {
-        Vector3<S> v[2];
-        v[0] = prev_vertices[primitive_id];
-        v[1] = vertices[primitive_id];
-        fit(v, 2, bv);
+        v[i] = prev_vertices[triangle[i]];
+        v[i + 3] = vertices[triangle[i]];
       }
-      else
-        fit(vertices + primitive_id, 1, bv);
 
-      bvnode->bv = bv;
+      fit(v, 6, bv);
     }
-    else if(type == BVH_MODEL_TRIANGLES)
+    else
     {
-      BV bv;
-      const Triangle& triangle = tri_indices[primitive_id];
-
-      if(prev_vertices)
+      Vector3<S> v[3];
+      for(int i = 0; i < 3; ++i)
       {
-        Vector3<S> v[6];
-        for(int i = 0; i < 3; ++i)
-        {
-          v[i] = prev_vertices[triangle[i]];
-          v[i + 3] = vertices[triangle[i]];
-        }
-
-        fit(v, 6, bv);
+        v[i] = vertices[triangle[i]];
       }
-      else
-      {
-        Vector3<S> v[3];
-        for(int i = 0; i < 3; ++i)
-        {
-          v[i] = vertices[triangle[i]];
-        }
 
-        fit(v, 3, bv);
-      }
+      fit(v, 3, bv);
+    }
+  }
+
+  return bv;
+}
 
-      bvnode->bv = bv;
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::buildUpdateMaps()
+{
+  bv_parents.assign(num_bvs, -1);
+  bv_dirty.assign(num_bvs, false);
+
+  const bool is_mesh = (getModelType() == BVH_MODEL_TRIANGLES);
+  primitive_leaves.assign(is_mesh ? num_tris : num_vertices, -1);
+
+  for(int i = 0; i < num_bvs; ++i)
+  {
+    const BVNode<BV>& bvnode = bvs[i];
+    if(bvnode.isLeaf())
+    {
+      primitive_leaves[bvnode.primitiveId()] = i;
     }
     else
     {
-      std::cerr << "BVH Error: Model type not supported!\n";
-      return BVH_ERR_UNSUPPORTED_FUNCTION;
+      bv_parents[bvnode.leftChild()] = i;
+      bv_parents[bvnode.rightChild()] = i;
     }
   }
-  else
+
+  vertex_triangle_offsets.clear();
+  vertex_triangles.clear();
+  if(!is_mesh)
+    return;
+
+  vertex_triangle_offsets.assign(num_vertices + 1, 0);
+  for(int i = 0; i < num_tris; ++i)
   {
-    recursiveRefitTree_bottomup(bvnode->leftChild());
-    recursiveRefitTree_bottomup(bvnode->rightChild());
-    bvnode->bv = bvs[bvnode->leftChild()].bv + bvs[bvnode->rightChild()].bv;
+    for(int j = 0; j < 3; ++j)
+      vertex_triangle_offsets[tri_indices[i][j] + 1]++;
+  }
+
+  for(int i = 0; i < num_vertices; ++i)
+    vertex_triangle_offsets[i + 1] += vertex_triangle_offsets[i];
+
+  vertex_triangles.resize(vertex_triangle_offsets[num_vertices]);
+  std::vector<int> cursor(vertex_triangle_offsets.begin(), vertex_triangle_offsets.end() - 1);
+  for(int i = 0; i < num_tris; ++i)
+  {
+    for(int j = 0; j < 3; ++j)
+      vertex_triangles[cursor[tri_indices[i][j]]++] = i;
+  }
+}
+
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::clearUpdateMaps()
+{
+  bv_parents.clear();
+  primitive_leaves.clear();
+  vertex_triangle_offsets.clear();
+  vertex_triangles.clear();
+  bv_dirty.clear();
+}
+
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::computeBuildCost()
+{
+  // The refits fit the leaves on their own and merge the children BVs,
+  // which is looser than the fit of the build, so the reference is what a
+  // refit would give for the geometry of the build.
+  std::vector<BV> merged(num_bvs);
+  bv_cost = 0;
+  bv_build_cost = 0;
+  for(int i = num_bvs - 1; i >= 0; --i)
+  {
+    const BVNode<BV>& bvnode = bvs[i];
+    if(bvnode.isLeaf())
+      merged[i] = fitPrimitive(bvnode.primitiveId());
+    else
+      merged[i] = merged[bvnode.leftChild()] + merged[bvnode.rightChild()];
+
+    bv_cost += bvnode.bv.size();
+    bv_build_cost += merged[i].size();
   }
+}
 
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::maintainHierarchy()
+{
+  if(pending_rebuild.valid())
+  {
+    if(pending_rebuild.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+      installRebuild();
+    return;
+  }
+
+  if(rebuild_threshold <= 0 || getQualityRatio() <= rebuild_threshold)
+    return;
+
+  // The background build uses BVFitter and BVSplitter with the split method
+  // of this model. A model with other fitters or splitters is rebuilt in
+  // place, so that the hierarchy never depends on the rebuild mode.
+  const bool default_builders
+      = bv_fitter && typeid(*bv_fitter) == typeid(detail::BVFitter<BV>)
+      && bv_splitter && typeid(*bv_splitter) == typeid(detail::BVSplitter<BV>);
+
+  if(!rebuild_asynchronous || !default_builders)
+  {
+    buildTree();
+
+    // the BVs of an update also cover the previous positions
+    if(prev_vertices)
+      refitTree(true);
+    return;
+  }
+
+  std::vector<Vector3<S>> ps(vertices, vertices + num_vertices);
+  std::vector<Triangle> ts;
+  if(getModelType() == BVH_MODEL_TRIANGLES)
+    ts.assign(tri_indices, tri_indices + num_tris);
+
+  const detail::SplitMethodType method
+      = static_cast<detail::BVSplitter<BV>*>(bv_splitter.get())->getSplitMethod();
+
+  auto cancel = std::make_shared<std::atomic<bool>>(false);
+  rebuild_cancel = cancel;
+
+  // The background thread only works on its own copy of the geometry. It is
+  // detached and hands its result over through a packaged_task, whose future,
+  // unlike the one of std::async, can be released without waiting.
+  std::packaged_task<std::shared_ptr<BVHModel<BV>>()> task(
+        [ps = std::move(ps), ts = std::move(ts), method, cancel]()
+  {
+    std::shared_ptr<BVHModel<BV>> rebuilt(new BVHModel<BV>());
+    rebuilt->bv_splitter.reset(new detail::BVSplitter<BV>(method));
+    rebuilt->build_cancel = cancel;
+    rebuilt->beginModel(static_cast<int>(ts.size()), static_cast<int>(ps.size()));
+    if(ts.empty())
+      rebuilt->addSubModel(ps);
+    else
+      rebuilt->addSubModel(ps, ts);
+    if(rebuilt->endModel() != BVH_OK || cancel->load())
+      return std::shared_ptr<BVHModel<BV>>();
+    return rebuilt;
+  });
+  pending_rebuild = task.get_future();
+  std::thread(std::move(task)).detach();
+}
+
+//==============================================================================
+template <typename BV>
+void BVHModel<BV>::dropRebuild()
+{
+  if(rebuild_cancel)
+    rebuild_cancel->store(true);
+  rebuild_cancel.reset();
+  pending_rebuild = std::future<std::shared_ptr<BVHModel<BV>>>();
+}
+
+//==============================================================================
+template <typename BV>
+int BVHModel<BV>::installRebuild()
+{
+  std::shared_ptr<BVHModel<BV>> rebuilt = pending_rebuild.get();
+  rebuild_cancel.reset();
+  if(!rebuilt || rebuilt->num_bvs == 0
+     || rebuilt->num_vertices != num_vertices || rebuilt->num_tris != num_tris)
+    return BVH_ERR_UNUPDATED_MODEL;
+
+  // the primitives and the number of nodes are the same, only the structure
+  // of the tree changes
+  std::swap(bvs, rebuilt->bvs);
+  std::swap(num_bvs, rebuilt->num_bvs);
+  std::swap(num_bvs_allocated, rebuilt->num_bvs_allocated);
+  std::swap(primitive_indices, rebuilt->primitive_indices);
+  bv_build_cost = rebuilt->bv_build_cost;
+
+  clearUpdateMaps();
+
+  // the vertices may have moved since the snapshot, and the BVs of an
+  // update also cover the previous positions
+  if(prev_vertices || !std::equal(vertices, vertices + num_vertices, rebuilt->vertices))
+    return refitTree(true);
+
+  bv_cost = rebuilt->bv_cost;
   return BVH_OK;
 }
 
@@ -40,6 +40,8 @@
 
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <future>
 
 #include "fcl/math/bv/OBB.h"
 #include "fcl/math/bv/kDOP.h"
@@ -141,8 +143,48 @@ public:
   /// @brief Update a set of points in the old BVH model
   int updateSubModel(const std::vector<Vector3<S>>& ps);
 
-  /// @brief End BVH model update, will also refit or rebuild the bounding volume hierarchy
-  int endUpdateModel(bool refit = true, bool bottomup = true);
+  /// @brief End BVH model update, will also refit or rebuild the bounding volume hierarchy.
+  /// A bottom-up refit is split over num_threads threads when num_threads > 1.
+  int endUpdateModel(bool refit = true, bool bottomup = true, int num_threads = 1);
+
+  /// @brief Move a subset of the vertices of a built model and refit only the
+  /// BVs of the primitives which use them and of their ancestors. The refit is
+  /// bottom-up, as in endUpdateModel(true, true). Each index may appear only
+  /// once.
+  ///
+  /// If the model has a previous frame (prev_vertices), the call is one motion
+  /// step of the primitives using the moved vertices: prev_vertices of all
+  /// their vertices is set to the position before the call, and their BVs
+  /// cover both positions. The other primitives did not move, and their BVs,
+  /// which contain their current position, are kept as they are.
+  int updateVertices(const std::vector<int>& indices, const std::vector<Vector3<S>>& ps);
+
+  /// @brief Sum of BV::size() over all the nodes of the hierarchy
+  S getHierarchyCost() const;
+
+  /// @brief Ratio between the current hierarchy cost and the cost of a
+  /// bottom-up refit of the hierarchy right after it was built. It is 1 after
+  /// a build and grows as refits of a deforming model loosen the hierarchy.
+  S getQualityRatio() const;
+
+  /// @brief Rebuild the hierarchy in endUpdateModel() and updateVertices()
+  /// once the quality ratio exceeds threshold; a threshold <= 0 (the default)
+  /// disables it. An asynchronous rebuild runs on a snapshot of the vertices
+  /// in a background thread, and the new hierarchy is installed and refit to
+  /// the current vertices by the first endUpdateModel() or updateVertices()
+  /// after it is done, so queries never see a partially built hierarchy.
+  /// A rebuild of the whole model (endModel(), or an update with refit =
+  /// false) or the destruction of the model cancels a background rebuild
+  /// without waiting for it. Background rebuilds use BVFitter and BVSplitter;
+  /// a model with other fitters or splitters is always rebuilt in place.
+  void setRebuildPolicy(S threshold, bool asynchronous = false);
+
+  /// @brief Whether an asynchronous rebuild is running or waiting to be
+  /// installed
+  bool isRebuildPending() const;
+
+  /// @brief Wait for the asynchronous rebuild, if any, and install it
+  int finishRebuild();
 
   /// @brief Check the number of memory used
   int memUsage(int msg) const;
@@ -200,7 +242,7 @@ private:
   int buildTree();
 
   /// @brief Refit the bounding volume hierarchy
-  int refitTree(bool bottomup);
+  int refitTree(bool bottomup, int num_threads = 1);
 
   /// @brief Refit the bounding volume hierarchy in a top-down way (slow but more compact)
   int refitTree_topdown();
@@ -211,9 +253,79 @@ private:
   /// @brief Recursive kernel for hierarchy construction
   int recursiveBuildTree(int bv_id, int first_primitive, int num_primitives);
 
+  /// @brief Refit the bounding volume hierarchy in a bottom-up way, the
+  /// subtrees are refit in parallel
+  int refitTree_bottomup(int num_threads);
+
   /// @brief Recursive kernel for bottomup refitting 
   int recursiveRefitTree_bottomup(int bv_id);
 
+  /// @brief Refit the BV of a leaf node to its primitive
+  int refitLeaf(int bv_id);
+
+  /// @brief Fit a BV to one primitive, including its previous position if
+  /// the model is being updated
+  BV fitPrimitive(int primitive_id) const;
+
+  /// @brief Build the maps used by updateVertices()
+  void buildUpdateMaps();
+
+  /// @brief Parent of each BV node (-1 for the root), empty until
+  /// updateVertices() is called
+  std::vector<int> bv_parents;
+
+  /// @brief Leaf BV node of each primitive
+  std::vector<int> primitive_leaves;
+
+  /// @brief Triangles using each vertex: the triangles of vertex i are
+  /// vertex_triangles[vertex_triangle_offsets[i]] to
+  /// vertex_triangles[vertex_triangle_offsets[i + 1] - 1]
+  std::vector<int> vertex_triangle_offsets;
+  std::vector<int> vertex_triangles;
+
+  /// @brief Marks of the BV nodes visited by updateVertices()
+  std::vector<bool> bv_dirty;
+
+  /// @brief Sum of BV::size() over the current hierarchy
+  S bv_cost;
+
+  /// @brief Cost of a bottom-up refit of the hierarchy when it was built
+  S bv_build_cost;
+
+  /// @brief Quality ratio above which the hierarchy is rebuilt
+  S rebuild_threshold;
+
+  /// @brief Whether rebuilds run in a background thread
+  bool rebuild_asynchronous;
+
+  /// @brief Hierarchy being built in the background
+  std::future<std::shared_ptr<BVHModel<BV>>> pending_rebuild;
+
+  /// @brief Flag telling the background build of pending_rebuild to stop
+  std::shared_ptr<std::atomic<bool>> rebuild_cancel;
+
+  /// @brief Set on the model built in the background; buildTree() gives up
+  /// once it is raised
+  std::shared_ptr<const std::atomic<bool>> build_cancel;
+
+  /// @brief Stop and release the background rebuild, if any, without waiting
+  /// for it
+  void dropRebuild();
+
+  /// @brief Compute the cost of the hierarchy and the cost of its bottom-up
+  /// refit, without modifying it
+  void computeBuildCost();
+
+  /// @brief Rebuild or install a rebuilt hierarchy, according to the rebuild
+  /// policy. Called at the end of the updates.
+  void maintainHierarchy();
+
+  /// @brief Install the hierarchy built in the background
+  int installRebuild();
+
+  /// @brief Drop the maps used by updateVertices(), after the tree changed
+  void clearUpdateMaps();
+
   /// @recursively compute each bv's transform related to its parent. For
   /// default BV, only the translation works. For oriented BV (OBB, RSS,
   /// OBBRSS), special implementation is provided.
@@ -0,0 +1,322 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BVH_SIGNED_DISTANCE_INL_H
+#define FCL_BVH_SIGNED_DISTANCE_INL_H
+
+#include "fcl/geometry/bvh/BVH_signed_distance.h"
+
+#include "fcl/geometry/bvh/BVH_utility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <utility>
+
+namespace fcl
+{
+
+//==============================================================================
+template <typename BV>
+BVHSignedDistance<BV>::BVHSignedDistance(const BVHModel<BV>& model_)
+  : model(&model_), valid(false), closed(false)
+{
+  // The box of an invalid structure is empty, so that it contains no point
+  boxes.assign(1, AABB<S>());
+
+  if(model->getModelType() != BVH_MODEL_TRIANGLES
+     || model->build_state == BVH_BUILD_STATE_EMPTY
+     || model->build_state == BVH_BUILD_STATE_BEGUN)
+  {
+    std::cerr << "BVH Error! BVHSignedDistance requires a finalized triangle model.\n";
+    return;
+  }
+  valid = true;
+
+  const Vector3<S>* vertices = model->vertices;
+  const Triangle* tri_indices = model->tri_indices;
+  const int num_vertices = model->num_vertices;
+  const int num_tris = model->num_tris;
+
+  // Tight boxes of the triangles in the model frame
+  BVHNodeBoxes(*model, Matrix3<S>::Identity(), boxes);
+
+  face_normals.resize(num_tris);
+  edge_normals.assign(3 * num_tris, Vector3<S>::Zero());
+  vertex_normals.assign(num_vertices, Vector3<S>::Zero());
+  vertex_triangles.assign(num_vertices, -1);
+
+  std::map<std::pair<int, int>, std::vector<int>> edges;
+  for(int t = 0; t < num_tris; ++t)
+  {
+    const Triangle& tri = tri_indices[t];
+    Vector3<S> n = (vertices[tri[1]] - vertices[tri[0]]).cross(
+          vertices[tri[2]] - vertices[tri[0]]);
+    const S l = n.norm();
+    if(l > 0) n /= l;
+    face_normals[t] = n;
+
+    for(int k = 0; k < 3; ++k)
+    {
+      const int v = static_cast<int>(tri[k]);
+      Vector3<S> e1 = vertices[tri[(k + 1) % 3]] - vertices[v];
+      Vector3<S> e2 = vertices[tri[(k + 2) % 3]] - vertices[v];
+      const S l1 = e1.norm();
+      const S l2 = e2.norm();
+      if(l1 > 0 && l2 > 0)
+      {
+        const S c = std::max<S>(-1, std::min<S>(1, e1.dot(e2) / (l1 * l2)));
+        vertex_normals[v] += std::acos(c) * n;
+      }
+      vertex_triangles[v] = t;
+
+      const int w = static_cast<int>(tri[(k + 1) % 3]);
+      edges[std::make_pair(std::min(v, w), std::max(v, w))].push_back(3 * t + k);
+    }
+  }
+
+  closed = true;
+  for(const auto& edge : edges)
+  {
+    const std::vector<int>& slots = edge.second;
+    if(slots.size() != 2) closed = false;
+
+    Vector3<S> n = Vector3<S>::Zero();
+    for(int slot : slots)
+      n += face_normals[slot / 3];
+    for(int slot : slots)
+      edge_normals[slot] = n;
+  }
+
+  if(!closed)
+    std::cerr << "BVH Warning! The mesh of BVHSignedDistance is not closed, the sign of the distance is not reliable.\n";
+}
+
+//==============================================================================
+template <typename BV>
+typename BV::S BVHSignedDistance<BV>::signedDistance(const Vector3<S>& p) const
+{
+  Vector3<S> closest;
+  int tri_id;
+  return signedDistance(p, closest, tri_id);
+}
+
+//==============================================================================
+template <typename BV>
+typename BV::S BVHSignedDistance<BV>::signedDistance(
+    const Vector3<S>& p, Vector3<S>& closest, int& tri_id) const
+{
+  typename detail::Project<S>::ProjectResult proj;
+  const S sqr_distance = closestTriangle(p, -1, proj, tri_id);
+  if(tri_id < 0)
+    return std::numeric_limits<S>::max();
+
+  return signFromProjection(p, sqr_distance, proj, tri_id, closest);
+}
+
+//==============================================================================
+template <typename BV>
+bool BVHSignedDistance<BV>::signedDistanceBeyond(
+    const Vector3<S>& p, S min_distance, S& distance,
+    Vector3<S>& closest, int& tri_id) const
+{
+  typename detail::Project<S>::ProjectResult proj;
+  const S stop = (min_distance > 0) ? min_distance * min_distance : -1;
+  int t;
+  const S sqr_distance = closestTriangle(p, stop, proj, t);
+  if(t < 0 || sqr_distance < stop)
+    return false;
+
+  tri_id = t;
+  distance = signFromProjection(p, sqr_distance, proj, t, closest);
+  return true;
+}
+
+//==============================================================================
+template <typename BV>
+typename BV::S BVHSignedDistance<BV>::closestTriangle(
+    const Vector3<S>& p, S stop_sqr_distance,
+    typename detail::Project<S>::ProjectResult& proj, int& tri_id) const
+{
+  tri_id = -1;
+  if(!valid)
+    return std::numeric_limits<S>::max();
+
+  const Vector3<S>* vertices = model->vertices;
+  const Triangle* tri_indices = model->tri_indices;
+
+  auto boxSqrDistance = [&p](const AABB<S>& box)
+  {
+    S d = 0;
+    for(int j = 0; j < 3; ++j)
+    {
+      if(p[j] < box.min_[j]) d += (box.min_[j] - p[j]) * (box.min_[j] - p[j]);
+      else if(p[j] > box.max_[j]) d += (p[j] - box.max_[j]) * (p[j] - box.max_[j]);
+    }
+    return d;
+  };
+
+  S best = std::numeric_limits<S>::max();
+
+  // Best-first descent: the nearer child is pushed last so it is visited
+  // first, and every node is pruned against the closest triangle so far.
+  std::vector<std::pair<S, int>> stack;
+  stack.reserve(64);
+  stack.emplace_back(boxSqrDistance(boxes[0]), 0);
+  while(!stack.empty())
+  {
+    const std::pair<S, int> item = stack.back();
+    stack.pop_back();
+    if(item.first >= best) continue;
+
+    const BVNode<BV>& node = model->getBV(item.second);
+    if(node.isLeaf())
+    {
+      const int t = node.primitiveId();
+      const Triangle& tri = tri_indices[t];
+      typename detail::Project<S>::ProjectResult res =
+          detail::Project<S>::projectTriangle(
+            vertices[tri[0]], vertices[tri[1]], vertices[tri[2]], p);
+      if(res.sqr_distance >= 0 && res.sqr_distance < best)
+      {
+        best = res.sqr_distance;
+        proj = res;
+        tri_id = t;
+        if(best < stop_sqr_distance) break;
+      }
+      continue;
+    }
+
+    const int c1 = node.leftChild();
+    const int c2 = node.rightChild();
+    const S d1 = boxSqrDistance(boxes[c1]);
+    const S d2 = boxSqrDistance(boxes[c2]);
+    if(d1 < d2)
+    {
+      if(d2 < best) stack.emplace_back(d2, c2);
+      if(d1 < best) stack.emplace_back(d1, c1);
+    }
+    else
+    {
+      if(d1 < best) stack.emplace_back(d1, c1);
+      if(d2 < best) stack.emplace_back(d2, c2);
+    }
+  }
+
+  return best;
+}
+
+//==============================================================================
+template <typename BV>
+typename BV::S BVHSignedDistance<BV>::signFromProjection(
+    const Vector3<S>& p, S sqr_distance,
+    const typename detail::Project<S>::ProjectResult& proj,
+    int tri_id, Vector3<S>& closest) const
+{
+  const Vector3<S>* vertices = model->vertices;
+  const Triangle& tri = model->tri_indices[tri_id];
+  closest = proj.parameterization[0] * vertices[tri[0]]
+      + proj.parameterization[1] * vertices[tri[1]]
+      + proj.parameterization[2] * vertices[tri[2]];
+
+  // The projection code has one bit per triangle vertex in the support of the
+  // closest point.
+  Vector3<S> n;
+  switch(proj.encode)
+  {
+  case 1: n = vertex_normals[tri[0]]; break;
+  case 2: n = vertex_normals[tri[1]]; break;
+  case 4: n = vertex_normals[tri[2]]; break;
+  case 3: n = edge_normals[3 * tri_id]; break;
+  case 6: n = edge_normals[3 * tri_id + 1]; break;
+  case 5: n = edge_normals[3 * tri_id + 2]; break;
+  default: n = face_normals[tri_id];
+  }
+
+  const S d = std::sqrt(sqr_distance);
+  return ((p - closest).dot(n) < 0) ? -d : d;
+}
+
+//==============================================================================
+template <typename BV>
+bool BVHSignedDistance<BV>::isInside(const Vector3<S>& p) const
+{
+  if(!valid || !boxes[0].contain(p))
+    return false;
+  return signedDistance(p) < 0;
+}
+
+//==============================================================================
+template <typename BV>
+bool BVHSignedDistance<BV>::isValid() const
+{
+  return valid;
+}
+
+//==============================================================================
+template <typename BV>
+bool BVHSignedDistance<BV>::isClosed() const
+{
+  return closed;
+}
+
+//==============================================================================
+template <typename BV>
+const BVHModel<BV>& BVHSignedDistance<BV>::getModel() const
+{
+  return *model;
+}
+
+//==============================================================================
+template <typename BV>
+const AABB<typename BV::S>& BVHSignedDistance<BV>::getRootBox() const
+{
+  return boxes[0];
+}
+
+//==============================================================================
+template <typename BV>
+int BVHSignedDistance<BV>::getVertexTriangle(int v) const
+{
+  if(v < 0 || v >= static_cast<int>(vertex_triangles.size()))
+    return -1;
+  return vertex_triangles[v];
+}
+
+} // namespace fcl
+
+#endif
@@ -0,0 +1,145 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BVH_SIGNED_DISTANCE_H
+#define FCL_BVH_SIGNED_DISTANCE_H
+
+#include <vector>
+
+#include "fcl/math/bv/AABB.h"
+#include "fcl/math/detail/project.h"
+#include "fcl/geometry/bvh/BVH_model.h"
+
+namespace fcl
+{
+
+/// @brief Signed distance queries from points to a closed triangle BVHModel.
+///
+/// The structure keeps a pointer to the model and reuses its hierarchy, with
+/// one axis-aligned box per node in the model frame, so the closest triangle
+/// to a point is found by a best-first descent. The sign comes from the
+/// angle-weighted pseudo normal of the closest feature (face, edge or vertex),
+/// which are precomputed in the constructor. The sign is only meaningful for
+/// closed, consistently oriented meshes (normals pointing outward); see
+/// isClosed().
+///
+/// The model must outlive this object and must not be modified while it is
+/// in use.
+template <typename BV>
+class FCL_EXPORT BVHSignedDistance
+{
+public:
+
+  using S = typename BV::S;
+
+  /// @brief Precompute the boxes and the pseudo normals of a finalized
+  /// triangle model. Any other model gives an invalid structure (see
+  /// isValid()) on which no point is inside and every distance is
+  /// std::numeric_limits<S>::max().
+  explicit BVHSignedDistance(const BVHModel<BV>& model);
+
+  /// @brief Whether the model was a finalized triangle model
+  bool isValid() const;
+
+  /// @brief Signed distance from p (in the model frame) to the surface,
+  /// negative inside the mesh
+  S signedDistance(const Vector3<S>& p) const;
+
+  /// @brief Signed distance from p (in the model frame) to the surface,
+  /// negative inside the mesh. closest is set to the closest point on the
+  /// surface and tri_id to the triangle which contains it.
+  S signedDistance(const Vector3<S>& p, Vector3<S>& closest, int& tri_id) const;
+
+  /// @brief Same as signedDistance(), but the search stops as soon as a part
+  /// of the surface is found closer than min_distance to p, in which case
+  /// false is returned and the outputs are not set. This is much cheaper when
+  /// only the points far from the surface are of interest.
+  bool signedDistanceBeyond(const Vector3<S>& p, S min_distance, S& distance,
+                            Vector3<S>& closest, int& tri_id) const;
+
+  /// @brief Whether p (in the model frame) is strictly inside the mesh
+  bool isInside(const Vector3<S>& p) const;
+
+  /// @brief Whether every edge of the mesh is shared by exactly two triangles
+  bool isClosed() const;
+
+  /// @brief The model the queries are answered for
+  const BVHModel<BV>& getModel() const;
+
+  /// @brief Box of the whole mesh, in the model frame (an empty box for an
+  /// invalid structure)
+  const AABB<S>& getRootBox() const;
+
+  /// @brief One of the triangles which use vertex v, or -1 for an unused
+  /// vertex or an invalid structure
+  int getVertexTriangle(int v) const;
+
+private:
+
+  /// @brief Squared distance from p to the closest triangle, which is
+  /// returned in tri_id with the projection of p. The search stops at the
+  /// first triangle closer than stop_sqr_distance.
+  S closestTriangle(const Vector3<S>& p, S stop_sqr_distance,
+                    typename detail::Project<S>::ProjectResult& proj,
+                    int& tri_id) const;
+
+  /// @brief Signed distance given the closest triangle and the projection
+  S signFromProjection(const Vector3<S>& p, S sqr_distance,
+                       const typename detail::Project<S>::ProjectResult& proj,
+                       int tri_id, Vector3<S>& closest) const;
+
+  const BVHModel<BV>* model;
+
+  std::vector<AABB<S>> boxes;
+
+  std::vector<Vector3<S>> face_normals;
+
+  /// @brief Pseudo normal of edge (k, k + 1) of triangle t at 3 * t + k
+  std::vector<Vector3<S>> edge_normals;
+
+  std::vector<Vector3<S>> vertex_normals;
+
+  std::vector<int> vertex_triangles;
+
+  bool valid;
+
+  bool closed;
+};
+
+} // namespace fcl
+
+#include "fcl/geometry/bvh/BVH_signed_distance-inl.h"
+
+#endif
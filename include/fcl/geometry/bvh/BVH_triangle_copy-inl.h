@@ -0,0 +1,118 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BVH_TRIANGLE_COPY_INL_H
+#define FCL_BVH_TRIANGLE_COPY_INL_H
+
+#include "fcl/geometry/bvh/BVH_triangle_copy.h"
+
+#include <iostream>
+
+namespace fcl
+{
+
+//==============================================================================
+template <typename BV>
+BVHTriangleCopy<BV>::BVHTriangleCopy(
+    const BVHModel<BV>& model, const char* type_name)
+  : CollisionGeometry<S>(model), valid(false)
+{
+  if(model.getModelType() != BVH_MODEL_TRIANGLES
+     || model.build_state == BVH_BUILD_STATE_EMPTY
+     || model.build_state == BVH_BUILD_STATE_BEGUN)
+  {
+    std::cerr << "BVH Error! " << type_name << " requires a finalized triangle model.\n";
+    return;
+  }
+
+  vertices.assign(model.vertices, model.vertices + model.num_vertices);
+  tri_indices.assign(model.tri_indices, model.tri_indices + model.num_tris);
+  valid = true;
+}
+
+//==============================================================================
+template <typename BV>
+bool BVHTriangleCopy<BV>::isValid() const
+{
+  return valid;
+}
+
+//==============================================================================
+template <typename BV>
+void BVHTriangleCopy<BV>::computeLocalAABB()
+{
+  AABB<S> aabb_;
+  for(const auto& v : vertices)
+    aabb_ += v;
+
+  this->aabb_center = aabb_.center();
+
+  this->aabb_radius = 0;
+  for(const auto& v : vertices)
+  {
+    S r = (this->aabb_center - v).squaredNorm();
+    if(r > this->aabb_radius) this->aabb_radius = r;
+  }
+
+  this->aabb_radius = sqrt(this->aabb_radius);
+
+  this->aabb_local = aabb_;
+}
+
+//==============================================================================
+template <typename BV>
+int BVHTriangleCopy<BV>::printMemUsage(
+    const char* model_name, int num_bvs, std::size_t mem_bv_list,
+    std::size_t object_size, int msg) const
+{
+  std::size_t mem_tri_list = sizeof(Triangle) * tri_indices.size();
+  std::size_t mem_vertex_list = sizeof(Vector3<S>) * vertices.size();
+
+  std::size_t total_mem = mem_bv_list + mem_tri_list + mem_vertex_list
+      + object_size;
+  if(msg)
+  {
+    std::cerr << "Total for " << model_name << " model " << total_mem << " bytes.\n";
+    std::cerr << "BVs: " << num_bvs << " allocated (" << mem_bv_list << " bytes).\n";
+    std::cerr << "Tris: " << tri_indices.size() << " allocated.\n";
+    std::cerr << "Vertices: " << vertices.size() << " allocated.\n";
+  }
+
+  return BVH_OK;
+}
+
+} // namespace fcl
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_BVH_TRIANGLE_COPY_H
+#define FCL_BVH_TRIANGLE_COPY_H
+
+#include <vector>
+
+#include "fcl/geometry/bvh/BVH_model.h"
+
+namespace fcl
+{
+
+/// @brief Common base of the read-only variants of a triangle BVHModel
+/// (BVHCompressed, BVHMixed): a copy of the vertices and triangles of the
+/// source model, which each variant pairs with its own hierarchy.
+template <typename BV>
+class FCL_EXPORT BVHTriangleCopy : public CollisionGeometry<typename BV::S>
+{
+public:
+
+  using S = typename BV::S;
+
+  /// @brief Whether the source model was a finalized triangle model. An
+  /// invalid copy has no triangles and no hierarchy.
+  bool isValid() const;
+
+  /// @brief Compute the AABB for the model
+  void computeLocalAABB() override;
+
+  /// @brief Geometry point data
+  std::vector<Vector3<S>> vertices;
+
+  /// @brief Geometry triangle index data
+  std::vector<Triangle> tri_indices;
+
+protected:
+
+  /// @brief Copy the triangles of a finalized triangle model. Any other model
+  /// gives an invalid copy and an error naming the variant type_name.
+  BVHTriangleCopy(const BVHModel<BV>& model, const char* type_name);
+
+  /// @brief Print the memory used by a variant described by model_name,
+  /// given the size of its hierarchy and of the variant object itself
+  int printMemUsage(const char* model_name, int num_bvs,
+                    std::size_t mem_bv_list, std::size_t object_size,
+                    int msg) const;
+
+private:
+
+  bool valid;
+};
+
+} // namespace fcl
+
+#include "fcl/geometry/bvh/BVH_triangle_copy-inl.h"
+
+#endif
@@ -167,6 +167,39 @@ void BVHExpand(
   }
 }
 
+//==============================================================================
+template <typename BV>
+void BVHNodeBoxes(
+    const BVHModel<BV>& model,
+    const Matrix3<typename BV::S>& axis,
+    std::vector<AABB<typename BV::S>>& boxes)
+{
+  using S = typename BV::S;
+
+  const Vector3<S>* vertices = model.vertices;
+  const Triangle* tri_indices = model.tri_indices;
+
+  // The children always follow their parent in BVHModel, so a reverse sweep
+  // is bottom-up.
+  const int num_bvs = model.getNumBVs();
+  boxes.resize(num_bvs);
+  for(int i = num_bvs - 1; i >= 0; --i)
+  {
+    const BVNode<BV>& node = model.getBV(i);
+    if(node.isLeaf())
+    {
+      const Triangle& t = tri_indices[node.primitiveId()];
+      boxes[i] = AABB<S>(axis.transpose() * vertices[t[0]]);
+      boxes[i] += axis.transpose() * vertices[t[1]];
+      boxes[i] += axis.transpose() * vertices[t[2]];
+    }
+    else
+    {
+      boxes[i] = boxes[node.leftChild()] + boxes[node.rightChild()];
+    }
+  }
+}
+
 } // namespace fcl
 
 #endif
@@ -38,7 +38,10 @@
 #ifndef FCL_BVH_UTILITY_H
 #define FCL_BVH_UTILITY_H
 
+#include <vector>
+
 #include "fcl/math/variance3.h"
+#include "fcl/math/bv/AABB.h"
 #include "fcl/geometry/bvh/BVH_model.h"
 
 namespace fcl
@@ -64,6 +67,16 @@ FCL_EXPORT
 void BVHExpand(
     BVHModel<RSS<S>>& model, const Variance3<S>* ucs, S r = 1.0);
 
+/// @brief Compute the tight axis-aligned boxes of the nodes of a triangle
+/// BVHModel, in the frame whose axes are the columns of axis (expressed in
+/// the model frame). boxes[i] is the box of node i.
+template <typename BV>
+FCL_EXPORT
+void BVHNodeBoxes(
+    const BVHModel<BV>& model,
+    const Matrix3<typename BV::S>& axis,
+    std::vector<AABB<typename BV::S>>& boxes);
+
 } // namespace fcl
 
 #include "fcl/geometry/bvh/BVH_utility-inl.h"
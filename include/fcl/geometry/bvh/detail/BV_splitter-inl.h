@@ -508,6 +508,13 @@ void BVSplitter<BV>::clear()
   type = BVH_MODEL_UNKNOWN;
 }
 
+//==============================================================================
+template <typename BV>
+SplitMethodType BVSplitter<BV>::getSplitMethod() const
+{
+  return split_method;
+}
+
 //==============================================================================
 template <typename S, typename BV>
 struct ComputeSplitVectorImpl
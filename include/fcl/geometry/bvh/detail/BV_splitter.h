@@ -88,6 +88,9 @@ public:
   /// @brief Clear the geometry data set before
   void clear();
 
+  /// @brief The split algorithm used
+  SplitMethodType getSplitMethod() const;
+
 private:
 
   /// @brief The axis based on which the split decision is made. For most BV,
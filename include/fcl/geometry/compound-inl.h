@@ -0,0 +1,302 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_GEOMETRY_COMPOUND_INL_H
+#define FCL_GEOMETRY_COMPOUND_INL_H
+
+#include "fcl/geometry/compound.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+class FCL_EXPORT Compound<double>;
+
+namespace detail
+{
+
+//==============================================================================
+extern template
+AABB<double> transformAABB(const AABB<double>& box, const Transform3<double>& tf);
+
+} // namespace detail
+
+//==============================================================================
+template <typename S>
+Compound<S>::Compound()
+  : CollisionGeometry<S>()
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+void Compound<S>::addChild(
+    const std::shared_ptr<CollisionGeometry<S>>& geometry,
+    const Transform3<S>& tf)
+{
+  children.push_back(geometry);
+  transforms.push_back(tf);
+}
+
+//==============================================================================
+template <typename S>
+int Compound<S>::getNumChildren() const
+{
+  return static_cast<int>(children.size());
+}
+
+//==============================================================================
+template <typename S>
+const std::shared_ptr<CollisionGeometry<S>>& Compound<S>::getChild(int i) const
+{
+  return children[i];
+}
+
+//==============================================================================
+template <typename S>
+const Transform3<S>& Compound<S>::getChildTransform(int i) const
+{
+  return transforms[i];
+}
+
+//==============================================================================
+template <typename S>
+const AABB<S>& Compound<S>::getChildBox(int i) const
+{
+  return child_boxes[i];
+}
+
+//==============================================================================
+template <typename S>
+void Compound<S>::computeLocalAABB()
+{
+  const int num_children = getNumChildren();
+
+  child_boxes.resize(num_children);
+  AABB<S> aabb_;
+  for(int i = 0; i < num_children; ++i)
+  {
+    children[i]->computeLocalAABB();
+    child_boxes[i] = detail::transformAABB(children[i]->aabb_local, transforms[i]);
+    if(i == 0)
+      aabb_ = child_boxes[i];
+    else
+      aabb_ += child_boxes[i];
+  }
+
+  bvs.clear();
+  if(num_children > 0)
+  {
+    std::vector<int> child_order(num_children);
+    std::iota(child_order.begin(), child_order.end(), 0);
+    bvs.reserve(2 * num_children - 1);
+    bvs.emplace_back();
+    recursiveBuild(0, 0, num_children, child_order);
+  }
+
+  this->aabb_local = aabb_;
+  this->aabb_center = aabb_.center();
+  this->aabb_radius = 0;
+  for(int i = 0; i < num_children; ++i)
+  {
+    // the corners of the child boxes bound the children
+    const AABB<S>& box = child_boxes[i];
+    for(int k = 0; k < 8; ++k)
+    {
+      const Vector3<S> corner((k & 1) ? box.max_[0] : box.min_[0],
+                              (k & 2) ? box.max_[1] : box.min_[1],
+                              (k & 4) ? box.max_[2] : box.min_[2]);
+      this->aabb_radius = std::max(this->aabb_radius, (corner - this->aabb_center).norm());
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void Compound<S>::recursiveBuild(
+    int bv_id, int first, int num, std::vector<int>& child_order)
+{
+  AABB<S> box = child_boxes[child_order[first]];
+  for(int i = 1; i < num; ++i)
+    box += child_boxes[child_order[first + i]];
+  bvs[bv_id].bv = box;
+  bvs[bv_id].first_primitive = first;
+  bvs[bv_id].num_primitives = num;
+
+  if(num == 1)
+  {
+    bvs[bv_id].first_child = -(child_order[first] + 1);
+    return;
+  }
+
+  // median split of the centers along the longest axis of the node
+  int axis = 0;
+  if(box.height() > box.width()) axis = 1;
+  if(box.depth() > ((axis == 0) ? box.width() : box.height())) axis = 2;
+
+  const int half = num / 2;
+  std::nth_element(child_order.begin() + first,
+                   child_order.begin() + first + half,
+                   child_order.begin() + first + num,
+                   [this, axis](int a, int b)
+  {
+    return child_boxes[a].center()[axis] < child_boxes[b].center()[axis];
+  });
+
+  const int left = static_cast<int>(bvs.size());
+  bvs[bv_id].first_child = left;
+  bvs.emplace_back();
+  bvs.emplace_back();
+  recursiveBuild(left, first, half, child_order);
+  recursiveBuild(left + 1, first + half, num - half, child_order);
+}
+
+//==============================================================================
+template <typename S>
+OBJECT_TYPE Compound<S>::getObjectType() const
+{
+  return OT_GEOM;
+}
+
+//==============================================================================
+template <typename S>
+NODE_TYPE Compound<S>::getNodeType() const
+{
+  return GEOM_COMPOUND;
+}
+
+//==============================================================================
+template <typename S>
+const BVNode<AABB<S>>& Compound<S>::getBV(int id) const
+{
+  return bvs[id];
+}
+
+//==============================================================================
+template <typename S>
+int Compound<S>::getNumBVs() const
+{
+  return static_cast<int>(bvs.size());
+}
+
+//==============================================================================
+template <typename S>
+void Compound<S>::queryChildren(
+    const AABB<S>& box, std::vector<int>& overlapping) const
+{
+  overlapping.clear();
+
+  // without a hierarchy, every child is a candidate
+  if(bvs.empty())
+  {
+    for(int i = 0; i < getNumChildren(); ++i)
+    {
+      if(i >= static_cast<int>(child_boxes.size()) || child_boxes[i].overlap(box))
+        overlapping.push_back(i);
+    }
+    return;
+  }
+
+  std::vector<int> stack(1, 0);
+  while(!stack.empty())
+  {
+    const BVNode<AABB<S>>& node = bvs[stack.back()];
+    stack.pop_back();
+    if(!node.bv.overlap(box))
+      continue;
+
+    if(node.isLeaf())
+    {
+      overlapping.push_back(node.primitiveId());
+    }
+    else
+    {
+      stack.push_back(node.rightChild());
+      stack.push_back(node.leftChild());
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void Compound<S>::queryChildren(
+    const CollisionGeometry<S>& geometry,
+    const Transform3<S>& tf,
+    std::vector<int>& overlapping) const
+{
+  const AABB<S>& box = geometry.aabb_local;
+  if(box.min_[0] > box.max_[0])
+  {
+    overlapping.resize(getNumChildren());
+    std::iota(overlapping.begin(), overlapping.end(), 0);
+    return;
+  }
+
+  queryChildren(detail::transformAABB(box, tf), overlapping);
+}
+
+//==============================================================================
+template <typename S>
+S Compound<S>::computeVolume() const
+{
+  S volume = 0;
+  for(const auto& child : children)
+    volume += child->computeVolume();
+  return volume;
+}
+
+namespace detail
+{
+
+//==============================================================================
+template <typename S>
+AABB<S> transformAABB(const AABB<S>& box, const Transform3<S>& tf)
+{
+  const Vector3<S> center = tf * box.center();
+  const Vector3<S> extent
+      = tf.linear().cwiseAbs() * ((box.max_ - box.min_) * 0.5);
+  return AABB<S>(center - extent, center + extent);
+}
+
+} // namespace detail
+
+} // namespace fcl
+
+#endif
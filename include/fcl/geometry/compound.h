@@ -0,0 +1,156 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_GEOMETRY_COMPOUND_H
+#define FCL_GEOMETRY_COMPOUND_H
+
+#include <memory>
+#include <vector>
+
+#include "fcl/common/types.h"
+#include "fcl/math/bv/AABB.h"
+#include "fcl/geometry/collision_geometry.h"
+#include "fcl/geometry/bvh/BV_node.h"
+
+namespace fcl
+{
+
+/// @brief A rigid assembly of child geometries, each one at a fixed pose in
+/// the frame of the compound.
+///
+/// A compound is a single CollisionGeometry, so a robot link made of several
+/// convex pieces is one CollisionObject in the broadphase. The children are
+/// organized in a small AABB hierarchy (stored like the one of BVHModel, with
+/// the children of a node right after it), so collision and distance queries
+/// only dispatch the children whose box can matter to the regular collide()
+/// and distance() functions. Contacts and distance results report the
+/// compound as the object and the index of the child as the primitive id.
+///
+/// The hierarchy and the AABB are computed by computeLocalAABB(), which
+/// CollisionObject calls on construction; call it again after adding
+/// children to a compound which is already in use, or after modifying a
+/// child.
+template <typename S_>
+class FCL_EXPORT Compound : public CollisionGeometry<S_>
+{
+public:
+
+  using S = S_;
+
+  Compound();
+
+  /// @brief Add a child geometry with its pose in the frame of the compound
+  void addChild(const std::shared_ptr<CollisionGeometry<S>>& geometry,
+                const Transform3<S>& tf = Transform3<S>::Identity());
+
+  /// @brief Number of children
+  int getNumChildren() const;
+
+  /// @brief Geometry of child i
+  const std::shared_ptr<CollisionGeometry<S>>& getChild(int i) const;
+
+  /// @brief Pose of child i in the frame of the compound
+  const Transform3<S>& getChildTransform(int i) const;
+
+  /// @brief Box of child i in the frame of the compound
+  const AABB<S>& getChildBox(int i) const;
+
+  /// @brief Compute the AABB of the children and rebuild the hierarchy
+  void computeLocalAABB() override;
+
+  /// @brief Get object type: a geometric shape
+  OBJECT_TYPE getObjectType() const override;
+
+  /// @brief Get node type: a compound
+  NODE_TYPE getNodeType() const override;
+
+  /// @brief Access the node of the hierarchy giving its index. The primitive
+  /// of a leaf is the index of a child.
+  const BVNode<AABB<S>>& getBV(int id) const;
+
+  /// @brief Number of nodes of the hierarchy (0 until computeLocalAABB() is
+  /// called, or for a compound without children)
+  int getNumBVs() const;
+
+  /// @brief Collect the children whose box overlaps box, which is given in
+  /// the frame of the compound
+  void queryChildren(const AABB<S>& box, std::vector<int>& overlapping) const;
+
+  /// @brief Collect the children which may touch geometry placed at tf in the
+  /// frame of the compound. Every child is collected when the local AABB of
+  /// geometry was never computed (shapes only get one from
+  /// computeLocalAABB()).
+  void queryChildren(const CollisionGeometry<S>& geometry,
+                     const Transform3<S>& tf,
+                     std::vector<int>& overlapping) const;
+
+  /// @brief Sum of the volumes of the children (the children are assumed to
+  /// be disjoint)
+  S computeVolume() const override;
+
+private:
+
+  /// @brief Recursive kernel of the hierarchy construction on
+  /// child_order[first, first + num)
+  void recursiveBuild(int bv_id, int first, int num, std::vector<int>& child_order);
+
+  std::vector<std::shared_ptr<CollisionGeometry<S>>> children;
+
+  aligned_vector<Transform3<S>> transforms;
+
+  std::vector<AABB<S>> child_boxes;
+
+  std::vector<BVNode<AABB<S>>> bvs;
+};
+
+using Compoundf = Compound<float>;
+using Compoundd = Compound<double>;
+
+namespace detail
+{
+
+/// @brief Box, in the parent frame, of the local box of a geometry placed at
+/// tf in that frame
+template <typename S>
+FCL_EXPORT
+AABB<S> transformAABB(const AABB<S>& box, const Transform3<S>& tf);
+
+} // namespace detail
+
+} // namespace fcl
+
+#include "fcl/geometry/compound-inl.h"
+
+#endif
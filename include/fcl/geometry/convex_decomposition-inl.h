@@ -0,0 +1,262 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_GEOMETRY_CONVEX_DECOMPOSITION_INL_H
+#define FCL_GEOMETRY_CONVEX_DECOMPOSITION_INL_H
+
+#include "fcl/geometry/convex_decomposition.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+#include "fcl/geometry/convex_hull.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+/// @brief A part of the mesh during the decomposition: its triangles, and the
+/// points which close it on the planes which cut it
+template <typename S>
+struct DecompositionPart
+{
+  std::vector<int> triangles;
+  aligned_vector<Vector3<S>> caps;
+
+  /// @brief The vertices of the triangles followed by the caps
+  std::vector<Vector3<S>> points;
+
+  /// @brief Number of vertices of the triangles at the front of points
+  int num_surface_points;
+
+  S concavity;
+};
+
+//==============================================================================
+/// @brief Gather the points of a part and measure its concavity. Returns
+/// false if the part does not span a volume.
+template <typename S>
+bool measurePart(
+    const Vector3<S>* vertices,
+    const Triangle* tri_indices,
+    std::vector<int>& vertex_marks,
+    int mark,
+    DecompositionPart<S>& part)
+{
+  part.points.clear();
+  for(int t : part.triangles)
+  {
+    for(int k = 0; k < 3; ++k)
+    {
+      const int v = static_cast<int>(tri_indices[t][k]);
+      if(vertex_marks[v] == mark) continue;
+      vertex_marks[v] = mark;
+      part.points.push_back(vertices[v]);
+    }
+  }
+  part.num_surface_points = static_cast<int>(part.points.size());
+  part.points.insert(part.points.end(), part.caps.begin(), part.caps.end());
+
+  std::vector<int> hull_vertices;
+  std::vector<int> hull_triangles;
+  if(part.points.size() < 4
+     || !quickHull(part.points.data(), static_cast<int>(part.points.size()),
+                   0, hull_vertices, hull_triangles))
+    return false;
+
+  part.concavity = hullConcavity(part.points, hull_triangles,
+                                 part.num_surface_points);
+  return true;
+}
+
+//==============================================================================
+template <typename S>
+S hullConcavity(const std::vector<Vector3<S>>& points,
+                const std::vector<int>& hull_triangles,
+                int num_surface_points)
+{
+  const int num_faces = static_cast<int>(hull_triangles.size() / 3);
+  std::vector<Vector3<S>> normals(num_faces);
+  std::vector<S> offsets(num_faces);
+  for(int f = 0; f < num_faces; ++f)
+  {
+    const Vector3<S>& a = points[hull_triangles[3 * f]];
+    const Vector3<S>& b = points[hull_triangles[3 * f + 1]];
+    const Vector3<S>& c = points[hull_triangles[3 * f + 2]];
+    Vector3<S> n = (b - a).cross(c - a);
+    const S l = n.norm();
+    if(l > 0) n /= l;
+    normals[f] = n;
+    offsets[f] = n.dot(a);
+  }
+
+  S concavity = 0;
+  for(int i = 0; i < num_surface_points; ++i)
+  {
+    S depth = std::numeric_limits<S>::max();
+    for(int f = 0; f < num_faces; ++f)
+      depth = std::min(depth, offsets[f] - normals[f].dot(points[i]));
+    concavity = std::max(concavity, depth);
+  }
+
+  return concavity;
+}
+
+} // namespace detail
+
+//==============================================================================
+template <typename BV>
+std::shared_ptr<Compound<typename BV::S>> convexDecomposition(
+    const BVHModel<BV>& model,
+    typename BV::S max_concavity,
+    int max_pieces)
+{
+  using S = typename BV::S;
+
+  if(model.getModelType() != BVH_MODEL_TRIANGLES
+     || model.build_state == BVH_BUILD_STATE_EMPTY
+     || model.build_state == BVH_BUILD_STATE_BEGUN)
+  {
+    std::cerr << "Error! convexDecomposition requires a finalized triangle model.\n";
+    return nullptr;
+  }
+
+  const Vector3<S>* vertices = model.vertices;
+  const Triangle* tri_indices = model.tri_indices;
+
+  std::vector<int> vertex_marks(model.num_vertices, -1);
+  int mark = 0;
+
+  std::vector<detail::DecompositionPart<S>> parts(1);
+  parts[0].triangles.resize(model.num_tris);
+  for(int t = 0; t < model.num_tris; ++t)
+    parts[0].triangles[t] = t;
+  if(!detail::measurePart(vertices, tri_indices, vertex_marks, mark++, parts[0]))
+  {
+    std::cerr << "Error! convexDecomposition requires a mesh which spans a volume.\n";
+    return nullptr;
+  }
+
+  // parts which cannot be split any further
+  std::vector<bool> final_parts(1, false);
+
+  while(static_cast<int>(parts.size()) < max_pieces)
+  {
+    int worst = -1;
+    for(std::size_t i = 0; i < parts.size(); ++i)
+    {
+      if(final_parts[i] || parts[i].concavity <= max_concavity) continue;
+      if(worst < 0 || parts[i].concavity > parts[worst].concavity)
+        worst = static_cast<int>(i);
+    }
+    if(worst < 0)
+      break;
+
+    const detail::DecompositionPart<S>& part = parts[worst];
+
+    // split plane: normal to the longest axis of the part, through the mean
+    // of the centroids of its triangles
+    AABB<S> box(part.points[0]);
+    for(const auto& p : part.points)
+      box += p;
+    int axis = 0;
+    if(box.height() > box.width()) axis = 1;
+    if(box.depth() > ((axis == 0) ? box.width() : box.height())) axis = 2;
+
+    std::vector<S> centroids(part.triangles.size());
+    S split = 0;
+    for(std::size_t i = 0; i < part.triangles.size(); ++i)
+    {
+      const Triangle& t = tri_indices[part.triangles[i]];
+      centroids[i] = (vertices[t[0]][axis] + vertices[t[1]][axis] + vertices[t[2]][axis]) / 3;
+      split += centroids[i];
+    }
+    split /= static_cast<S>(part.triangles.size());
+
+    detail::DecompositionPart<S> halves[2];
+    for(std::size_t i = 0; i < part.triangles.size(); ++i)
+      halves[centroids[i] < split ? 0 : 1].triangles.push_back(part.triangles[i]);
+    for(const auto& c : part.caps)
+      halves[c[axis] < split ? 0 : 1].caps.push_back(c);
+
+    bool valid = !halves[0].triangles.empty() && !halves[1].triangles.empty();
+    for(int h = 0; valid && h < 2; ++h)
+    {
+      // close the half with the projection of its points onto the plane
+      if(!detail::measurePart(vertices, tri_indices, vertex_marks, mark++, halves[h]))
+      {
+        valid = false;
+        break;
+      }
+      const std::size_t num_points = halves[h].points.size();
+      for(std::size_t i = 0; i < num_points; ++i)
+      {
+        Vector3<S> p = halves[h].points[i];
+        p[axis] = split;
+        halves[h].caps.push_back(p);
+      }
+      valid = detail::measurePart(vertices, tri_indices, vertex_marks, mark++, halves[h]);
+    }
+
+    if(!valid)
+    {
+      final_parts[worst] = true;
+      continue;
+    }
+
+    parts[worst] = std::move(halves[0]);
+    parts.push_back(std::move(halves[1]));
+    final_parts.push_back(false);
+  }
+
+  auto compound = std::make_shared<Compound<S>>();
+  for(const auto& part : parts)
+  {
+    std::shared_ptr<Convex<S>> piece = convexHull(part.points);
+    if(piece)
+      compound->addChild(piece);
+  }
+  compound->computeLocalAABB();
+
+  return compound;
+}
+
+} // namespace fcl
+
+#endif
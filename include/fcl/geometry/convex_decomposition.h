@@ -0,0 +1,89 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_GEOMETRY_CONVEX_DECOMPOSITION_H
+#define FCL_GEOMETRY_CONVEX_DECOMPOSITION_H
+
+#include <memory>
+
+#include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/geometry/compound.h"
+#include "fcl/geometry/shape/convex.h"
+
+namespace fcl
+{
+
+/// @brief Approximate convex decomposition of a triangle model into a
+/// Compound of Convex pieces (all at the identity pose).
+///
+/// The mesh is split recursively by planes normal to the longest axis of the
+/// box of a part, through the mean of the centroids of its triangles, always
+/// splitting the most concave part first. The concavity of a part is the
+/// largest distance from one of its vertices to the boundary of its convex
+/// hull. Every part is closed by the projection of its points onto the planes
+/// which cut it, so each piece covers the volume between its part of the
+/// surface and the cuts, and the union of the pieces covers a closed mesh.
+///
+/// The splitting stops when every part has a concavity of at most
+/// max_concavity, or when there are max_pieces parts. Returns nullptr (and
+/// prints an error) for a model which is not a finalized triangle model or
+/// which is flat.
+template <typename BV>
+FCL_EXPORT
+std::shared_ptr<Compound<typename BV::S>> convexDecomposition(
+    const BVHModel<BV>& model,
+    typename BV::S max_concavity,
+    int max_pieces = 16);
+
+namespace detail
+{
+
+/// @brief Largest distance from one of points to the boundary of the convex
+/// polytope given by the triangles of its hull (three indices into points per
+/// triangle, oriented counter-clockwise from outside). Points outside of the
+/// hull count as 0.
+template <typename S>
+FCL_EXPORT
+S hullConcavity(const std::vector<Vector3<S>>& points,
+                const std::vector<int>& hull_triangles,
+                int num_surface_points);
+
+} // namespace detail
+
+} // namespace fcl
+
+#include "fcl/geometry/convex_decomposition-inl.h"
+
+#endif
@@ -0,0 +1,503 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_GEOMETRY_CONVEX_HULL_INL_H
+#define FCL_GEOMETRY_CONVEX_HULL_INL_H
+
+#include "fcl/geometry/convex_hull.h"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+/// @brief A triangle of the hull under construction. Edge i goes from v[i] to
+/// v[(i + 1) % 3] and neighbor[i] is the face on the other side of it.
+template <typename S>
+struct QuickHullFace
+{
+  int v[3];
+  int neighbor[3];
+  Vector3<S> normal;
+  S offset;
+
+  /// @brief Points above the face which no other face claimed
+  std::vector<int> outside;
+  int farthest;
+  S farthest_distance;
+
+  bool alive;
+
+  /// @brief Round in which the visibility of the face was last tested, and
+  /// the result of that test
+  int visit;
+  bool visible;
+};
+
+//==============================================================================
+template <typename S>
+QuickHullFace<S> makeQuickHullFace(const Vector3<S>* points, int a, int b, int c)
+{
+  QuickHullFace<S> face;
+  face.v[0] = a;
+  face.v[1] = b;
+  face.v[2] = c;
+  face.neighbor[0] = face.neighbor[1] = face.neighbor[2] = -1;
+  face.normal = (points[b] - points[a]).cross(points[c] - points[a]);
+  const S l = face.normal.norm();
+  if(l > 0) face.normal /= l;
+  face.offset = face.normal.dot(points[a]);
+  face.farthest = -1;
+  face.farthest_distance = 0;
+  face.alive = true;
+  face.visit = 0;
+  face.visible = false;
+  return face;
+}
+
+//==============================================================================
+template <typename S>
+bool quickHull(
+    const Vector3<S>* points,
+    int num_points,
+    int max_vertices,
+    std::vector<int>& hull_vertices,
+    std::vector<int>& hull_triangles,
+    S* max_error)
+{
+  hull_vertices.clear();
+  hull_triangles.clear();
+  if(max_error) *max_error = 0;
+
+  if(num_points < 4)
+    return false;
+
+  // Points closer than eps to the plane of a face are considered on the hull
+  S scale = 0;
+  for(int i = 0; i < num_points; ++i)
+    scale = std::max(scale, points[i].cwiseAbs().maxCoeff());
+  const S eps = 32 * std::numeric_limits<S>::epsilon() * std::max(scale, S(1));
+
+  // Initial tetrahedron: the farthest pair among the extreme points along the
+  // axes, the point farthest from their line and the point farthest from the
+  // plane of the three.
+  int extremes[6] = {0, 0, 0, 0, 0, 0};
+  for(int i = 1; i < num_points; ++i)
+  {
+    for(int j = 0; j < 3; ++j)
+    {
+      if(points[i][j] < points[extremes[2 * j]][j]) extremes[2 * j] = i;
+      if(points[i][j] > points[extremes[2 * j + 1]][j]) extremes[2 * j + 1] = i;
+    }
+  }
+
+  int i0 = 0, i1 = 0;
+  S best = -1;
+  for(int j = 0; j < 6; ++j)
+  {
+    for(int k = j + 1; k < 6; ++k)
+    {
+      const S d = (points[extremes[j]] - points[extremes[k]]).squaredNorm();
+      if(d > best)
+      {
+        best = d;
+        i0 = extremes[j];
+        i1 = extremes[k];
+      }
+    }
+  }
+  if(best <= eps * eps)
+    return false;
+
+  const Vector3<S> line = (points[i1] - points[i0]).normalized();
+  int i2 = -1;
+  best = eps;
+  for(int i = 0; i < num_points; ++i)
+  {
+    const S d = (points[i] - points[i0]).cross(line).norm();
+    if(d > best)
+    {
+      best = d;
+      i2 = i;
+    }
+  }
+  if(i2 < 0)
+    return false;
+
+  const Vector3<S> plane_normal
+      = (points[i1] - points[i0]).cross(points[i2] - points[i0]).normalized();
+  int i3 = -1;
+  best = eps;
+  for(int i = 0; i < num_points; ++i)
+  {
+    const S d = std::abs(plane_normal.dot(points[i] - points[i0]));
+    if(d > best)
+    {
+      best = d;
+      i3 = i;
+    }
+  }
+  if(i3 < 0)
+    return false;
+
+  std::vector<QuickHullFace<S>> faces;
+  const Vector3<S> centroid
+      = (points[i0] + points[i1] + points[i2] + points[i3]) / 4;
+  const int simplex[4][3] = {{i0, i1, i2}, {i0, i3, i1}, {i1, i3, i2}, {i2, i3, i0}};
+  for(int f = 0; f < 4; ++f)
+  {
+    int a = simplex[f][0], b = simplex[f][1], c = simplex[f][2];
+    if((points[b] - points[a]).cross(points[c] - points[a]).dot(centroid - points[a]) > 0)
+      std::swap(b, c);
+    faces.push_back(makeQuickHullFace(points, a, b, c));
+  }
+
+  for(int f = 0; f < 4; ++f)
+  {
+    for(int i = 0; i < 3; ++i)
+    {
+      const int a = faces[f].v[i];
+      const int b = faces[f].v[(i + 1) % 3];
+      for(int g = 0; g < 4; ++g)
+      {
+        for(int j = 0; j < 3; ++j)
+        {
+          if(faces[g].v[j] == b && faces[g].v[(j + 1) % 3] == a)
+            faces[f].neighbor[i] = g;
+        }
+      }
+    }
+  }
+
+  // Give every point outside of the tetrahedron to the face it is the
+  // farthest above.
+  auto assign = [&](int p, int first_face, int end_face)
+  {
+    int best_face = -1;
+    S best_distance = eps;
+    for(int f = first_face; f < end_face; ++f)
+    {
+      const S d = faces[f].normal.dot(points[p]) - faces[f].offset;
+      if(d > best_distance)
+      {
+        best_distance = d;
+        best_face = f;
+      }
+    }
+
+    if(best_face < 0)
+      return;
+
+    QuickHullFace<S>& face = faces[best_face];
+    face.outside.push_back(p);
+    if(best_distance > face.farthest_distance)
+    {
+      face.farthest_distance = best_distance;
+      face.farthest = p;
+    }
+  };
+
+  for(int p = 0; p < num_points; ++p)
+  {
+    if(p != i0 && p != i1 && p != i2 && p != i3)
+      assign(p, 0, 4);
+  }
+
+  // Faces with outside points, the farthest point first
+  using Entry = std::pair<S, int>;
+  std::priority_queue<Entry> queue;
+  for(int f = 0; f < 4; ++f)
+  {
+    if(!faces[f].outside.empty())
+      queue.emplace(faces[f].farthest_distance, f);
+  }
+
+  int num_added = 4;
+  int round = 0;
+  std::vector<int> visible;
+  std::vector<int> horizon;
+  std::unordered_map<int, int> starting_at;
+  std::unordered_map<int, int> ending_at;
+
+  while(!queue.empty())
+  {
+    const int f = queue.top().second;
+    if(!faces[f].alive)
+    {
+      queue.pop();
+      continue;
+    }
+
+    if(max_vertices >= 4 && num_added >= max_vertices)
+    {
+      if(max_error) *max_error = queue.top().first;
+      break;
+    }
+    queue.pop();
+
+    const int eye = faces[f].farthest;
+    const Vector3<S>& p = points[eye];
+
+    // The faces seen from the eye point, connected to f
+    ++round;
+    visible.clear();
+    visible.push_back(f);
+    faces[f].visit = round;
+    faces[f].visible = true;
+    for(std::size_t k = 0; k < visible.size(); ++k)
+    {
+      const QuickHullFace<S>& face = faces[visible[k]];
+      for(int i = 0; i < 3; ++i)
+      {
+        QuickHullFace<S>& next = faces[face.neighbor[i]];
+        if(next.visit == round)
+          continue;
+        next.visit = round;
+        next.visible = (next.normal.dot(p) - next.offset > eps);
+        if(next.visible)
+          visible.push_back(face.neighbor[i]);
+      }
+    }
+
+    // Cone from the eye point to the horizon, which is made of the edges of
+    // the visible faces across which the neighbor is not visible
+    const int first_new = static_cast<int>(faces.size());
+    starting_at.clear();
+    ending_at.clear();
+    for(int vf : visible)
+    {
+      for(int i = 0; i < 3; ++i)
+      {
+        const int n = faces[vf].neighbor[i];
+        if(faces[n].visit == round && faces[n].visible)
+          continue;
+
+        const int a = faces[vf].v[i];
+        const int b = faces[vf].v[(i + 1) % 3];
+        const int g = static_cast<int>(faces.size());
+        faces.push_back(makeQuickHullFace(points, a, b, eye));
+        faces[g].neighbor[0] = n;
+        for(int j = 0; j < 3; ++j)
+        {
+          if(faces[n].v[j] == b && faces[n].v[(j + 1) % 3] == a)
+            faces[n].neighbor[j] = g;
+        }
+
+        starting_at[a] = g;
+        ending_at[b] = g;
+      }
+    }
+
+    const int end_new = static_cast<int>(faces.size());
+    for(int g = first_new; g < end_new; ++g)
+    {
+      const auto next = starting_at.find(faces[g].v[1]);
+      const auto prev = ending_at.find(faces[g].v[0]);
+      if(next == starting_at.end() || prev == ending_at.end())
+      {
+        std::cerr << "Error! quickHull met a horizon which is not a simple loop.\n";
+        return false;
+      }
+      faces[g].neighbor[1] = next->second;
+      faces[g].neighbor[2] = prev->second;
+    }
+
+    // The points outside of the removed faces are either inside the new hull
+    // or above one of the new faces
+    for(int vf : visible)
+    {
+      QuickHullFace<S>& face = faces[vf];
+      face.alive = false;
+      for(int q : face.outside)
+      {
+        if(q != eye)
+          assign(q, first_new, end_new);
+      }
+      std::vector<int>().swap(faces[vf].outside);
+    }
+
+    for(int g = first_new; g < end_new; ++g)
+    {
+      if(!faces[g].outside.empty())
+        queue.emplace(faces[g].farthest_distance, g);
+    }
+
+    ++num_added;
+  }
+
+  std::vector<char> on_hull(num_points, 0);
+  for(const auto& face : faces)
+  {
+    if(!face.alive)
+      continue;
+    for(int i = 0; i < 3; ++i)
+    {
+      hull_triangles.push_back(face.v[i]);
+      on_hull[face.v[i]] = 1;
+    }
+  }
+
+  for(int i = 0; i < num_points; ++i)
+  {
+    if(on_hull[i])
+      hull_vertices.push_back(i);
+  }
+
+  return true;
+}
+
+} // namespace detail
+
+//==============================================================================
+template <typename S>
+std::shared_ptr<Convex<S>> convexHull(
+    const std::vector<Vector3<S>>& points,
+    int max_vertices,
+    int num_threads,
+    S* max_error)
+{
+  const int num_points = static_cast<int>(points.size());
+
+  std::vector<int> hull_vertices;
+  std::vector<int> hull_triangles;
+  bool success = false;
+
+  if(num_threads > 1 && num_points / num_threads >= 256)
+  {
+    // Only the vertices of the hulls of the chunks can be on the final hull
+    std::vector<std::vector<int>> chunk_vertices(num_threads);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < num_threads; ++t)
+    {
+      threads.emplace_back([&points, &chunk_vertices, num_points, num_threads, t]()
+      {
+        const int begin = static_cast<int>(static_cast<long long>(num_points) * t / num_threads);
+        const int end = static_cast<int>(static_cast<long long>(num_points) * (t + 1) / num_threads);
+        std::vector<int> triangles;
+        std::vector<int>& vertices = chunk_vertices[t];
+        if(!detail::quickHull(points.data() + begin, end - begin, 0, vertices, triangles))
+        {
+          vertices.resize(end - begin);
+          for(int i = 0; i < end - begin; ++i) vertices[i] = i;
+        }
+        for(int& v : vertices) v += begin;
+      });
+    }
+    for(auto& thread : threads)
+      thread.join();
+
+    std::vector<int> candidates;
+    for(const auto& vertices : chunk_vertices)
+      candidates.insert(candidates.end(), vertices.begin(), vertices.end());
+
+    std::vector<Vector3<S>> candidate_points(candidates.size());
+    for(std::size_t i = 0; i < candidates.size(); ++i)
+      candidate_points[i] = points[candidates[i]];
+
+    success = detail::quickHull(candidate_points.data(),
+                                static_cast<int>(candidate_points.size()),
+                                max_vertices, hull_vertices, hull_triangles,
+                                max_error);
+    for(int& v : hull_vertices) v = candidates[v];
+    for(int& v : hull_triangles) v = candidates[v];
+  }
+  else
+  {
+    success = detail::quickHull(points.data(), num_points, max_vertices,
+                                hull_vertices, hull_triangles, max_error);
+  }
+
+  if(!success)
+  {
+    std::cerr << "Error! convexHull requires points which span a volume.\n";
+    return nullptr;
+  }
+
+  std::vector<int> index_map(points.size(), -1);
+  auto vertices = std::make_shared<std::vector<Vector3<S>>>();
+  vertices->reserve(hull_vertices.size());
+  for(int v : hull_vertices)
+  {
+    index_map[v] = static_cast<int>(vertices->size());
+    vertices->push_back(points[v]);
+  }
+
+  const int num_faces = static_cast<int>(hull_triangles.size() / 3);
+  auto faces = std::make_shared<std::vector<int>>();
+  faces->reserve(4 * num_faces);
+  for(int f = 0; f < num_faces; ++f)
+  {
+    faces->push_back(3);
+    for(int i = 0; i < 3; ++i)
+      faces->push_back(index_map[hull_triangles[3 * f + i]]);
+  }
+
+  return std::make_shared<Convex<S>>(vertices, num_faces, faces);
+}
+
+//==============================================================================
+template <typename BV>
+std::shared_ptr<Convex<typename BV::S>> convexHull(
+    const BVHModel<BV>& model,
+    int max_vertices,
+    int num_threads,
+    typename BV::S* max_error)
+{
+  using S = typename BV::S;
+
+  if(!model.vertices || model.num_vertices < 4)
+  {
+    std::cerr << "Error! convexHull requires a model with at least 4 vertices.\n";
+    return nullptr;
+  }
+
+  const std::vector<Vector3<S>> points(model.vertices,
+                                       model.vertices + model.num_vertices);
+  return convexHull(points, max_vertices, num_threads, max_error);
+}
+
+} // namespace fcl
+
+#endif
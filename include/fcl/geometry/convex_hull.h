@@ -0,0 +1,104 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_GEOMETRY_CONVEX_HULL_H
+#define FCL_GEOMETRY_CONVEX_HULL_H
+
+#include <memory>
+#include <vector>
+
+#include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/geometry/shape/convex.h"
+
+namespace fcl
+{
+
+/// @brief Compute the convex hull of a point set with quickhull and return it
+/// as a Convex whose faces are triangles, oriented counter-clockwise when
+/// viewed from outside.
+///
+/// If max_vertices is at least 4, the hull is simplified to at most
+/// max_vertices vertices: quickhull always adds the point farthest outside of
+/// the current hull, and stops once the vertex budget is spent. The
+/// simplified hull is contained in the exact one, and the farthest point left
+/// outside of it is returned in max_error if not null (0 for an exact hull).
+///
+/// With num_threads > 1, the points are split into num_threads chunks whose
+/// hulls are computed concurrently, and the final hull is computed from the
+/// vertices of the chunk hulls.
+///
+/// Returns nullptr (and prints an error) if the points do not span a volume.
+template <typename S>
+FCL_EXPORT
+std::shared_ptr<Convex<S>> convexHull(
+    const std::vector<Vector3<S>>& points,
+    int max_vertices = 0,
+    int num_threads = 1,
+    S* max_error = nullptr);
+
+/// @brief Compute the convex hull of the vertices of a BVHModel (triangle
+/// model or point cloud), in the frame of the model. See convexHull() for the
+/// parameters.
+template <typename BV>
+FCL_EXPORT
+std::shared_ptr<Convex<typename BV::S>> convexHull(
+    const BVHModel<BV>& model,
+    int max_vertices = 0,
+    int num_threads = 1,
+    typename BV::S* max_error = nullptr);
+
+namespace detail
+{
+
+/// @brief Quickhull on num_points points. On success, hull_vertices holds the
+/// indices of the points on the hull and hull_triangles three indices (into
+/// points) per triangle. See convexHull() for max_vertices and max_error.
+template <typename S>
+FCL_EXPORT
+bool quickHull(
+    const Vector3<S>* points,
+    int num_points,
+    int max_vertices,
+    std::vector<int>& hull_vertices,
+    std::vector<int>& hull_triangles,
+    S* max_error = nullptr);
+
+} // namespace detail
+
+} // namespace fcl
+
+#include "fcl/geometry/convex_hull-inl.h"
+
+#endif
@@ -39,6 +39,7 @@
 #ifndef FCL_SHAPE_CONVEX_INL_H
 #define FCL_SHAPE_CONVEX_INL_H
 
+#include <algorithm>
 #include <iomanip>
 #include <map>
 #include <set>
@@ -264,18 +265,32 @@ std::vector<Vector3<S>> Convex<S>::getBoundVertices(
 //==============================================================================
 template <typename S>
 const Vector3<S>& Convex<S>::findExtremeVertex(const Vector3<S>& v_C) const {
-  // TODO(SeanCurtis-TRI): Create an override of this that seeds the search with
-  //  the last extremal vertex index (assuming some kind of coherency in the
-  //  evaluation sequence).
+  return (*vertices_)[findExtremeVertexIndex(v_C)];
+}
+
+//==============================================================================
+template <typename S>
+int Convex<S>::findExtremeVertexIndex(const Vector3<S>& v_C,
+                                      int start_index) const {
   const std::vector<Vector3<S>>& vertices = *vertices_;
-  // Note: A small amount of empirical testing suggests that a vector of int8_t
-  // yields a slight performance improvement over int and bool. This is *not*
-  // definitive.
-  std::vector<int8_t> visited(vertices.size(), 0);
-  int extreme_index = 0;
+  const int num_vertices = static_cast<int>(vertices.size());
+  int extreme_index =
+      (start_index >= 0 && start_index < num_vertices) ? start_index : 0;
   S extreme_value = v_C.dot(vertices[extreme_index]);
 
   if (find_extreme_via_neighbors_) {
+    // A vertex is visited in this query iff its stamp equals the epoch of the
+    // query, so the marks never need to be cleared. The stamps are per thread
+    // because a Convex is shared between concurrent queries.
+    thread_local std::vector<unsigned int> visited;
+    thread_local unsigned int epoch = 0;
+    if (static_cast<int>(visited.size()) < num_vertices)
+      visited.resize(num_vertices, 0);
+    if (++epoch == 0) {
+      std::fill(visited.begin(), visited.end(), 0);
+      epoch = 1;
+    }
+
     bool keep_searching = true;
     while (keep_searching) {
       keep_searching = false;
@@ -284,8 +299,8 @@ const Vector3<S>& Convex<S>::findExtremeVertex(const Vector3<S>& v_C) const {
       for (int n_index = neighbor_start + 1;
            n_index <= neighbor_start + neighbor_count; ++n_index) {
         const int neighbor_index = neighbors_[n_index];
-        if (visited[neighbor_index]) continue;
-        visited[neighbor_index] = 1;
+        if (visited[neighbor_index] == epoch) continue;
+        visited[neighbor_index] = epoch;
         const S neighbor_value = v_C.dot(vertices[neighbor_index]);
         // N.B. Testing >= (instead of >) protects us from the (very rare) case
         // where the *starting* vertex is co-planar with all of its neighbors
@@ -302,7 +317,9 @@ const Vector3<S>& Convex<S>::findExtremeVertex(const Vector3<S>& v_C) const {
     }
   } else {
     // Simple linear search.
-    for (int i = 1; i < static_cast<int>(vertices.size()); ++i) {
+    extreme_index = 0;
+    extreme_value = v_C.dot(vertices[0]);
+    for (int i = 1; i < num_vertices; ++i) {
       S value = v_C.dot(vertices[i]);
       if (value > extreme_value) {
         extreme_index = i;
@@ -310,7 +327,7 @@ const Vector3<S>& Convex<S>::findExtremeVertex(const Vector3<S>& v_C) const {
       }
     }
   }
-  return vertices[extreme_index];
+  return extreme_index;
 }
 
 //==============================================================================
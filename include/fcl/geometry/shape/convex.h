@@ -176,6 +176,14 @@ public:
   ///         in the  %Convex polytope's set of vertices.
   const Vector3<S>& findExtremeVertex(const Vector3<S>& v_C) const;
 
+  /// @brief Reports the index of a vertex in this convex polytope that lies
+  /// farthest in the given direction v_C, with the same guarantee as
+  /// findExtremeVertex(). When the mesh allows walking along its edges, the
+  /// walk starts from vertex `start_index`; passing the result of a previous
+  /// query for a nearby direction makes the walk short. The query does not
+  /// allocate memory once the calling thread has seen a mesh of this size.
+  int findExtremeVertexIndex(const Vector3<S>& v_C, int start_index = 0) const;
+
   /// @brief Create a string that should be sufficient to recreate this shape.
   /// This is akin to the repr() implementation in python.
   /// @param precision The requested digits of precision for the numerical
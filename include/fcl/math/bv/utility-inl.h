@@ -963,6 +963,81 @@ class FCL_EXPORT ConvertBVImpl<double, OBBRSS<double>, RSS<double>>;
 extern template
 class FCL_EXPORT ConvertBVImpl<double, AABB<double>, RSS<double>>;
 
+//==============================================================================
+/// @brief Convert a bounding volume to the same kind of bounding volume with
+/// another scalar type, enlarged by pad.
+template <typename BV1, typename BV2>
+class FCL_EXPORT CastBVImpl
+{
+private:
+  static void run(const BV1& bv1, typename BV2::S pad, BV2& bv2)
+  {
+    FCL_UNUSED(bv1);
+    FCL_UNUSED(pad);
+    FCL_UNUSED(bv2);
+
+    // should only use the specialized version, so it is private.
+  }
+};
+
+//==============================================================================
+template <typename S1, typename S2>
+class FCL_EXPORT CastBVImpl<OBB<S1>, OBB<S2>>
+{
+public:
+  static void run(const OBB<S1>& bv1, S2 pad, OBB<S2>& bv2)
+  {
+    bv2.axis = bv1.axis.template cast<S2>();
+    bv2.To = bv1.To.template cast<S2>();
+    bv2.extent = bv1.extent.template cast<S2>();
+    bv2.extent.array() += pad;
+  }
+};
+
+//==============================================================================
+template <typename S1, typename S2>
+class FCL_EXPORT CastBVImpl<RSS<S1>, RSS<S2>>
+{
+public:
+  static void run(const RSS<S1>& bv1, S2 pad, RSS<S2>& bv2)
+  {
+    bv2.axis = bv1.axis.template cast<S2>();
+    bv2.To = bv1.To.template cast<S2>();
+    bv2.l[0] = static_cast<S2>(bv1.l[0]);
+    bv2.l[1] = static_cast<S2>(bv1.l[1]);
+    bv2.r = static_cast<S2>(bv1.r) + pad;
+  }
+};
+
+//==============================================================================
+template <typename S1, typename S2>
+class FCL_EXPORT CastBVImpl<OBBRSS<S1>, OBBRSS<S2>>
+{
+public:
+  static void run(const OBBRSS<S1>& bv1, S2 pad, OBBRSS<S2>& bv2)
+  {
+    CastBVImpl<OBB<S1>, OBB<S2>>::run(bv1.obb, pad, bv2.obb);
+    CastBVImpl<RSS<S1>, RSS<S2>>::run(bv1.rss, pad, bv2.rss);
+  }
+};
+
+//==============================================================================
+template <typename S1, typename S2>
+class FCL_EXPORT CastBVImpl<kIOS<S1>, kIOS<S2>>
+{
+public:
+  static void run(const kIOS<S1>& bv1, S2 pad, kIOS<S2>& bv2)
+  {
+    bv2.num_spheres = bv1.num_spheres;
+    for(unsigned int i = 0; i < bv1.num_spheres; ++i)
+    {
+      bv2.spheres[i].o = bv1.spheres[i].o.template cast<S2>();
+      bv2.spheres[i].r = static_cast<S2>(bv1.spheres[i].r) + pad;
+    }
+    CastBVImpl<OBB<S1>, OBB<S2>>::run(bv1.obb, pad, bv2.obb);
+  }
+};
+
 //==============================================================================
 } // namespace detail
 //==============================================================================
@@ -979,6 +1054,14 @@ void convertBV(
   detail::ConvertBVImpl<typename BV1::S, BV1, BV2>::run(bv1, tf1, bv2);
 }
 
+//==============================================================================
+template <typename BV1, typename BV2>
+FCL_EXPORT
+void castBV(const BV1& bv1, typename BV2::S pad, BV2& bv2)
+{
+  detail::CastBVImpl<BV1, BV2>::run(bv1, pad, bv2);
+}
+
 } // namespace fcl
 
 #endif
@@ -56,6 +56,14 @@ FCL_EXPORT
 void convertBV(
     const BV1& bv1, const Transform3<typename BV1::S>& tf1, BV2& bv2);
 
+/// @brief Convert a bounding volume to the same kind of bounding volume with
+/// another scalar type. The result is enlarged by pad, which must cover the
+/// rounding of the conversion, so that it still contains bv1. Supported for
+/// OBB, RSS, OBBRSS and kIOS.
+template <typename BV1, typename BV2>
+FCL_EXPORT
+void castBV(const BV1& bv1, typename BV2::S pad, BV2& bv2);
+
 } // namespace fcl
 
 #include "fcl/math/bv/utility-inl.h"
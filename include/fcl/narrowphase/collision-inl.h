@@ -43,6 +43,7 @@
 #include "fcl/narrowphase/detail/collision_func_matrix.h"
 #include "fcl/narrowphase/detail/gjk_solver_indep.h"
 #include "fcl/narrowphase/detail/gjk_solver_libccd.h"
+#include "fcl/narrowphase/gjk_solver_dispatch.h"
 
 namespace fcl
 {
@@ -154,7 +155,8 @@ FCL_EXPORT
 std::size_t collide(const CollisionObject<S>* o1, const CollisionObject<S>* o2,
                     const CollisionRequest<S>& request, CollisionResult<S>& result)
 {
-  switch(request.gjk_solver_type)
+  switch(resolveGJKSolverType(request.gjk_solver_type,
+                              o1->getNodeType(), o2->getNodeType()))
   {
   case GST_LIBCCD:
     {
@@ -185,7 +187,8 @@ std::size_t collide(
     const CollisionRequest<S>& request,
     CollisionResult<S>& result)
 {
-  switch(request.gjk_solver_type)
+  switch(resolveGJKSolverType(request.gjk_solver_type,
+                              o1->getNodeType(), o2->getNodeType()))
   {
   case GST_LIBCCD:
     {
@@ -0,0 +1,156 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_CONTACT_MANIFOLD_INL_H
+#define FCL_NARROWPHASE_CONTACT_MANIFOLD_INL_H
+
+#include "fcl/narrowphase/contact_manifold.h"
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+class ContactManifold<double>;
+
+//==============================================================================
+template <typename S>
+ContactManifold<S>::ContactManifold(S linear_tolerance_, S angular_tolerance_)
+  : linear_tolerance(linear_tolerance_),
+    angular_tolerance(angular_tolerance_),
+    valid(false),
+    colliding(false),
+    has_contacts(false),
+    feature_id(0),
+    relative_pose(Transform3<S>::Identity())
+{
+  // Do nothing
+}
+
+//==============================================================================
+template <typename S>
+void ContactManifold<S>::clear()
+{
+  valid = false;
+  colliding = false;
+  has_contacts = false;
+  feature_id = 0;
+  local_contacts.clear();
+}
+
+//==============================================================================
+template <typename S>
+bool ContactManifold<S>::isValid() const
+{
+  return valid;
+}
+
+//==============================================================================
+template <typename S>
+bool ContactManifold<S>::isColliding() const
+{
+  return colliding;
+}
+
+//==============================================================================
+template <typename S>
+int ContactManifold<S>::getFeatureId() const
+{
+  return feature_id;
+}
+
+//==============================================================================
+template <typename S>
+std::size_t ContactManifold<S>::numContacts() const
+{
+  return local_contacts.size();
+}
+
+//==============================================================================
+template <typename S>
+bool ContactManifold<S>::revalidate(
+    const Transform3<S>& tf1, const Transform3<S>& tf2,
+    std::vector<ContactPoint<S>>* contacts) const
+{
+  if(!valid || !colliding || (contacts && !has_contacts))
+    return false;
+
+  const Transform3<S> pose = tf1.inverse(Eigen::Isometry) * tf2;
+  if((pose.translation() - relative_pose.translation()).squaredNorm()
+     > linear_tolerance * linear_tolerance)
+    return false;
+
+  // ||R - R_cached|| is 2 sqrt(2) sin(angle / 2) for the Frobenius norm
+  if((pose.linear() - relative_pose.linear()).squaredNorm()
+     > 2 * angular_tolerance * angular_tolerance)
+    return false;
+
+  if(contacts)
+  {
+    for(const auto& local : local_contacts)
+      contacts->emplace_back(tf1.linear() * local.normal, tf1 * local.pos,
+                             local.penetration_depth);
+  }
+
+  return true;
+}
+
+//==============================================================================
+template <typename S>
+void ContactManifold<S>::update(
+    const Transform3<S>& tf1, const Transform3<S>& tf2,
+    bool colliding_, const std::vector<ContactPoint<S>>* contacts,
+    int feature_id_)
+{
+  valid = true;
+  colliding = colliding_;
+  has_contacts = (contacts != nullptr);
+  feature_id = feature_id_;
+  relative_pose = tf1.inverse(Eigen::Isometry) * tf2;
+
+  local_contacts.clear();
+  if(colliding && contacts)
+  {
+    const Transform3<S> inv1 = tf1.inverse(Eigen::Isometry);
+    for(const auto& contact : *contacts)
+      local_contacts.emplace_back(inv1.linear() * contact.normal,
+                                  inv1 * contact.pos,
+                                  contact.penetration_depth);
+  }
+}
+
+} // namespace fcl
+
+#endif
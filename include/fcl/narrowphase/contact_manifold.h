@@ -0,0 +1,131 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_CONTACT_MANIFOLD_H
+#define FCL_NARROWPHASE_CONTACT_MANIFOLD_H
+
+#include <vector>
+
+#include "fcl/math/constants.h"
+#include "fcl/narrowphase/contact_point.h"
+
+namespace fcl
+{
+
+/// @brief State of a shape pair kept by the caller from one query to the
+/// next, so that a pair that did not move relative to itself is answered
+/// without running the narrowphase again.
+///
+/// The contacts of the last colliding query are kept in the frame of the
+/// first shape. When the relative pose of the two shapes is within the
+/// tolerances of the cached one, revalidate() moves them rigidly with the
+/// first shape. Separated pairs are always tested again, but the solver may
+/// test the feature recorded at the last update first (for box pairs, the
+/// separating axis).
+template <typename S>
+class FCL_EXPORT ContactManifold
+{
+public:
+
+  /// @brief Empty manifold. The tolerances bound the change of translation
+  /// and of rotation angle of the relative pose under which cached contacts
+  /// are reused.
+  ContactManifold(S linear_tolerance = constants<S>::eps_34(),
+                  S angular_tolerance = constants<S>::eps_34());
+
+  /// @brief Forget the cached state
+  void clear();
+
+  /// @brief Whether the manifold holds the result of a previous query
+  bool isValid() const;
+
+  /// @brief Whether the shapes were colliding at the last update
+  bool isColliding() const;
+
+  /// @brief Solver specific id of the last update. For box pairs, the axis
+  /// code of boxBox2() (1 to 15), of the contact normal for colliding pairs
+  /// or of the separating axis for separated ones. 0 if unknown.
+  int getFeatureId() const;
+
+  /// @brief Number of cached contacts
+  std::size_t numContacts() const;
+
+  /// @brief If the pair was colliding and the relative pose of tf1 and tf2 is
+  /// within tolerance of the cached one, append the cached contacts, moved
+  /// with tf1, to contacts (if not null) and return true. Returns false if
+  /// contacts are requested but were not cached at the last update.
+  bool revalidate(const Transform3<S>& tf1, const Transform3<S>& tf2,
+                  std::vector<ContactPoint<S>>* contacts) const;
+
+  /// @brief Record the result of a query. contacts is in the world frame and
+  /// may be null, in which case only the collision status is cached.
+  void update(const Transform3<S>& tf1, const Transform3<S>& tf2,
+              bool colliding, const std::vector<ContactPoint<S>>* contacts,
+              int feature_id = 0);
+
+  /// @brief Upper bound of the translation of the relative pose
+  S linear_tolerance;
+
+  /// @brief Upper bound of the rotation angle of the relative pose
+  S angular_tolerance;
+
+private:
+
+  bool valid;
+
+  bool colliding;
+
+  bool has_contacts;
+
+  int feature_id;
+
+  /// @brief Pose of the second shape in the frame of the first one
+  Transform3<S> relative_pose;
+
+  /// @brief Contacts in the frame of the first shape
+  std::vector<ContactPoint<S>> local_contacts;
+
+public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+using ContactManifoldf = ContactManifold<float>;
+using ContactManifoldd = ContactManifold<double>;
+
+} // namespace fcl
+
+#include "fcl/narrowphase/contact_manifold-inl.h"
+
+#endif
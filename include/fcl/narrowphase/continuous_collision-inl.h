@@ -49,6 +49,7 @@
 
 #include "fcl/narrowphase/collision.h"
 #include "fcl/narrowphase/collision_result.h"
+#include "fcl/narrowphase/gjk_solver_dispatch.h"
 #include "fcl/narrowphase/detail/traversal/collision_node.h"
 
 namespace fcl
@@ -364,7 +365,8 @@ S continuousCollideConservativeAdvancement(
     const ContinuousCollisionRequest<S>& request,
     ContinuousCollisionResult<S>& result)
 {
-  switch(request.gjk_solver_type)
+  switch(resolveGJKSolverType(request.gjk_solver_type,
+                              o1->getNodeType(), o2->getNodeType()))
   {
   case GST_LIBCCD:
     {
@@ -46,6 +46,8 @@
 
 #include "fcl/narrowphase/collision_object.h"
 
+#include "fcl/geometry/compound.h"
+
 #include "fcl/geometry/shape/box.h"
 #include "fcl/geometry/shape/capsule.h"
 #include "fcl/geometry/shape/cone.h"
@@ -659,6 +661,130 @@ std::size_t BVHCollide(
   return BVHCollide<BV>(o1, tf1, o2, tf2, request, result);
 }
 
+//==============================================================================
+template <typename NarrowPhaseSolver>
+void compoundChildCollide(
+    const Compound<typename NarrowPhaseSolver::S>* compound,
+    int child,
+    const Transform3<typename NarrowPhaseSolver::S>& tf,
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* other,
+    const Transform3<typename NarrowPhaseSolver::S>& other_tf,
+    bool compound_first,
+    const NarrowPhaseSolver* nsolver,
+    const CollisionRequest<typename NarrowPhaseSolver::S>& request,
+    CollisionResult<typename NarrowPhaseSolver::S>& result)
+{
+  using S = typename NarrowPhaseSolver::S;
+
+  const CollisionGeometry<S>* geometry = compound->getChild(child).get();
+  const Transform3<S> child_tf = tf * compound->getChildTransform(child);
+  const CollisionGeometry<S>* first = compound_first ? geometry : other;
+  const CollisionGeometry<S>* second = compound_first ? other : geometry;
+
+  // collide() gives a shape and a BVH to the entry of the BVH, in which case
+  // the child is the other object of the contacts
+  const bool swapped = first->getObjectType() == OT_GEOM
+      && second->getObjectType() == OT_BVH;
+  const bool child_is_o1 = (compound_first != swapped);
+
+  CollisionRequest<S> child_request(request);
+  if(result.numContacts() < request.num_max_contacts)
+    child_request.num_max_contacts = request.num_max_contacts - result.numContacts();
+  else
+    child_request.num_max_contacts = 1;
+
+  CollisionResult<S> child_result;
+  if(compound_first)
+    fcl::collide(geometry, child_tf, other, other_tf, nsolver, child_request, child_result);
+  else
+    fcl::collide(other, other_tf, geometry, child_tf, nsolver, child_request, child_result);
+
+  for(std::size_t i = 0; i < child_result.numContacts(); ++i)
+  {
+    if(result.numContacts() >= request.num_max_contacts)
+      break;
+
+    Contact<S> contact = child_result.getContact(i);
+    if(child_is_o1)
+    {
+      contact.o1 = compound;
+      contact.b1 = child;
+    }
+    else
+    {
+      contact.o2 = compound;
+      contact.b2 = child;
+    }
+    result.addContact(contact);
+  }
+
+  if(request.enable_cost)
+  {
+    std::vector<CostSource<S>> cost_sources;
+    child_result.getCostSources(cost_sources);
+    for(const auto& cost_source : cost_sources)
+      result.addCostSource(cost_source, request.num_max_cost_sources);
+  }
+}
+
+//==============================================================================
+template <typename NarrowPhaseSolver>
+std::size_t CompoundCollide(
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o1,
+    const Transform3<typename NarrowPhaseSolver::S>& tf1,
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o2,
+    const Transform3<typename NarrowPhaseSolver::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const CollisionRequest<typename NarrowPhaseSolver::S>& request,
+    CollisionResult<typename NarrowPhaseSolver::S>& result)
+{
+  using S = typename NarrowPhaseSolver::S;
+
+  if(request.isSatisfied(result)) return result.numContacts();
+
+  const Compound<S>* compound = static_cast<const Compound<S>*>(o1);
+
+  std::vector<int> children;
+  compound->queryChildren(*o2, tf1.inverse() * tf2, children);
+  for(int child : children)
+  {
+    compoundChildCollide(compound, child, tf1, o2, tf2, true, nsolver, request, result);
+    if(request.isSatisfied(result))
+      break;
+  }
+
+  return result.numContacts();
+}
+
+//==============================================================================
+template <typename NarrowPhaseSolver>
+std::size_t CollideCompound(
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o1,
+    const Transform3<typename NarrowPhaseSolver::S>& tf1,
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o2,
+    const Transform3<typename NarrowPhaseSolver::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const CollisionRequest<typename NarrowPhaseSolver::S>& request,
+    CollisionResult<typename NarrowPhaseSolver::S>& result)
+{
+  using S = typename NarrowPhaseSolver::S;
+
+  if(request.isSatisfied(result)) return result.numContacts();
+
+  const Compound<S>* compound = static_cast<const Compound<S>*>(o2);
+
+  std::vector<int> children;
+  compound->queryChildren(*o1, tf2.inverse() * tf1, children);
+  for(int child : children)
+  {
+    compoundChildCollide(compound, child, tf2, o1, tf1, false, nsolver, request, result);
+    if(request.isSatisfied(result))
+      break;
+  }
+
+  return result.numContacts();
+}
+
 //==============================================================================
 template <typename NarrowPhaseSolver>
 CollisionFunctionMatrix<NarrowPhaseSolver>::CollisionFunctionMatrix()
@@ -891,6 +1017,12 @@ CollisionFunctionMatrix<NarrowPhaseSolver>::CollisionFunctionMatrix()
   collision_matrix[BV_KDOP18][GEOM_OCTREE] = &BVHOcTreeCollide<KDOP<S, 18>, NarrowPhaseSolver>;
   collision_matrix[BV_KDOP24][GEOM_OCTREE] = &BVHOcTreeCollide<KDOP<S, 24>, NarrowPhaseSolver>;
 #endif
+
+  for(int i = 0; i < NODE_COUNT; ++i)
+  {
+    collision_matrix[i][GEOM_COMPOUND] = &CollideCompound<NarrowPhaseSolver>;
+    collision_matrix[GEOM_COMPOUND][i] = &CompoundCollide<NarrowPhaseSolver>;
+  }
 }
 
 } // namespace detail
@@ -81,6 +81,21 @@ struct CollisionFunctionMatrix
 };
 
 } // namespace detail
+
+/// @brief Collision of two geometries with a given solver, defined in
+/// collision-inl.h. Declared here because the children of a compound are
+/// dispatched through the collision matrix again.
+template <typename S, typename NarrowPhaseSolver>
+FCL_EXPORT
+std::size_t collide(
+    const CollisionGeometry<S>* o1,
+    const Transform3<S>& tf1,
+    const CollisionGeometry<S>* o2,
+    const Transform3<S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const CollisionRequest<S>& request,
+    CollisionResult<S>& result);
+
 } // namespace fcl
 
 #include "fcl/narrowphase/detail/collision_func_matrix-inl.h"
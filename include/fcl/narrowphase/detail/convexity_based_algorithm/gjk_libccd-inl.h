@@ -38,12 +38,15 @@
 #ifndef FCL_NARROWPHASE_DETAIL_GJKLIBCCD_INL_H
 #define FCL_NARROWPHASE_DETAIL_GJKLIBCCD_INL_H
 
+#include <algorithm>
 #include <array>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "fcl/common/unused.h"
 #include "fcl/common/warning.h"
@@ -178,6 +181,10 @@ template <typename S>
 struct ccd_convex_t : public ccd_obj_t
 {
   const Convex<S>* convex;
+
+  /// The extreme vertex of the last support query, where the next one starts
+  /// walking. libccd only passes the object as const.
+  mutable int extreme_index;
 };
 
 struct ccd_triangle_t : public ccd_obj_t
@@ -663,11 +670,298 @@ static int doSimplex(ccd_simplex_t *simplex, ccd_vec3_t *dir)
   }
 }
 
+/** The update of the nearest element of libccd's polytope when the element el
+ * is added (_ccdPtNearestUpdate() is private to libccd). */
+static void ptNearestUpdate(ccd_pt_t* pt, ccd_pt_el_t* el) {
+  if (ccdEq(pt->nearest_dist, el->dist)) {
+    if (el->type < pt->nearest_type) {
+      pt->nearest = el;
+      pt->nearest_dist = el->dist;
+      pt->nearest_type = el->type;
+    }
+  } else if (el->dist < pt->nearest_dist) {
+    pt->nearest = el;
+    pt->nearest_dist = el->dist;
+    pt->nearest_type = el->type;
+  }
+}
+
+/** Storage of the polytope built by EPA, kept from one query to the next.
+ * The vertices, edges and faces are carved out of pools whose memory is only
+ * returned when the storage is destroyed, and every element is pushed on a
+ * binary heap ordered by its distance to the origin, so the nearest element
+ * is found without scanning the whole polytope.
+ *
+ * The polytope functions below take an optional storage; without one they
+ * use the malloc'ed elements and the linear scan of libccd, so a polytope
+ * built with libccd's own functions stays valid for them.
+ */
+class PolytopeStorage {
+ public:
+  PolytopeStorage() = default;
+  PolytopeStorage(const PolytopeStorage&) = delete;
+  PolytopeStorage& operator=(const PolytopeStorage&) = delete;
+
+  /** Allocates an element of type T: ccd_pt_vertex_t, ccd_pt_edge_t or
+   * ccd_pt_face_t. */
+  template <typename T>
+  T* allocate() {
+    return pool<T>().allocate(next_seq_++);
+  }
+
+  /** Returns an element to its pool. Its heap entry becomes stale. */
+  template <typename T>
+  void release(T* element) {
+    pool<T>().release(element);
+  }
+
+  /** Releases all the elements at once, keeping the memory. */
+  void reset() {
+    vertices_.reset();
+    edges_.reset();
+    faces_.reset();
+    heap_.clear();
+  }
+
+  /** Registers a new element in the nearest element heap. */
+  void push(ccd_pt_el_t* el) {
+    heap_.push_back({el->dist, seq(el), el});
+    std::push_heap(heap_.begin(), heap_.end(), HeapEntryGreater());
+  }
+
+  /** Sets pt->nearest to the element that ccdPtNearest() would pick when it
+   * scans the whole polytope. Only the elements whose distance is within a
+   * few ccdEq() tolerances of the minimum can be picked by the scan, so they
+   * are gathered from the heap and scanned in the order of the lists: by
+   * type, then in insertion order. */
+  void renewNearest(ccd_pt_t* pt) {
+    window_.clear();
+    ccd_real_t bound = CCD_REAL_MAX;
+    while (!heap_.empty()) {
+      const HeapEntry top = heap_.front();
+      if (top.dist > bound) break;
+      std::pop_heap(heap_.begin(), heap_.end(), HeapEntryGreater());
+      heap_.pop_back();
+      if (seq(top.el) != top.seq) continue;  // The element was deleted.
+      if (window_.empty()) {
+        bound = top.dist
+                + 16 * CCD_EPS * std::max(ccd_real_t(1), std::abs(top.dist));
+      }
+      window_.push_back(top);
+    }
+    for (const HeapEntry& entry : window_) {
+      heap_.push_back(entry);
+      std::push_heap(heap_.begin(), heap_.end(), HeapEntryGreater());
+    }
+    std::sort(window_.begin(), window_.end(),
+              [](const HeapEntry& a, const HeapEntry& b) {
+                return a.el->type < b.el->type
+                       || (a.el->type == b.el->type && a.seq < b.seq);
+              });
+
+    pt->nearest_dist = CCD_REAL_MAX;
+    pt->nearest_type = 3;
+    pt->nearest = NULL;
+    for (const HeapEntry& entry : window_) ptNearestUpdate(pt, entry.el);
+  }
+
+ private:
+  template <typename T>
+  struct PoolNode {
+    T element;  // First, so that a pointer to the element is one to the node.
+    unsigned long long seq;  // 0 when the node is free.
+    PoolNode* next_free;
+  };
+
+  template <typename T>
+  class Pool {
+   public:
+    T* allocate(unsigned long long seq) {
+      PoolNode<T>* node = free_;
+      if (node) {
+        free_ = node->next_free;
+      } else {
+        if (used_ == kBlockSize) {
+          ++block_;
+          used_ = 0;
+        }
+        if (block_ == blocks_.size())
+          blocks_.emplace_back(new PoolNode<T>[kBlockSize]);
+        node = &blocks_[block_][used_++];
+      }
+      node->seq = seq;
+      return &node->element;
+    }
+
+    void release(T* element) {
+      PoolNode<T>* node = reinterpret_cast<PoolNode<T>*>(element);
+      node->seq = 0;
+      node->next_free = free_;
+      free_ = node;
+    }
+
+    // The heap is cleared with the pools, so no entry refers to the nodes
+    // anymore and their sequence numbers need not be cleared.
+    void reset() {
+      free_ = nullptr;
+      block_ = 0;
+      used_ = 0;
+    }
+
+    static unsigned long long seq(const ccd_pt_el_t* el) {
+      return reinterpret_cast<const PoolNode<T>*>(el)->seq;
+    }
+
+   private:
+    static constexpr std::size_t kBlockSize = 64;
+    std::vector<std::unique_ptr<PoolNode<T>[]>> blocks_;
+    std::size_t block_{0};
+    std::size_t used_{0};
+    PoolNode<T>* free_{nullptr};
+  };
+
+  struct HeapEntry {
+    ccd_real_t dist;
+    unsigned long long seq;
+    ccd_pt_el_t* el;
+  };
+
+  struct HeapEntryGreater {
+    bool operator()(const HeapEntry& a, const HeapEntry& b) const {
+      return a.dist > b.dist || (a.dist == b.dist && a.seq > b.seq);
+    }
+  };
+
+  template <typename T>
+  Pool<T>& pool() {
+    return pool(static_cast<T*>(nullptr));
+  }
+  Pool<ccd_pt_vertex_t>& pool(ccd_pt_vertex_t*) { return vertices_; }
+  Pool<ccd_pt_edge_t>& pool(ccd_pt_edge_t*) { return edges_; }
+  Pool<ccd_pt_face_t>& pool(ccd_pt_face_t*) { return faces_; }
+
+  static unsigned long long seq(const ccd_pt_el_t* el) {
+    switch (el->type) {
+      case CCD_PT_VERTEX: return Pool<ccd_pt_vertex_t>::seq(el);
+      case CCD_PT_EDGE: return Pool<ccd_pt_edge_t>::seq(el);
+      default: return Pool<ccd_pt_face_t>::seq(el);
+    }
+  }
+
+  Pool<ccd_pt_vertex_t> vertices_;
+  Pool<ccd_pt_edge_t> edges_;
+  Pool<ccd_pt_face_t> faces_;
+  std::vector<HeapEntry> heap_;
+  std::vector<HeapEntry> window_;
+  unsigned long long next_seq_{1};
+};
+
+/** The polytope operations of libccd (ccdPtAddVertex() etc.), on elements
+ * from the storage when there is one. */
+static ccd_pt_vertex_t* ptAddVertex(ccd_pt_t* pt, const ccd_support_t* v,
+                                    PolytopeStorage* storage) {
+  if (!storage) return ccdPtAddVertex(pt, v);
+
+  ccd_pt_vertex_t* vert = storage->allocate<ccd_pt_vertex_t>();
+  vert->type = CCD_PT_VERTEX;
+  ccdSupportCopy(&vert->v, v);
+  vert->dist = ccdVec3Len2(&vert->v.v);
+  ccdVec3Copy(&vert->witness, &vert->v.v);
+  ccdListInit(&vert->edges);
+  ccdListAppend(&pt->vertices, &vert->list);
+  ptNearestUpdate(pt, reinterpret_cast<ccd_pt_el_t*>(vert));
+  storage->push(reinterpret_cast<ccd_pt_el_t*>(vert));
+  return vert;
+}
+
+static ccd_pt_edge_t* ptAddEdge(ccd_pt_t* pt, ccd_pt_vertex_t* v1,
+                                ccd_pt_vertex_t* v2,
+                                PolytopeStorage* storage) {
+  if (!storage) return ccdPtAddEdge(pt, v1, v2);
+  if (v1 == NULL || v2 == NULL) return NULL;
+
+  ccd_pt_edge_t* edge = storage->allocate<ccd_pt_edge_t>();
+  edge->type = CCD_PT_EDGE;
+  edge->vertex[0] = v1;
+  edge->vertex[1] = v2;
+  edge->faces[0] = edge->faces[1] = NULL;
+  edge->dist = ccdVec3PointSegmentDist2(ccd_vec3_origin, &v1->v.v, &v2->v.v,
+                                        &edge->witness);
+  ccdListAppend(&edge->vertex[0]->edges, &edge->vertex_list[0]);
+  ccdListAppend(&edge->vertex[1]->edges, &edge->vertex_list[1]);
+  ccdListAppend(&pt->edges, &edge->list);
+  ptNearestUpdate(pt, reinterpret_cast<ccd_pt_el_t*>(edge));
+  storage->push(reinterpret_cast<ccd_pt_el_t*>(edge));
+  return edge;
+}
+
+static ccd_pt_face_t* ptAddFace(ccd_pt_t* pt, ccd_pt_edge_t* e1,
+                                ccd_pt_edge_t* e2, ccd_pt_edge_t* e3,
+                                PolytopeStorage* storage) {
+  if (!storage) return ccdPtAddFace(pt, e1, e2, e3);
+  if (e1 == NULL || e2 == NULL || e3 == NULL) return NULL;
+
+  ccd_pt_face_t* face = storage->allocate<ccd_pt_face_t>();
+  face->type = CCD_PT_FACE;
+  face->edge[0] = e1;
+  face->edge[1] = e2;
+  face->edge[2] = e3;
+  ccd_vec3_t *a, *b, *c;
+  ccdPtFaceVec3(face, &a, &b, &c);
+  face->dist = ccdVec3PointTriDist2(ccd_vec3_origin, a, b, c, &face->witness);
+  for (int i = 0; i < 3; ++i) {
+    if (face->edge[i]->faces[0] == NULL) {
+      face->edge[i]->faces[0] = face;
+    } else {
+      face->edge[i]->faces[1] = face;
+    }
+  }
+  ccdListAppend(&pt->faces, &face->list);
+  ptNearestUpdate(pt, reinterpret_cast<ccd_pt_el_t*>(face));
+  storage->push(reinterpret_cast<ccd_pt_el_t*>(face));
+  return face;
+}
+
+static int ptDelEdge(ccd_pt_t* pt, ccd_pt_edge_t* e, PolytopeStorage* storage) {
+  if (!storage) return ccdPtDelEdge(pt, e);
+  if (e->faces[0] != NULL) return -1;
+
+  ccdListDel(&e->vertex_list[0]);
+  ccdListDel(&e->vertex_list[1]);
+  ccdListDel(&e->list);
+  if (reinterpret_cast<void*>(pt->nearest) == reinterpret_cast<void*>(e))
+    pt->nearest = NULL;
+  storage->release(e);
+  return 0;
+}
+
+static int ptDelFace(ccd_pt_t* pt, ccd_pt_face_t* f, PolytopeStorage* storage) {
+  if (!storage) return ccdPtDelFace(pt, f);
+
+  for (int i = 0; i < 3; ++i) {
+    ccd_pt_edge_t* e = f->edge[i];
+    if (e->faces[0] == f) e->faces[0] = e->faces[1];
+    e->faces[1] = NULL;
+  }
+  ccdListDel(&f->list);
+  if (reinterpret_cast<void*>(pt->nearest) == reinterpret_cast<void*>(f))
+    pt->nearest = NULL;
+  storage->release(f);
+  return 0;
+}
+
+static ccd_pt_el_t* ptNearest(ccd_pt_t* pt, PolytopeStorage* storage) {
+  if (!storage) return ccdPtNearest(pt);
+  if (!pt->nearest) storage->renewNearest(pt);
+  return pt->nearest;
+}
+
 /** Transforms simplex to polytope, two vertices required */
 static int simplexToPolytope2(const void *obj1, const void *obj2,
                               const ccd_t *ccd,
                               const ccd_simplex_t *simplex,
-                              ccd_pt_t *pt, ccd_pt_el_t **nearest)
+                              ccd_pt_t *pt, ccd_pt_el_t **nearest,
+                              PolytopeStorage* storage = nullptr)
 {
     const ccd_support_t *a, *b;
     ccd_vec3_t ab, ac, dir;
@@ -722,9 +1016,9 @@ static int simplexToPolytope2(const void *obj1, const void *obj2,
 
     goto simplexToPolytope2_not_touching_contact;
 simplexToPolytope2_touching_contact:
-    v[0] = ccdPtAddVertex(pt, a);
-    v[1] = ccdPtAddVertex(pt, b);
-    *nearest = (ccd_pt_el_t *)ccdPtAddEdge(pt, v[0], v[1]);
+    v[0] = ptAddVertex(pt, a, storage);
+    v[1] = ptAddVertex(pt, b, storage);
+    *nearest = (ccd_pt_el_t *)ptAddEdge(pt, v[0], v[1], storage);
     if (*nearest == NULL)
         return -2;
 
@@ -732,37 +1026,37 @@ simplexToPolytope2_touching_contact:
 
 simplexToPolytope2_not_touching_contact:
     // form polyhedron
-    v[0] = ccdPtAddVertex(pt, a);
-    v[1] = ccdPtAddVertex(pt, &supp[0]);
-    v[2] = ccdPtAddVertex(pt, b);
-    v[3] = ccdPtAddVertex(pt, &supp[1]);
-    v[4] = ccdPtAddVertex(pt, &supp[2]);
-    v[5] = ccdPtAddVertex(pt, &supp[3]);
-
-    e[0] = ccdPtAddEdge(pt, v[0], v[1]);
-    e[1] = ccdPtAddEdge(pt, v[1], v[2]);
-    e[2] = ccdPtAddEdge(pt, v[2], v[3]);
-    e[3] = ccdPtAddEdge(pt, v[3], v[0]);
-
-    e[4] = ccdPtAddEdge(pt, v[4], v[0]);
-    e[5] = ccdPtAddEdge(pt, v[4], v[1]);
-    e[6] = ccdPtAddEdge(pt, v[4], v[2]);
-    e[7] = ccdPtAddEdge(pt, v[4], v[3]);
-
-    e[8]  = ccdPtAddEdge(pt, v[5], v[0]);
-    e[9]  = ccdPtAddEdge(pt, v[5], v[1]);
-    e[10] = ccdPtAddEdge(pt, v[5], v[2]);
-    e[11] = ccdPtAddEdge(pt, v[5], v[3]);
-
-    if (ccdPtAddFace(pt, e[4], e[5], e[0]) == NULL
-            || ccdPtAddFace(pt, e[5], e[6], e[1]) == NULL
-            || ccdPtAddFace(pt, e[6], e[7], e[2]) == NULL
-            || ccdPtAddFace(pt, e[7], e[4], e[3]) == NULL
-
-            || ccdPtAddFace(pt, e[8],  e[9],  e[0]) == NULL
-            || ccdPtAddFace(pt, e[9],  e[10], e[1]) == NULL
-            || ccdPtAddFace(pt, e[10], e[11], e[2]) == NULL
-            || ccdPtAddFace(pt, e[11], e[8],  e[3]) == NULL){
+    v[0] = ptAddVertex(pt, a, storage);
+    v[1] = ptAddVertex(pt, &supp[0], storage);
+    v[2] = ptAddVertex(pt, b, storage);
+    v[3] = ptAddVertex(pt, &supp[1], storage);
+    v[4] = ptAddVertex(pt, &supp[2], storage);
+    v[5] = ptAddVertex(pt, &supp[3], storage);
+
+    e[0] = ptAddEdge(pt, v[0], v[1], storage);
+    e[1] = ptAddEdge(pt, v[1], v[2], storage);
+    e[2] = ptAddEdge(pt, v[2], v[3], storage);
+    e[3] = ptAddEdge(pt, v[3], v[0], storage);
+
+    e[4] = ptAddEdge(pt, v[4], v[0], storage);
+    e[5] = ptAddEdge(pt, v[4], v[1], storage);
+    e[6] = ptAddEdge(pt, v[4], v[2], storage);
+    e[7] = ptAddEdge(pt, v[4], v[3], storage);
+
+    e[8]  = ptAddEdge(pt, v[5], v[0], storage);
+    e[9]  = ptAddEdge(pt, v[5], v[1], storage);
+    e[10] = ptAddEdge(pt, v[5], v[2], storage);
+    e[11] = ptAddEdge(pt, v[5], v[3], storage);
+
+    if (ptAddFace(pt, e[4], e[5], e[0], storage) == NULL
+            || ptAddFace(pt, e[5], e[6], e[1], storage) == NULL
+            || ptAddFace(pt, e[6], e[7], e[2], storage) == NULL
+            || ptAddFace(pt, e[7], e[4], e[3], storage) == NULL
+
+            || ptAddFace(pt, e[8],  e[9],  e[0], storage) == NULL
+            || ptAddFace(pt, e[9],  e[10], e[1], storage) == NULL
+            || ptAddFace(pt, e[10], e[11], e[2], storage) == NULL
+            || ptAddFace(pt, e[11], e[8],  e[3], storage) == NULL){
         return -2;
     }
 
@@ -807,12 +1101,15 @@ static bool isPolytopeEmpty(const ccd_pt_t& polytope) {
  * @param[out] nearest If the function detects that obj1 and obj2 are touching,
  * then set *nearest to be the nearest points on obj1 and obj2 respectively;
  * otherwise set *nearest to NULL. @note nearest cannot be NULL.
+ * @param[in] storage The storage the polytope elements come from, or nullptr
+ * to allocate them with libccd.
  * @retval status return 0 on success, -1 if touching contact is detected, and
  * -2 on non-recoverable failure (mostly due to memory allocation bug).
  */
 static int convert2SimplexToTetrahedron(const void* obj1, const void* obj2,
                               const ccd_t* ccd, const ccd_simplex_t* simplex,
-                              ccd_pt_t* polytope, ccd_pt_el_t** nearest) {
+                              ccd_pt_t* polytope, ccd_pt_el_t** nearest,
+                              PolytopeStorage* storage = nullptr) {
   assert(nearest);
   assert(isPolytopeEmpty(*polytope));
   assert(simplex->last == 2); // a 2-simplex.
@@ -857,19 +1154,19 @@ static int convert2SimplexToTetrahedron(const void* obj1, const void* obj2,
   const ccd_real_t scale_distance_2 = ccdVec3Dot(&dir, &candidate_2.v);
 
   // Form a tetrahedron with abc as one face and a fourth point `v`.
-  auto FormTetrahedron = [polytope, a, b, c, &v,
+  auto FormTetrahedron = [polytope, storage, a, b, c, &v,
                           &e](const ccd_support_t& new_support) -> int {
-    v[0] = ccdPtAddVertex(polytope, a);
-    v[1] = ccdPtAddVertex(polytope, b);
-    v[2] = ccdPtAddVertex(polytope, c);
-    v[3] = ccdPtAddVertex(polytope, &new_support);
-
-    e[0] = ccdPtAddEdge(polytope, v[0], v[1]);
-    e[1] = ccdPtAddEdge(polytope, v[1], v[2]);
-    e[2] = ccdPtAddEdge(polytope, v[2], v[0]);
-    e[3] = ccdPtAddEdge(polytope, v[0], v[3]);
-    e[4] = ccdPtAddEdge(polytope, v[1], v[3]);
-    e[5] = ccdPtAddEdge(polytope, v[2], v[3]);
+    v[0] = ptAddVertex(polytope, a, storage);
+    v[1] = ptAddVertex(polytope, b, storage);
+    v[2] = ptAddVertex(polytope, c, storage);
+    v[3] = ptAddVertex(polytope, &new_support, storage);
+
+    e[0] = ptAddEdge(polytope, v[0], v[1], storage);
+    e[1] = ptAddEdge(polytope, v[1], v[2], storage);
+    e[2] = ptAddEdge(polytope, v[2], v[0], storage);
+    e[3] = ptAddEdge(polytope, v[0], v[3], storage);
+    e[4] = ptAddEdge(polytope, v[1], v[3], storage);
+    e[5] = ptAddEdge(polytope, v[2], v[3], storage);
 
     // ccdPtAdd*() functions return NULL either if the memory allocation
     // failed of if any of the input pointers are NULL, so the bad
@@ -878,10 +1175,10 @@ static int convert2SimplexToTetrahedron(const void* obj1, const void* obj2,
     // Note, there is no requirement on the winding of the face, namely we do
     // not guarantee if all f.e(0).cross(f.e(1)) points outward (or inward) for
     // all the faces added below.
-    if (ccdPtAddFace(polytope, e[0], e[1], e[2]) == NULL ||
-        ccdPtAddFace(polytope, e[3], e[4], e[0]) == NULL ||
-        ccdPtAddFace(polytope, e[4], e[5], e[1]) == NULL ||
-        ccdPtAddFace(polytope, e[5], e[3], e[2]) == NULL) {
+    if (ptAddFace(polytope, e[0], e[1], e[2], storage) == NULL ||
+        ptAddFace(polytope, e[3], e[4], e[0], storage) == NULL ||
+        ptAddFace(polytope, e[4], e[5], e[1], storage) == NULL ||
+        ptAddFace(polytope, e[5], e[3], e[2], storage) == NULL) {
       return -2;
     }
     return 0;
@@ -901,7 +1198,8 @@ static int convert2SimplexToTetrahedron(const void* obj1, const void* obj2,
  *  vertices! */
 static int simplexToPolytope4(const void* obj1, const void* obj2,
                               const ccd_t* ccd, ccd_simplex_t* simplex,
-                              ccd_pt_t* pt, ccd_pt_el_t** nearest) {
+                              ccd_pt_t* pt, ccd_pt_el_t** nearest,
+                              PolytopeStorage* storage = nullptr) {
   const ccd_support_t *a, *b, *c, *d;
   bool use_polytope3{false};
   ccd_pt_vertex_t* v[4];
@@ -955,29 +1253,30 @@ static int simplexToPolytope4(const void* obj1, const void* obj2,
 
   if (use_polytope3) {
     ccdSimplexSetSize(simplex, 3);
-    return convert2SimplexToTetrahedron(obj1, obj2, ccd, simplex, pt, nearest);
+    return convert2SimplexToTetrahedron(obj1, obj2, ccd, simplex, pt, nearest,
+                                        storage);
   }
 
   // no touching contact - simply create tetrahedron
   for (i = 0; i < 4; i++) {
-    v[i] = ccdPtAddVertex(pt, ccdSimplexPoint(simplex, i));
+    v[i] = ptAddVertex(pt, ccdSimplexPoint(simplex, i), storage);
   }
 
-  e[0] = ccdPtAddEdge(pt, v[0], v[1]);
-  e[1] = ccdPtAddEdge(pt, v[1], v[2]);
-  e[2] = ccdPtAddEdge(pt, v[2], v[0]);
-  e[3] = ccdPtAddEdge(pt, v[3], v[0]);
-  e[4] = ccdPtAddEdge(pt, v[3], v[1]);
-  e[5] = ccdPtAddEdge(pt, v[3], v[2]);
+  e[0] = ptAddEdge(pt, v[0], v[1], storage);
+  e[1] = ptAddEdge(pt, v[1], v[2], storage);
+  e[2] = ptAddEdge(pt, v[2], v[0], storage);
+  e[3] = ptAddEdge(pt, v[3], v[0], storage);
+  e[4] = ptAddEdge(pt, v[3], v[1], storage);
+  e[5] = ptAddEdge(pt, v[3], v[2], storage);
 
   // ccdPtAdd*() functions return NULL either if the memory allocation
   // failed of if any of the input pointers are NULL, so the bad
   // allocation can be checked by the last calls of ccdPtAddFace()
   // because the rest of the bad allocations eventually "bubble up" here
-  if (ccdPtAddFace(pt, e[0], e[1], e[2]) == NULL ||
-      ccdPtAddFace(pt, e[3], e[4], e[0]) == NULL ||
-      ccdPtAddFace(pt, e[4], e[5], e[1]) == NULL ||
-      ccdPtAddFace(pt, e[5], e[3], e[2]) == NULL) {
+  if (ptAddFace(pt, e[0], e[1], e[2], storage) == NULL ||
+      ptAddFace(pt, e[3], e[4], e[0], storage) == NULL ||
+      ptAddFace(pt, e[4], e[5], e[1], storage) == NULL ||
+      ptAddFace(pt, e[5], e[3], e[2], storage) == NULL) {
     return -2;
   }
 
@@ -1457,6 +1756,8 @@ static void ComputeVisiblePatch(
  * objects are in touching contact, causing the algorithm to exit before calling
  * expandPolytope() function.
  * @param[in] newv The new vertex add to the polytope.
+ * @param[in] storage The storage the polytope elements come from, or nullptr
+ * if they were allocated by libccd.
  * @retval status Returns 0 on success. Returns -2 otherwise.
  * @throws UnexpectedConfigurationException if expanding is meaningless either
  * because 1) the nearest feature is a vertex, 2) the new vertex lies on
@@ -1464,7 +1765,8 @@ static void ComputeVisiblePatch(
  * one or more adjacent faces with no area.
  */
 static int expandPolytope(ccd_pt_t *polytope, ccd_pt_el_t *el,
-                          const ccd_support_t *newv)
+                          const ccd_support_t *newv,
+                          PolytopeStorage* storage = nullptr)
 {
   // The outline of the algorithm is as follows:
   //  1. Compute the visible patch relative to the new vertex (See
@@ -1521,12 +1823,12 @@ static int expandPolytope(ccd_pt_t *polytope, ccd_pt_el_t *el,
   // delete `face`. It would be better if we only loop through the list
   // polytope->faces for once. Same for the edges.
   for (const auto& f : visible_faces) {
-    ccdPtDelFace(polytope, f);
+    ptDelFace(polytope, f, storage);
   }
 
   // Now remove all the obsolete edges.
   for (const auto& e : internal_edges) {
-    ccdPtDelEdge(polytope, e);
+    ptDelEdge(polytope, e, storage);
   }
 
   // Note: this does not delete any vertices that were on the interior of the
@@ -1542,7 +1844,7 @@ static int expandPolytope(ccd_pt_t *polytope, ccd_pt_el_t *el,
   // `newv`.
 
   // Now add the new vertex.
-  ccd_pt_vertex_t* new_vertex = ccdPtAddVertex(polytope, newv);
+  ccd_pt_vertex_t* new_vertex = ptAddVertex(polytope, newv, storage);
 
   // Now add the new edges and faces, by connecting the new vertex with vertices
   // on border_edges. map_vertex_to_new_edge maps a vertex on the silhouette
@@ -1556,7 +1858,7 @@ static int expandPolytope(ccd_pt_t *polytope, ccd_pt_el_t *el,
       auto it = map_vertex_to_new_edge.find(border_edge->vertex[i]);
       if (it == map_vertex_to_new_edge.end()) {
         // This edge has not been added yet.
-        e[i] = ccdPtAddEdge(polytope, new_vertex, border_edge->vertex[i]);
+        e[i] = ptAddEdge(polytope, new_vertex, border_edge->vertex[i], storage);
         map_vertex_to_new_edge.emplace_hint(it, border_edge->vertex[i],
                                             e[i]);
       } else {
@@ -1564,7 +1866,7 @@ static int expandPolytope(ccd_pt_t *polytope, ccd_pt_el_t *el,
       }
     }
     // Now add the face.
-    ccdPtAddFace(polytope, border_edge, e[0], e[1]);
+    ptAddFace(polytope, border_edge, e[0], e[1], storage);
   }
 
   return 0;
@@ -1843,7 +2145,8 @@ static void validateNearestFeatureOfPolytopeBeingEdge(ccd_pt_t* polytope) {
 static int __ccdEPA(const void *obj1, const void *obj2,
                     const ccd_t *ccd,
                     ccd_simplex_t* simplex,
-                    ccd_pt_t *polytope, ccd_pt_el_t **nearest)
+                    ccd_pt_t *polytope, ccd_pt_el_t **nearest,
+                    PolytopeStorage* storage = nullptr)
 {
     ccd_support_t supp; // support point
     int ret, size;
@@ -1855,12 +2158,14 @@ static int __ccdEPA(const void *obj1, const void *obj2,
     // transform simplex to polytope - simplex won't be used anymore
     size = ccdSimplexSize(simplex);
     if (size == 4){
-        ret = simplexToPolytope4(obj1, obj2, ccd, simplex, polytope, nearest);
+        ret = simplexToPolytope4(obj1, obj2, ccd, simplex, polytope, nearest,
+                                 storage);
     } else if (size == 3) {
       ret = convert2SimplexToTetrahedron(obj1, obj2, ccd, simplex, polytope,
-                                         nearest);
+                                         nearest, storage);
     }else{ // size == 2
-        ret = simplexToPolytope2(obj1, obj2, ccd, simplex, polytope, nearest);
+        ret = simplexToPolytope2(obj1, obj2, ccd, simplex, polytope, nearest,
+                                 storage);
     }
 
 
@@ -1874,14 +2179,14 @@ static int __ccdEPA(const void *obj1, const void *obj2,
 
     while (1) {
       // get triangle nearest to origin
-      *nearest = ccdPtNearest(polytope);
+      *nearest = ptNearest(polytope, storage);
       if (polytope->nearest_type == CCD_PT_EDGE) {
         // When libccd thinks the nearest feature is an edge, that is often
         // wrong, hence we validate the nearest feature by ourselves.
         // TODO remove this validation step when we can reliably compute the
         // nearest feature of a polytope.
         validateNearestFeatureOfPolytopeBeingEdge(polytope);
-        *nearest = ccdPtNearest(polytope);
+        *nearest = ptNearest(polytope, storage);
       }
 
       // get next support point
@@ -1890,7 +2195,7 @@ static int __ccdEPA(const void *obj1, const void *obj2,
       }
 
       // expand nearest triangle using new point - supp
-      if (expandPolytope(polytope, *nearest, &supp) != 0) return -2;
+      if (expandPolytope(polytope, *nearest, &supp, storage) != 0) return -2;
     }
 
     return 0;
@@ -2290,8 +2595,15 @@ static inline ccd_real_t ccdGJKSignedDist(const void* obj1, const void* obj2,
     ccd_pt_el_t *nearest;
     ccd_real_t depth;
 
+    // The polytope elements come from the storage of the thread, so that
+    // their memory is reused by the next queries. It is reset before the
+    // query rather than after it, since EPA may throw.
+    static thread_local PolytopeStorage storage;
+    storage.reset();
+
     ccdPtInit(&polytope);
-    int ret = __ccdEPA(obj1, obj2, ccd, &simplex, &polytope, &nearest);
+    int ret = __ccdEPA(obj1, obj2, ccd, &simplex, &polytope, &nearest,
+                       &storage);
     if (ret == 0 && nearest)
     {
       depth = -CCD_SQRT(nearest->dist);
@@ -2316,8 +2628,6 @@ static inline ccd_real_t ccdGJKSignedDist(const void* obj1, const void* obj2,
       depth = -CCD_ONE;
     }
 
-    ccdPtDestroy(&polytope);
-
     return depth;
   }
   else // not in collision
@@ -2429,6 +2739,7 @@ static void convexToGJK(const Convex<S>& s, const Transform3<S>& tf,
 {
   shapeToGJK(s, tf, conv);
   conv->convex = &s;
+  conv->extreme_index = 0;
 }
 
 /** Support functions */
@@ -2601,8 +2912,10 @@ static void supportConvex(const void* obj, const ccd_vec3_t* dir_,
   // avoid warning/errors about implicit narrowing, we explicitly convert.
   Vector3<S> dir_C{S(dir.v[0]), S(dir.v[1]), S(dir.v[2])};
 
-  // The extremal point E measured and expressed in Frame C.
-  const Vector3<S>& p_CE = c->convex->findExtremeVertex(dir_C);
+  // The extremal point E measured and expressed in Frame C. Successive GJK
+  // and EPA directions are close, so the walk starts from the last answer.
+  c->extreme_index = c->convex->findExtremeVertexIndex(dir_C, c->extreme_index);
+  const Vector3<S>& p_CE = c->convex->getVertices()[c->extreme_index];
 
   // Now measure and express E in the original query frame Q: p_CE -> p_QE.
   v->v[0] = p_CE(0);
@@ -61,12 +61,164 @@ namespace detail
 extern template
 struct MinkowskiDiff<double>;
 
+//==============================================================================
+template <typename S>
+Vector3<S> getShapeSupport(
+    const TriangleP<S>& triangle, const Vector3<S>& dir, int*)
+{
+  S dota = dir.dot(triangle.a);
+  S dotb = dir.dot(triangle.b);
+  S dotc = dir.dot(triangle.c);
+  if(dota > dotb)
+  {
+    if(dotc > dota)
+      return triangle.c;
+    else
+      return triangle.a;
+  }
+  else
+  {
+    if(dotc > dotb)
+      return triangle.c;
+    else
+      return triangle.b;
+  }
+}
+
+//==============================================================================
+template <typename S>
+Vector3<S> getShapeSupport(
+    const Box<S>& box, const Vector3<S>& dir, int*)
+{
+  return Vector3<S>((dir[0]>0)?(box.side[0]/2):(-box.side[0]/2),
+                    (dir[1]>0)?(box.side[1]/2):(-box.side[1]/2),
+                    (dir[2]>0)?(box.side[2]/2):(-box.side[2]/2));
+}
+
+//==============================================================================
+template <typename S>
+Vector3<S> getShapeSupport(
+    const Sphere<S>& sphere, const Vector3<S>& dir, int*)
+{
+  return dir * sphere.radius;
+}
+
+//==============================================================================
+template <typename S>
+Vector3<S> getShapeSupport(
+    const Ellipsoid<S>& ellipsoid, const Vector3<S>& dir, int*)
+{
+  const S a2 = ellipsoid.radii[0] * ellipsoid.radii[0];
+  const S b2 = ellipsoid.radii[1] * ellipsoid.radii[1];
+  const S c2 = ellipsoid.radii[2] * ellipsoid.radii[2];
+
+  const Vector3<S> v(a2 * dir[0], b2 * dir[1], c2 * dir[2]);
+  const S d = std::sqrt(v.dot(dir));
+
+  return v / d;
+}
+
+//==============================================================================
+template <typename S>
+Vector3<S> getShapeSupport(
+    const Capsule<S>& capsule, const Vector3<S>& dir, int*)
+{
+  S half_h = capsule.lz * 0.5;
+  Vector3<S> pos1(0, 0, half_h);
+  Vector3<S> pos2(0, 0, -half_h);
+  Vector3<S> v = dir * capsule.radius;
+  pos1 += v;
+  pos2 += v;
+  if(dir.dot(pos1) > dir.dot(pos2))
+    return pos1;
+  else return pos2;
+}
+
+//==============================================================================
+template <typename S>
+Vector3<S> getShapeSupport(
+    const Cone<S>& cone, const Vector3<S>& dir, int*)
+{
+  S zdist = dir[0] * dir[0] + dir[1] * dir[1];
+  S len = zdist + dir[2] * dir[2];
+  zdist = std::sqrt(zdist);
+  len = std::sqrt(len);
+  S half_h = cone.lz * 0.5;
+  S radius = cone.radius;
+
+  S sin_a = radius / std::sqrt(radius * radius + 4 * half_h * half_h);
+
+  if(dir[2] > len * sin_a)
+    return Vector3<S>(0, 0, half_h);
+  else if(zdist > 0)
+  {
+    S rad = radius / zdist;
+    return Vector3<S>(rad * dir[0], rad * dir[1], -half_h);
+  }
+  else
+    return Vector3<S>(0, 0, -half_h);
+}
+
+//==============================================================================
+template <typename S>
+Vector3<S> getShapeSupport(
+    const Cylinder<S>& cylinder, const Vector3<S>& dir, int*)
+{
+  S zdist = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1]);
+  S half_h = cylinder.lz * 0.5;
+  if(zdist == 0.0)
+  {
+    return Vector3<S>(0, 0, (dir[2]>0)? half_h:-half_h);
+  }
+  else
+  {
+    S d = cylinder.radius / zdist;
+    return Vector3<S>(d * dir[0], d * dir[1], (dir[2]>0)?half_h:-half_h);
+  }
+}
+
+//==============================================================================
+template <typename S>
+Vector3<S> getShapeSupport(
+    const Convex<S>& convex, const Vector3<S>& dir, int* hint)
+{
+  const int index = convex.findExtremeVertexIndex(dir, hint ? *hint : 0);
+  if(hint) *hint = index;
+  return convex.getVertices()[index];
+}
+
+//==============================================================================
+template <typename S>
+Vector3<S> getShapeSupport(
+    const ShapeBase<S>&, const Vector3<S>&, int*)
+{
+  // Shapes without a support mapping (plane, halfspace)
+  return Vector3<S>::Zero();
+}
+
+//==============================================================================
+template <typename S, typename Shape>
+Vector3<S> getTypedSupport(
+    const ShapeBase<S>* shape, const Vector3<S>& dir, int* hint)
+{
+  return getShapeSupport(*static_cast<const Shape*>(shape), dir, hint);
+}
+
+//==============================================================================
+template <typename S>
+Vector3<S> getDynamicSupport(
+    const ShapeBase<S>* shape, const Vector3<S>& dir, int* hint)
+{
+  return getSupport(shape, dir, hint);
+}
+
 //==============================================================================
 template <typename S, typename Derived>
 FCL_EXPORT
 Vector3<S> getSupport(
     const ShapeBase<S>* shape,
-    const Eigen::MatrixBase<Derived>& dir)
+    const Eigen::MatrixBase<Derived>& dir,
+    int* hint)
 {
   // Check the number of rows is 6 at compile time
   EIGEN_STATIC_ASSERT(
@@ -74,128 +226,26 @@ Vector3<S> getSupport(
         && Derived::ColsAtCompileTime == 1,
         THIS_METHOD_IS_ONLY_FOR_MATRICES_OF_A_SPECIFIC_SIZE);
 
+  const Vector3<S> d = dir;
+
   switch(shape->getNodeType())
   {
   case GEOM_TRIANGLE:
-    {
-      const auto* triangle = static_cast<const TriangleP<S>*>(shape);
-      S dota = dir.dot(triangle->a);
-      S dotb = dir.dot(triangle->b);
-      S dotc = dir.dot(triangle->c);
-      if(dota > dotb)
-      {
-        if(dotc > dota)
-          return triangle->c;
-        else
-          return triangle->a;
-      }
-      else
-      {
-        if(dotc > dotb)
-          return triangle->c;
-        else
-          return triangle->b;
-      }
-    }
-    break;
+    return getShapeSupport(*static_cast<const TriangleP<S>*>(shape), d, hint);
   case GEOM_BOX:
-    {
-      const Box<S>* box = static_cast<const Box<S>*>(shape);
-      return Vector3<S>((dir[0]>0)?(box->side[0]/2):(-box->side[0]/2),
-                   (dir[1]>0)?(box->side[1]/2):(-box->side[1]/2),
-                   (dir[2]>0)?(box->side[2]/2):(-box->side[2]/2));
-    }
-    break;
+    return getShapeSupport(*static_cast<const Box<S>*>(shape), d, hint);
   case GEOM_SPHERE:
-    {
-      const Sphere<S>* sphere = static_cast<const Sphere<S>*>(shape);
-      return dir * sphere->radius;
-    }
-    break;
+    return getShapeSupport(*static_cast<const Sphere<S>*>(shape), d, hint);
   case GEOM_ELLIPSOID:
-    {
-      const Ellipsoid<S>* ellipsoid = static_cast<const Ellipsoid<S>*>(shape);
-
-      const S a2 = ellipsoid->radii[0] * ellipsoid->radii[0];
-      const S b2 = ellipsoid->radii[1] * ellipsoid->radii[1];
-      const S c2 = ellipsoid->radii[2] * ellipsoid->radii[2];
-
-      const Vector3<S> v(a2 * dir[0], b2 * dir[1], c2 * dir[2]);
-      const S d = std::sqrt(v.dot(dir));
-
-      return v / d;
-    }
-    break;
+    return getShapeSupport(*static_cast<const Ellipsoid<S>*>(shape), d, hint);
   case GEOM_CAPSULE:
-    {
-      const Capsule<S>* capsule = static_cast<const Capsule<S>*>(shape);
-      S half_h = capsule->lz * 0.5;
-      Vector3<S> pos1(0, 0, half_h);
-      Vector3<S> pos2(0, 0, -half_h);
-      Vector3<S> v = dir * capsule->radius;
-      pos1 += v;
-      pos2 += v;
-      if(dir.dot(pos1) > dir.dot(pos2))
-        return pos1;
-      else return pos2;
-    }
-    break;
+    return getShapeSupport(*static_cast<const Capsule<S>*>(shape), d, hint);
   case GEOM_CONE:
-    {
-      const Cone<S>* cone = static_cast<const Cone<S>*>(shape);
-      S zdist = dir[0] * dir[0] + dir[1] * dir[1];
-      S len = zdist + dir[2] * dir[2];
-      zdist = std::sqrt(zdist);
-      len = std::sqrt(len);
-      S half_h = cone->lz * 0.5;
-      S radius = cone->radius;
-
-      S sin_a = radius / std::sqrt(radius * radius + 4 * half_h * half_h);
-
-      if(dir[2] > len * sin_a)
-        return Vector3<S>(0, 0, half_h);
-      else if(zdist > 0)
-      {
-        S rad = radius / zdist;
-        return Vector3<S>(rad * dir[0], rad * dir[1], -half_h);
-      }
-      else
-        return Vector3<S>(0, 0, -half_h);
-    }
-    break;
+    return getShapeSupport(*static_cast<const Cone<S>*>(shape), d, hint);
   case GEOM_CYLINDER:
-    {
-      const Cylinder<S>* cylinder = static_cast<const Cylinder<S>*>(shape);
-      S zdist = std::sqrt(dir[0] * dir[0] + dir[1] * dir[1]);
-      S half_h = cylinder->lz * 0.5;
-      if(zdist == 0.0)
-      {
-        return Vector3<S>(0, 0, (dir[2]>0)? half_h:-half_h);
-      }
-      else
-      {
-        S d = cylinder->radius / zdist;
-        return Vector3<S>(d * dir[0], d * dir[1], (dir[2]>0)?half_h:-half_h);
-      }
-    }
-    break;
+    return getShapeSupport(*static_cast<const Cylinder<S>*>(shape), d, hint);
   case GEOM_CONVEX:
-    {
-      const Convex<S>* convex = static_cast<const Convex<S>*>(shape);
-      S maxdot = - std::numeric_limits<S>::max();
-      Vector3<S> bestv = Vector3<S>::Zero();
-      for(const auto& vertex : convex->getVertices())
-      {
-        S dot = dir.dot(vertex);
-        if(dot > maxdot)
-        {
-          bestv = vertex;
-          maxdot = dot;
-        }
-      }
-      return bestv;
-    }
-    break;
+    return getShapeSupport(*static_cast<const Convex<S>*>(shape), d, hint);
   case GEOM_PLANE:
   break;
   default:
@@ -208,22 +258,35 @@ Vector3<S> getSupport(
 //==============================================================================
 template <typename S>
 MinkowskiDiff<S>::MinkowskiDiff()
+  : support_hints{0, 0},
+    support_functions{&getDynamicSupport<S>, &getDynamicSupport<S>}
 {
   // Do nothing
 }
 
+//==============================================================================
+template <typename S>
+template <typename Shape0, typename Shape1>
+void MinkowskiDiff<S>::setShapes(const Shape0* shape0, const Shape1* shape1)
+{
+  shapes[0] = shape0;
+  shapes[1] = shape1;
+  support_functions[0] = &getTypedSupport<S, Shape0>;
+  support_functions[1] = &getTypedSupport<S, Shape1>;
+}
+
 //==============================================================================
 template <typename S>
 Vector3<S> MinkowskiDiff<S>::support0(const Vector3<S>& d) const
 {
-  return getSupport(shapes[0], d);
+  return support_functions[0](shapes[0], d, &support_hints[0]);
 }
 
 //==============================================================================
 template <typename S>
 Vector3<S> MinkowskiDiff<S>::support1(const Vector3<S>& d) const
 {
-  return toshape0 * getSupport(shapes[1], toshape1 * d);
+  return toshape0 * support_functions[1](shapes[1], toshape1 * d, &support_hints[1]);
 }
 
 //==============================================================================
@@ -248,9 +311,9 @@ template <typename S>
 Vector3<S> MinkowskiDiff<S>::support0(const Vector3<S>& d, const Vector3<S>& v) const
 {
   if(d.dot(v) <= 0)
-    return getSupport(shapes[0], d);
+    return support0(d);
   else
-    return getSupport(shapes[0], d) + v;
+    return support0(d) + v;
 }
 
 //==============================================================================
@@ -48,10 +48,14 @@ namespace detail
 {
 
 /// @brief the support function for shape
+///
+/// For a Convex, hint (if given) is the index of the vertex where the search
+/// for the extreme vertex starts, and it is updated to the vertex found.
 template <typename S, typename Derived>
 Vector3<S> getSupport(
     const ShapeBase<S>* shape,
-    const Eigen::MatrixBase<Derived>& dir);
+    const Eigen::MatrixBase<Derived>& dir,
+    int* hint = nullptr);
 
 /// @brief Minkowski difference class of two shapes
 template <typename S>
@@ -66,8 +70,26 @@ struct FCL_EXPORT MinkowskiDiff
   /// @brief transform from shape1 to shape0 
   Transform3<S> toshape0;
 
+  /// @brief last support vertex of each shape, for the shapes whose support
+  /// search can be warm started (Convex)
+  mutable int support_hints[2];
+
+  /// @brief support function of a shape, its direction is in the shape frame
+  using SupportFunction = Vector3<S> (*)(
+      const ShapeBase<S>* shape, const Vector3<S>& dir, int* hint);
+
+  /// @brief the support functions of the two shapes. They dispatch on the
+  /// node type of the shape unless the shapes are given by setShapes().
+  SupportFunction support_functions[2];
+
   MinkowskiDiff();
 
+  /// @brief Set the two shapes, and bind the support functions of their
+  /// concrete types so that the node type is not dispatched on every support
+  /// evaluation. The transforms are not modified.
+  template <typename Shape0, typename Shape1>
+  void setShapes(const Shape0* shape0, const Shape1* shape1);
+
   /// @brief support function for shape0
   Vector3<S> support0(const Vector3<S>& d) const;
   
@@ -40,6 +40,9 @@
 
 #include "fcl/narrowphase/detail/distance_func_matrix.h"
 
+#include <functional>
+#include <queue>
+
 #include "fcl/config.h"
 
 #include "fcl/common/types.h"
@@ -47,6 +50,8 @@
 
 #include "fcl/narrowphase/collision_object.h"
 
+#include "fcl/geometry/compound.h"
+
 #include "fcl/narrowphase/detail/traversal/collision_node.h"
 #include "fcl/narrowphase/detail/gjk_solver_indep.h"
 #include "fcl/narrowphase/detail/gjk_solver_libccd.h"
@@ -473,6 +478,145 @@ typename BV::S BVHDistance(
   return BVHDistance<BV>(o1, tf1, o2, tf2, request, result);
 }
 
+//==============================================================================
+template <typename NarrowPhaseSolver>
+void compoundChildDistance(
+    const Compound<typename NarrowPhaseSolver::S>* compound,
+    int child,
+    const Transform3<typename NarrowPhaseSolver::S>& tf,
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* other,
+    const Transform3<typename NarrowPhaseSolver::S>& other_tf,
+    bool compound_first,
+    const NarrowPhaseSolver* nsolver,
+    const DistanceRequest<typename NarrowPhaseSolver::S>& request,
+    DistanceResult<typename NarrowPhaseSolver::S>& result)
+{
+  using S = typename NarrowPhaseSolver::S;
+
+  const CollisionGeometry<S>* geometry = compound->getChild(child).get();
+  const Transform3<S> child_tf = tf * compound->getChildTransform(child);
+  const CollisionGeometry<S>* first = compound_first ? geometry : other;
+  const CollisionGeometry<S>* second = compound_first ? other : geometry;
+
+  // distance() gives a shape and a BVH to the entry of the BVH, in which case
+  // the child is the second object of the result
+  const bool swapped = first->getObjectType() == OT_GEOM
+      && second->getObjectType() == OT_BVH;
+  const bool child_is_o1 = (compound_first != swapped);
+
+  DistanceResult<S> child_result;
+  if(compound_first)
+    fcl::distance(geometry, child_tf, other, other_tf, nsolver, request, child_result);
+  else
+    fcl::distance(other, other_tf, geometry, child_tf, nsolver, request, child_result);
+
+  if(child_is_o1)
+  {
+    child_result.o1 = compound;
+    child_result.b1 = child;
+  }
+  else
+  {
+    child_result.o2 = compound;
+    child_result.b2 = child;
+  }
+  result.update(child_result);
+}
+
+//==============================================================================
+/// Visits the children of the compound by increasing distance between their
+/// boxes and the box of the other geometry, until no box is closer than the
+/// current minimum.
+template <typename NarrowPhaseSolver>
+typename NarrowPhaseSolver::S compoundDistance(
+    const Compound<typename NarrowPhaseSolver::S>* compound,
+    const Transform3<typename NarrowPhaseSolver::S>& tf,
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* other,
+    const Transform3<typename NarrowPhaseSolver::S>& other_tf,
+    bool compound_first,
+    const NarrowPhaseSolver* nsolver,
+    const DistanceRequest<typename NarrowPhaseSolver::S>& request,
+    DistanceResult<typename NarrowPhaseSolver::S>& result)
+{
+  using S = typename NarrowPhaseSolver::S;
+
+  if(compound->getNumBVs() == 0)
+  {
+    for(int i = 0; i < compound->getNumChildren(); ++i)
+      compoundChildDistance(compound, i, tf, other, other_tf, compound_first, nsolver, request, result);
+    return result.min_distance;
+  }
+
+  // without a local AABB for the other geometry, every box is at distance 0
+  const AABB<S>& local = other->aabb_local;
+  const bool bounded = !(local.min_[0] > local.max_[0]);
+  AABB<S> box;
+  if(bounded)
+    box = transformAABB(local, tf.inverse() * other_tf);
+
+  using Entry = std::pair<S, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  queue.emplace(bounded ? compound->getBV(0).bv.distance(box) : S(0), 0);
+  while(!queue.empty())
+  {
+    const Entry entry = queue.top();
+    queue.pop();
+
+    // with signed distance, a box touching the other one may still hide a
+    // deeper penetration
+    if(entry.first >= result.min_distance
+       && !(request.enable_signed_distance && entry.first <= 0))
+      break;
+
+    const BVNode<AABB<S>>& node = compound->getBV(entry.second);
+    if(node.isLeaf())
+    {
+      compoundChildDistance(compound, node.primitiveId(), tf, other, other_tf, compound_first, nsolver, request, result);
+      continue;
+    }
+
+    for(int child_bv : {node.leftChild(), node.rightChild()})
+    {
+      queue.emplace(bounded ? compound->getBV(child_bv).bv.distance(box) : S(0),
+                    child_bv);
+    }
+  }
+
+  return result.min_distance;
+}
+
+//==============================================================================
+template <typename NarrowPhaseSolver>
+typename NarrowPhaseSolver::S CompoundDistance(
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o1,
+    const Transform3<typename NarrowPhaseSolver::S>& tf1,
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o2,
+    const Transform3<typename NarrowPhaseSolver::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const DistanceRequest<typename NarrowPhaseSolver::S>& request,
+    DistanceResult<typename NarrowPhaseSolver::S>& result)
+{
+  using S = typename NarrowPhaseSolver::S;
+
+  return compoundDistance(static_cast<const Compound<S>*>(o1), tf1, o2, tf2, true, nsolver, request, result);
+}
+
+//==============================================================================
+template <typename NarrowPhaseSolver>
+typename NarrowPhaseSolver::S DistanceCompound(
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o1,
+    const Transform3<typename NarrowPhaseSolver::S>& tf1,
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o2,
+    const Transform3<typename NarrowPhaseSolver::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const DistanceRequest<typename NarrowPhaseSolver::S>& request,
+    DistanceResult<typename NarrowPhaseSolver::S>& result)
+{
+  using S = typename NarrowPhaseSolver::S;
+
+  return compoundDistance(static_cast<const Compound<S>*>(o2), tf2, o1, tf1, false, nsolver, request, result);
+}
+
 template <typename NarrowPhaseSolver>
 DistanceFunctionMatrix<NarrowPhaseSolver>::DistanceFunctionMatrix()
 {
@@ -704,6 +848,11 @@ DistanceFunctionMatrix<NarrowPhaseSolver>::DistanceFunctionMatrix()
   distance_matrix[BV_KDOP24][GEOM_OCTREE] = &BVHOcTreeDistance<KDOP<S, 24>, NarrowPhaseSolver>;
 #endif
 
+  for(int i = 0; i < NODE_COUNT; ++i)
+  {
+    distance_matrix[i][GEOM_COMPOUND] = &DistanceCompound<NarrowPhaseSolver>;
+    distance_matrix[GEOM_COMPOUND][i] = &CompoundDistance<NarrowPhaseSolver>;
+  }
 }
 
 } // namespace detail
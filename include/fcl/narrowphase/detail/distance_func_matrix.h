@@ -79,6 +79,20 @@ struct DistanceFunctionMatrix
 };
 
 } // namespace detail
+
+/// @brief Distance of two geometries with a given solver, defined in
+/// distance-inl.h. Declared here because the children of a compound are
+/// dispatched through the distance matrix again.
+template <typename NarrowPhaseSolver>
+typename NarrowPhaseSolver::S distance(
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o1,
+    const Transform3<typename NarrowPhaseSolver::S>& tf1,
+    const CollisionGeometry<typename NarrowPhaseSolver::S>* o2,
+    const Transform3<typename NarrowPhaseSolver::S>& tf2,
+    const NarrowPhaseSolver* nsolver,
+    const DistanceRequest<typename NarrowPhaseSolver::S>& request,
+    DistanceResult<typename NarrowPhaseSolver::S>& result);
+
 } // namespace fcl
 
 #include "fcl/narrowphase/detail/distance_func_matrix-inl.h"
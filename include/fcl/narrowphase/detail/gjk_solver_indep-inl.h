@@ -48,7 +48,10 @@
 
 #include "fcl/narrowphase/detail/convexity_based_algorithm/gjk.h"
 #include "fcl/narrowphase/detail/convexity_based_algorithm/epa.h"
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_box.h"
 #include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_capsule.h"
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_cylinder.h"
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/cylinder_box.h"
 #include "fcl/narrowphase/detail/primitive_shape_algorithm/sphere_box.h"
 #include "fcl/narrowphase/detail/primitive_shape_algorithm/sphere_capsule.h"
 #include "fcl/narrowphase/detail/primitive_shape_algorithm/sphere_cylinder.h"
@@ -108,60 +111,74 @@ bool GJKSolver_indep<S>::shapeIntersect(const Shape1& s1, const Transform3<S>& t
 }
 
 //==============================================================================
+// The generic GJK/EPA intersection, also the fallback of the pairs whose
+// custom algorithm only proves separation.
 template<typename S, typename Shape1, typename Shape2>
-struct ShapeIntersectIndepImpl
+bool shapeIntersectGJKEPA(
+    const GJKSolver_indep<S>& gjkSolver,
+    const Shape1& s1,
+    const Transform3<S>& tf1,
+    const Shape2& s2,
+    const Transform3<S>& tf2,
+    std::vector<ContactPoint<S>>* contacts)
 {
-  static bool run(
-      const GJKSolver_indep<S>& gjkSolver,
-      const Shape1& s1,
-      const Transform3<S>& tf1,
-      const Shape2& s2,
-      const Transform3<S>& tf2,
-      std::vector<ContactPoint<S>>* contacts)
-  {
-    Vector3<S> guess(1, 0, 0);
-    if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
+  Vector3<S> guess(1, 0, 0);
+  if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
-    detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s1;
-    shape.shapes[1] = &s2;
-    shape.toshape1.noalias() = tf2.linear().transpose() * tf1.linear();
-    shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
+  detail::MinkowskiDiff<S> shape;
+  shape.setShapes(&s1, &s2);
+  shape.toshape1.noalias() = tf2.linear().transpose() * tf1.linear();
+  shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
-    detail::GJK<S> gjk(gjkSolver.gjk_max_iterations, gjkSolver.gjk_tolerance);
-    typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess);
-    if(gjkSolver.enable_cached_guess) gjkSolver.cached_guess = gjk.getGuessFromSimplex();
+  detail::GJK<S> gjk(gjkSolver.gjk_max_iterations, gjkSolver.gjk_tolerance);
+  typename detail::GJK<S>::Status gjk_status = gjk.evaluate(shape, -guess);
+  if(gjkSolver.enable_cached_guess) gjkSolver.cached_guess = gjk.getGuessFromSimplex();
 
-    switch(gjk_status)
+  switch(gjk_status)
+  {
+  case detail::GJK<S>::Inside:
     {
-    case detail::GJK<S>::Inside:
+      detail::EPA<S> epa(gjkSolver.epa_max_face_num, gjkSolver.epa_max_vertex_num, gjkSolver.epa_max_iterations, gjkSolver.epa_tolerance);
+      typename detail::EPA<S>::Status epa_status = epa.evaluate(gjk, -guess);
+      if(epa_status != detail::EPA<S>::Failed)
       {
-        detail::EPA<S> epa(gjkSolver.epa_max_face_num, gjkSolver.epa_max_vertex_num, gjkSolver.epa_max_iterations, gjkSolver.epa_tolerance);
-        typename detail::EPA<S>::Status epa_status = epa.evaluate(gjk, -guess);
-        if(epa_status != detail::EPA<S>::Failed)
+        Vector3<S> w0 = Vector3<S>::Zero();
+        for(size_t i = 0; i < epa.result.rank; ++i)
         {
-          Vector3<S> w0 = Vector3<S>::Zero();
-          for(size_t i = 0; i < epa.result.rank; ++i)
-          {
-            w0.noalias() += shape.support(epa.result.c[i]->d, 0) * epa.result.p[i];
-          }
-          if(contacts)
-          {
-            Vector3<S> normal = epa.normal;
-            Vector3<S> point = tf1 * (w0 - epa.normal*(epa.depth *0.5));
-            S depth = -epa.depth;
-            contacts->emplace_back(normal, point, depth);
-          }
-          return true;
+          w0.noalias() += shape.support(epa.result.c[i]->d, 0) * epa.result.p[i];
         }
-        else return false;
+        if(contacts)
+        {
+          Vector3<S> normal = epa.normal;
+          Vector3<S> point = tf1 * (w0 - epa.normal*(epa.depth *0.5));
+          S depth = -epa.depth;
+          contacts->emplace_back(normal, point, depth);
+        }
+        return true;
       }
-      break;
-    default:
-      ;
+      else return false;
     }
+    break;
+  default:
+    ;
+  }
 
-    return false;
+  return false;
+}
+
+//==============================================================================
+template<typename S, typename Shape1, typename Shape2>
+struct ShapeIntersectIndepImpl
+{
+  static bool run(
+      const GJKSolver_indep<S>& gjkSolver,
+      const Shape1& s1,
+      const Transform3<S>& tf1,
+      const Shape2& s2,
+      const Transform3<S>& tf2,
+      std::vector<ContactPoint<S>>* contacts)
+  {
+    return shapeIntersectGJKEPA(gjkSolver, s1, tf1, s2, tf2, contacts);
   }
 };
 
@@ -180,17 +197,18 @@ bool GJKSolver_indep<S>::shapeIntersect(
 }
 
 // Shape intersect algorithms not using built-in GJK algorithm
+// (S: a custom separation test runs first, GJK/EPA only if it fails)
 //
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+----------+
 // |            | box | sphere | ellipsoid | capsule | cone | cylinder | plane | half-space | triangle |  convex  |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+----------+
-// | box        |  O  |   O    |           |         |      |          |   O   |      O     |          |          |
+// | box        |  O  |   O    |           |    O    |      |    S     |   O   |      O     |          |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+----------+
 // | sphere     |/////|   O    |           |    O    |      |    O     |   O   |      O     |     O    |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+----------+
 // | ellipsoid  |/////|////////|           |         |      |          |   O   |      O     |          |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+----------+
-// | capsule    |/////|////////|///////////|         |      |          |   O   |      O     |          |          |
+// | capsule    |/////|////////|///////////|         |      |    S     |   O   |      O     |          |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+----------+
 // | cone       |/////|////////|///////////|/////////|      |          |   O   |      O     |          |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+----------+
@@ -255,6 +273,8 @@ FCL_GJK_INDEP_SHAPE_SHAPE_INTERSECT(Sphere, Box, detail::sphereBoxIntersect)
 
 FCL_GJK_INDEP_SHAPE_SHAPE_INTERSECT(Sphere, Cylinder, detail::sphereCylinderIntersect)
 
+FCL_GJK_INDEP_SHAPE_SHAPE_INTERSECT(Capsule, Box, detail::capsuleBoxIntersect)
+
 FCL_GJK_INDEP_SHAPE_SHAPE_INTERSECT(Sphere, Halfspace, detail::sphereHalfspaceIntersect)
 FCL_GJK_INDEP_SHAPE_SHAPE_INTERSECT(Ellipsoid, Halfspace, detail::ellipsoidHalfspaceIntersect)
 FCL_GJK_INDEP_SHAPE_SHAPE_INTERSECT(Box, Halfspace, detail::boxHalfspaceIntersect)
@@ -270,6 +290,51 @@ FCL_GJK_INDEP_SHAPE_SHAPE_INTERSECT(Capsule, Plane, detail::capsulePlaneIntersec
 FCL_GJK_INDEP_SHAPE_SHAPE_INTERSECT(Cylinder, Plane, detail::cylinderPlaneIntersect)
 FCL_GJK_INDEP_SHAPE_SHAPE_INTERSECT(Cone, Plane, detail::conePlaneIntersect)
 
+#define FCL_GJK_INDEP_SHAPE_SHAPE_SEPARATED_INTERSECT(SHAPE1, SHAPE2, SEPARATED)\
+  template <typename S>\
+  struct ShapeIntersectIndepImpl<S, SHAPE1<S>, SHAPE2<S>>\
+  {\
+    static bool run(\
+        const GJKSolver_indep<S>& gjkSolver,\
+        const SHAPE1<S>& s1,\
+        const Transform3<S>& tf1,\
+        const SHAPE2<S>& s2,\
+        const Transform3<S>& tf2,\
+        std::vector<ContactPoint<S>>* contacts)\
+    {\
+      if (SEPARATED(s1, tf1, s2, tf2)) return false;\
+      return shapeIntersectGJKEPA(gjkSolver, s1, tf1, s2, tf2, contacts);\
+    }\
+  };\
+  template <typename S>\
+  struct ShapeIntersectIndepImpl<S, SHAPE2<S>, SHAPE1<S>>\
+  {\
+    static bool run(\
+        const GJKSolver_indep<S>& gjkSolver,\
+        const SHAPE2<S>& s1,\
+        const Transform3<S>& tf1,\
+        const SHAPE1<S>& s2,\
+        const Transform3<S>& tf2,\
+        std::vector<ContactPoint<S>>* contacts)\
+    {\
+      if (SEPARATED(s2, tf2, s1, tf1)) return false;\
+      return shapeIntersectGJKEPA(gjkSolver, s1, tf1, s2, tf2, contacts);\
+    }\
+  };
+
+template <typename S>
+bool capsuleCylinderSeparated(const Capsule<S>& capsule,
+                              const Transform3<S>& X_FC,
+                              const Cylinder<S>& cylinder,
+                              const Transform3<S>& X_FY)
+{
+  return detail::capsuleCylinderDistance<S>(
+        capsule, X_FC, cylinder, X_FY, nullptr, nullptr, nullptr);
+}
+
+FCL_GJK_INDEP_SHAPE_SHAPE_SEPARATED_INTERSECT(Capsule, Cylinder, capsuleCylinderSeparated)
+FCL_GJK_INDEP_SHAPE_SHAPE_SEPARATED_INTERSECT(Cylinder, Box, detail::cylinderBoxSeparated)
+
 template <typename S>
 struct ShapeIntersectIndepImpl<S, Halfspace<S>, Halfspace<S>>
 {
@@ -348,6 +413,68 @@ struct ShapeIntersectIndepImpl<S, Halfspace<S>, Plane<S>>
   }
 };
 
+//==============================================================================
+template<typename S, typename Shape1, typename Shape2>
+struct ShapeIntersectManifoldIndepImpl
+{
+  static bool run(
+      const GJKSolver_indep<S>& gjkSolver,
+      const Shape1& s1,
+      const Transform3<S>& tf1,
+      const Shape2& s2,
+      const Transform3<S>& tf2,
+      ContactManifold<S>& manifold,
+      std::vector<ContactPoint<S>>* contacts)
+  {
+    if(manifold.revalidate(tf1, tf2, contacts))
+      return true;
+
+    std::vector<ContactPoint<S>> new_contacts;
+    std::vector<ContactPoint<S>>* new_contacts_ptr
+        = contacts ? &new_contacts : nullptr;
+    const bool res = ShapeIntersectIndepImpl<S, Shape1, Shape2>::run(
+          gjkSolver, s1, tf1, s2, tf2, new_contacts_ptr);
+    manifold.update(tf1, tf2, res, new_contacts_ptr);
+
+    if(contacts)
+      contacts->insert(contacts->end(), new_contacts.begin(), new_contacts.end());
+
+    return res;
+  }
+};
+
+//==============================================================================
+template<typename S>
+struct ShapeIntersectManifoldIndepImpl<S, Box<S>, Box<S>>
+{
+  static bool run(
+      const GJKSolver_indep<S>& /*gjkSolver*/,
+      const Box<S>& s1,
+      const Transform3<S>& tf1,
+      const Box<S>& s2,
+      const Transform3<S>& tf2,
+      ContactManifold<S>& manifold,
+      std::vector<ContactPoint<S>>* contacts)
+  {
+    return detail::boxBoxIntersect(s1, tf1, s2, tf2, manifold, contacts);
+  }
+};
+
+//==============================================================================
+template<typename S>
+template<typename Shape1, typename Shape2>
+bool GJKSolver_indep<S>::shapeIntersect(
+    const Shape1& s1,
+    const Transform3<S>& tf1,
+    const Shape2& s2,
+    const Transform3<S>& tf2,
+    ContactManifold<S>& manifold,
+    std::vector<ContactPoint<S>>* contacts) const
+{
+  return ShapeIntersectManifoldIndepImpl<S, Shape1, Shape2>::run(
+        *this, s1, tf1, s2, tf2, manifold, contacts);
+}
+
 //==============================================================================
 template<typename S, typename Shape>
 struct ShapeTriangleIntersectIndepImpl
@@ -369,8 +496,7 @@ struct ShapeTriangleIntersectIndepImpl
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
     detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s;
-    shape.shapes[1] = &tri;
+    shape.setShapes(&s, &tri);
     shape.toshape1 = tf.linear();
     shape.toshape0 = tf.inverse(Eigen::Isometry);
 
@@ -466,8 +592,7 @@ struct ShapeTransformedTriangleIntersectIndepImpl
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
     detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s;
-    shape.shapes[1] = &tri;
+    shape.setShapes(&s, &tri);
     shape.toshape1.noalias() = tf2.linear().transpose() * tf1.linear();
     shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
@@ -607,8 +732,7 @@ struct ShapeDistanceIndepImpl
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
     detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s1;
-    shape.shapes[1] = &s2;
+    shape.setShapes(&s1, &s2);
     shape.toshape1.noalias() = tf2.linear().transpose() * tf1.linear();
     shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
@@ -688,13 +812,13 @@ bool GJKSolver_indep<S>::shapeSignedDistance(
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+
 // |            | box | sphere | ellipsoid | capsule | cone | cylinder | plane | half-space | triangle |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+
-// | box        |     |   O    |           |         |      |          |       |            |          |
+// | box        |     |   O    |           |    O    |      |          |       |            |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+
 // | sphere     |/////|   O    |           |    O    |      |    O     |       |            |     O    |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+
 // | ellipsoid  |/////|////////|           |         |      |          |       |            |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+
-// | capsule    |/////|////////|///////////|    O    |      |          |       |            |          |
+// | capsule    |/////|////////|///////////|    O    |      |    O     |       |            |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+
 // | cone       |/////|////////|///////////|/////////|      |          |       |            |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+
@@ -851,6 +975,80 @@ struct ShapeDistanceIndepImpl<S, Capsule<S>, Capsule<S>>
   }
 };
 
+//==============================================================================
+template<typename S>
+struct ShapeDistanceIndepImpl<S, Capsule<S>, Box<S>>
+{
+  static bool run(
+      const GJKSolver_indep<S>& /*gjkSolver*/,
+      const Capsule<S>& s1,
+      const Transform3<S>& tf1,
+      const Box<S>& s2,
+      const Transform3<S>& tf2,
+      S* dist,
+      Vector3<S>* p1,
+      Vector3<S>* p2)
+  {
+    return detail::capsuleBoxDistance(s1, tf1, s2, tf2, dist, p1, p2);
+  }
+};
+
+//==============================================================================
+template<typename S>
+struct ShapeDistanceIndepImpl<S, Box<S>, Capsule<S>>
+{
+  static bool run(
+      const GJKSolver_indep<S>& /*gjkSolver*/,
+      const Box<S>& s1,
+      const Transform3<S>& tf1,
+      const Capsule<S>& s2,
+      const Transform3<S>& tf2,
+      S* dist,
+      Vector3<S>* p1,
+      Vector3<S>* p2)
+  {
+    return detail::capsuleBoxDistance(s2, tf2, s1, tf1, dist, p2, p1);
+  }
+};
+
+//==============================================================================
+template<typename S>
+struct ShapeDistanceIndepImpl<S, Capsule<S>, Cylinder<S>>
+{
+  static bool run(
+      const GJKSolver_indep<S>& /*gjkSolver*/,
+      const Capsule<S>& s1,
+      const Transform3<S>& tf1,
+      const Cylinder<S>& s2,
+      const Transform3<S>& tf2,
+      S* dist,
+      Vector3<S>* p1,
+      Vector3<S>* p2)
+  {
+    return detail::capsuleCylinderDistance(
+        s1, tf1, s2, tf2, dist, p1, p2);
+  }
+};
+
+//==============================================================================
+template<typename S>
+struct ShapeDistanceIndepImpl<S, Cylinder<S>, Capsule<S>>
+{
+  static bool run(
+      const GJKSolver_indep<S>& /*gjkSolver*/,
+      const Cylinder<S>& s1,
+      const Transform3<S>& tf1,
+      const Capsule<S>& s2,
+      const Transform3<S>& tf2,
+      S* dist,
+      Vector3<S>* p1,
+      Vector3<S>* p2)
+  {
+    return detail::capsuleCylinderDistance(
+        s2, tf2, s1, tf1, dist, p2, p1);
+  }
+};
+
 //==============================================================================
 template<typename S, typename Shape>
 struct ShapeTriangleDistanceIndepImpl
@@ -871,8 +1069,7 @@ struct ShapeTriangleDistanceIndepImpl
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
     detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s;
-    shape.shapes[1] = &tri;
+    shape.setShapes(&s, &tri);
     shape.toshape1 = tf.linear();
     shape.toshape0 = tf.inverse(Eigen::Isometry);
 
@@ -962,8 +1159,7 @@ struct ShapeTransformedTriangleDistanceIndepImpl
     if(gjkSolver.enable_cached_guess) guess = gjkSolver.cached_guess;
 
     detail::MinkowskiDiff<S> shape;
-    shape.shapes[0] = &s;
-    shape.shapes[1] = &tri;
+    shape.setShapes(&s, &tri);
     shape.toshape1.noalias() = tf2.linear().transpose() * tf1.linear();
     shape.toshape0 = tf1.inverse(Eigen::Isometry) * tf2;
 
@@ -42,6 +42,7 @@
 
 #include "fcl/common/types.h"
 #include "fcl/narrowphase/contact_point.h"
+#include "fcl/narrowphase/contact_manifold.h"
 
 namespace fcl
 {
@@ -77,6 +78,20 @@ struct FCL_EXPORT GJKSolver_indep
       const Transform3<S>& tf2,
       std::vector<ContactPoint<S>>* contacts = nullptr) const;
 
+  /// @brief intersection checking between two shapes, reusing the state of
+  /// the previous query of the same pair kept in manifold. The contacts of a
+  /// pair whose relative pose did not change are returned from the manifold,
+  /// and box pairs test the last separating axis first. The contacts are
+  /// appended to contacts for every shape pair.
+  template<typename Shape1, typename Shape2>
+  bool shapeIntersect(
+      const Shape1& s1,
+      const Transform3<S>& tf1,
+      const Shape2& s2,
+      const Transform3<S>& tf2,
+      ContactManifold<S>& manifold,
+      std::vector<ContactPoint<S>>* contacts = nullptr) const;
+
   /// @brief intersection checking between one shape and a triangle
   template<typename Shape>
   bool shapeTriangleIntersect(
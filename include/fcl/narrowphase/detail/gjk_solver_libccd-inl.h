@@ -45,6 +45,7 @@
 #include "fcl/common/unused.h"
 
 #include "fcl/narrowphase/detail/convexity_based_algorithm/gjk_libccd.h"
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_box.h"
 #include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_capsule.h"
 #include "fcl/narrowphase/detail/primitive_shape_algorithm/sphere_box.h"
 #include "fcl/narrowphase/detail/primitive_shape_algorithm/sphere_capsule.h"
@@ -180,7 +181,7 @@ bool GJKSolver_libccd<S>::shapeIntersect(
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+----------+
 // |            | box | sphere | ellipsoid | capsule | cone | cylinder | plane | half-space | triangle |  convex  |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+----------+
-// | box        |  O  |   O    |           |         |      |          |   O   |      O     |          |          |
+// | box        |  O  |   O    |           |    O    |      |          |   O   |      O     |          |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+----------+
 // | sphere     |/////|   O    |           |    O    |      |    O     |   O   |      O     |    O     |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+----------+
@@ -251,6 +252,8 @@ FCL_GJK_LIBCCD_SHAPE_SHAPE_INTERSECT(Sphere, Box, detail::sphereBoxIntersect)
 
 FCL_GJK_LIBCCD_SHAPE_SHAPE_INTERSECT(Sphere, Cylinder, detail::sphereCylinderIntersect)
 
+FCL_GJK_LIBCCD_SHAPE_SHAPE_INTERSECT(Capsule, Box, detail::capsuleBoxIntersect)
+
 FCL_GJK_LIBCCD_SHAPE_SHAPE_INTERSECT(Sphere, Halfspace, detail::sphereHalfspaceIntersect)
 FCL_GJK_LIBCCD_SHAPE_SHAPE_INTERSECT(Ellipsoid, Halfspace, detail::ellipsoidHalfspaceIntersect)
 FCL_GJK_LIBCCD_SHAPE_SHAPE_INTERSECT(Box, Halfspace, detail::boxHalfspaceIntersect)
@@ -655,7 +658,7 @@ bool GJKSolver_libccd<S>::shapeDistance(
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+
 // |            | box | sphere | ellipsoid | capsule | cone | cylinder | plane | half-space | triangle |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+
-// | box        |     |   O    |           |         |      |          |       |            |          |
+// | box        |     |   O    |           |    O    |      |          |       |            |          |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+
 // | sphere     |/////|   O    |           |    O    |      |    O     |       |            |     O    |
 // +------------+-----+--------+-----------+---------+------+----------+-------+------------+----------+
@@ -818,6 +821,42 @@ struct ShapeDistanceLibccdImpl<S, Capsule<S>, Capsule<S>>
   }
 };
 
+//==============================================================================
+template<typename S>
+struct ShapeDistanceLibccdImpl<S, Capsule<S>, Box<S>>
+{
+  static bool run(
+      const GJKSolver_libccd<S>& /*gjkSolver*/,
+      const Capsule<S>& s1,
+      const Transform3<S>& tf1,
+      const Box<S>& s2,
+      const Transform3<S>& tf2,
+      S* dist,
+      Vector3<S>* p1,
+      Vector3<S>* p2)
+  {
+    return detail::capsuleBoxDistance(s1, tf1, s2, tf2, dist, p1, p2);
+  }
+};
+
+//==============================================================================
+template<typename S>
+struct ShapeDistanceLibccdImpl<S, Box<S>, Capsule<S>>
+{
+  static bool run(
+      const GJKSolver_libccd<S>& /*gjkSolver*/,
+      const Box<S>& s1,
+      const Transform3<S>& tf1,
+      const Capsule<S>& s2,
+      const Transform3<S>& tf2,
+      S* dist,
+      Vector3<S>* p1,
+      Vector3<S>* p2)
+  {
+    return detail::capsuleBoxDistance(s2, tf2, s1, tf1, dist, p2, p1);
+  }
+};
+
 //==============================================================================
 template<typename S, typename Shape>
 struct ShapeTriangleDistanceLibccdImpl
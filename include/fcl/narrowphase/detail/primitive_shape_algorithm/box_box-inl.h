@@ -81,6 +81,24 @@ bool boxBoxIntersect(const Box<double>& s1, const Transform3<double>& tf1,
                      const Box<double>& s2, const Transform3<double>& tf2,
                      std::vector<ContactPoint<double>>* contacts_);
 
+//==============================================================================
+extern template
+double boxBoxAxisSeparation(int code,
+                            const Vector3<double>& side1, const Transform3<double>& tf1,
+                            const Vector3<double>& side2, const Transform3<double>& tf2);
+
+//==============================================================================
+extern template
+int boxBoxSeparatingAxis(const Vector3<double>& side1, const Transform3<double>& tf1,
+                         const Vector3<double>& side2, const Transform3<double>& tf2);
+
+//==============================================================================
+extern template
+bool boxBoxIntersect(const Box<double>& s1, const Transform3<double>& tf1,
+                     const Box<double>& s2, const Transform3<double>& tf2,
+                     ContactManifold<double>& manifold,
+                     std::vector<ContactPoint<double>>* contacts_);
+
 //==============================================================================
 template <typename S>
 void lineClosestApproach(const Vector3<S>& pa, const Vector3<S>& ua,
@@ -874,6 +892,102 @@ bool boxBoxIntersect(const Box<S>& s1, const Transform3<S>& tf1,
   return return_code != 0;
 }
 
+//==============================================================================
+template <typename S>
+S boxBoxAxisSeparation(int code,
+                       const Vector3<S>& side1, const Transform3<S>& tf1,
+                       const Vector3<S>& side2, const Transform3<S>& tf2)
+{
+  const Matrix3<S>& R1 = tf1.linear();
+  const Matrix3<S>& R2 = tf2.linear();
+
+  Vector3<S> axis;
+  if(code >= 1 && code <= 3)
+  {
+    axis = R1.col(code - 1);
+  }
+  else if(code >= 4 && code <= 6)
+  {
+    axis = R2.col(code - 4);
+  }
+  else if(code >= 7 && code <= 15)
+  {
+    axis = R1.col((code - 7) / 3).cross(R2.col((code - 7) % 3));
+    const S l = axis.norm();
+    if(l <= std::numeric_limits<S>::epsilon())
+      return -std::numeric_limits<S>::max();
+    axis /= l;
+  }
+  else
+  {
+    return -std::numeric_limits<S>::max();
+  }
+
+  // half extents of the boxes projected on the axis
+  const S r1 = (R1.transpose() * axis).cwiseAbs().dot(side1) * 0.5;
+  const S r2 = (R2.transpose() * axis).cwiseAbs().dot(side2) * 0.5;
+
+  return std::abs(axis.dot(tf2.translation() - tf1.translation())) - (r1 + r2);
+}
+
+//==============================================================================
+template <typename S>
+int boxBoxSeparatingAxis(const Vector3<S>& side1, const Transform3<S>& tf1,
+                         const Vector3<S>& side2, const Transform3<S>& tf2)
+{
+  int best_code = 0;
+  S best = 0;
+  for(int code = 1; code <= 15; ++code)
+  {
+    const S d = boxBoxAxisSeparation(code, side1, tf1, side2, tf2);
+    if(d > best)
+    {
+      best = d;
+      best_code = code;
+    }
+  }
+
+  return best_code;
+}
+
+//==============================================================================
+template <typename S>
+bool boxBoxIntersect(const Box<S>& s1, const Transform3<S>& tf1,
+                     const Box<S>& s2, const Transform3<S>& tf2,
+                     ContactManifold<S>& manifold,
+                     std::vector<ContactPoint<S>>* contacts_)
+{
+  if(manifold.revalidate(tf1, tf2, contacts_))
+    return true;
+
+  // the axis which separated the boxes at the last query usually still does
+  if(manifold.isValid() && !manifold.isColliding() && manifold.getFeatureId() > 0
+     && boxBoxAxisSeparation(manifold.getFeatureId(),
+                             s1.side, tf1, s2.side, tf2) > 0)
+  {
+    manifold.update(tf1, tf2, false, nullptr, manifold.getFeatureId());
+    return false;
+  }
+
+  std::vector<ContactPoint<S>> contacts;
+  int return_code;
+  Vector3<S> normal;
+  S depth;
+  boxBox2(s1.side, tf1, s2.side, tf2, normal, &depth, &return_code, 4, contacts);
+
+  if(return_code != 0)
+  {
+    manifold.update(tf1, tf2, true, contacts_ ? &contacts : nullptr, return_code);
+    if(contacts_)
+      contacts_->insert(contacts_->end(), contacts.begin(), contacts.end());
+    return true;
+  }
+
+  manifold.update(tf1, tf2, false, nullptr,
+                  boxBoxSeparatingAxis(s1.side, tf1, s2.side, tf2));
+  return false;
+}
+
 } // namespace detail
 } // namespace fcl
 
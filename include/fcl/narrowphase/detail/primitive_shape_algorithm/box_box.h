@@ -40,6 +40,7 @@
 
 #include "fcl/common/types.h"
 #include "fcl/narrowphase/contact_point.h"
+#include "fcl/narrowphase/contact_manifold.h"
 #include "fcl/geometry/shape/box.h"
 
 namespace fcl
@@ -110,6 +111,36 @@ bool boxBoxIntersect(const Box<S>& s1, const Transform3<S>& tf1,
                      const Box<S>& s2, const Transform3<S>& tf2,
                      std::vector<ContactPoint<S>>* contacts_);
 
+/// @brief Signed distance between the projections of two boxes on one of the
+/// 15 candidate axes of boxBox2(), identified by the same code (1-3: axes of
+/// box 1, 4-6: axes of box 2, 7-15: cross products of an axis of box 1 with
+/// an axis of box 2). A positive value means the axis separates the boxes.
+/// Returns -max() for a degenerate cross product axis.
+template <typename S>
+FCL_EXPORT
+S boxBoxAxisSeparation(int code,
+                       const Vector3<S>& side1, const Transform3<S>& tf1,
+                       const Vector3<S>& side2, const Transform3<S>& tf2);
+
+/// @brief Code of the candidate axis of boxBox2() along which the boxes are
+/// the farthest apart, or 0 if no axis separates them
+template <typename S>
+FCL_EXPORT
+int boxBoxSeparatingAxis(const Vector3<S>& side1, const Transform3<S>& tf1,
+                         const Vector3<S>& side2, const Transform3<S>& tf2);
+
+/// @brief Same as boxBoxIntersect(), reusing the result of the previous query
+/// of the pair kept in manifold. A resting pair returns the cached contacts,
+/// and a separated pair first tests the axis which separated it last time.
+/// Unlike boxBoxIntersect(), the contacts are appended to contacts_, as the
+/// other manifold queries of GJKSolver_indep do.
+template <typename S>
+FCL_EXPORT
+bool boxBoxIntersect(const Box<S>& s1, const Transform3<S>& tf1,
+                     const Box<S>& s2, const Transform3<S>& tf2,
+                     ContactManifold<S>& manifold,
+                     std::vector<ContactPoint<S>>* contacts_);
+
 } // namespace detail
 } // namespace fcl
 
@@ -0,0 +1,288 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_CAPSULEBOX_INL_H
+#define FCL_NARROWPHASE_DETAIL_CAPSULEBOX_INL_H
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_box.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/sphere_box.h"
+
+namespace fcl {
+namespace detail {
+
+extern template FCL_EXPORT bool
+capsuleBoxIntersect(const Capsule<double>& capsule,
+                    const Transform3<double>& X_FC, const Box<double>& box,
+                    const Transform3<double>& X_FB,
+                    std::vector<ContactPoint<double>>* contacts);
+
+//==============================================================================
+
+extern template FCL_EXPORT bool
+capsuleBoxDistance(const Capsule<double>& capsule,
+                   const Transform3<double>& X_FC, const Box<double>& box,
+                   const Transform3<double>& X_FB, double* distance,
+                   Vector3<double>* p_FCb, Vector3<double>* p_FBc);
+
+//==============================================================================
+
+// Helper function for capsule-box queries. Given a box defined in its canonical
+// frame B and the segment P(t) = P0 + t * (P1 - P0), 0 ≤ t ≤ 1, finds a
+// parameter t for which P(t) is nearest to the box, and N, the point *inside*
+// the box nearest to P(t). On each piece between two parameters where the
+// segment crosses a face plane, every coordinate of P(t) stays below, within
+// or above the box, so the squared distance is a quadratic in t whose minimum
+// is closed-form.
+// @param size            The size of the box to query against.
+// @param p_BP0           The first end point of the segment, measured and
+//                        expressed in frame B.
+// @param p_BP1           The second end point of the segment, measured and
+//                        expressed in frame B.
+// @param[out] t_ptr      The parameter of the nearest point of the segment.
+// @param[out] p_BN_ptr   A position vector from frame B's origin to the point N
+//                        measured and expressed in frame B.
+// @returns the squared distance between P(t) and N (zero if the segment
+//          reaches the box).
+// @pre t_ptr and p_BN_ptr must point to valid instances.
+template <typename S>
+S nearestPointsSegmentBox(const Vector3<S>& size, const Vector3<S>& p_BP0,
+                          const Vector3<S>& p_BP1, S* t_ptr,
+                          Vector3<S>* p_BN_ptr) {
+  assert(t_ptr != nullptr);
+  assert(p_BN_ptr != nullptr);
+  const Vector3<S> half_size = size / 2;
+  const Vector3<S> d = p_BP1 - p_BP0;
+
+  // The parameters delimiting the pieces, in increasing order: the end points
+  // and the crossings of the face planes.
+  S pieces[8] = {0, 1};
+  int num_pieces = 2;
+  for (int i = 0; i < 3; ++i) {
+    if (d(i) == 0) continue;
+    for (const S bound : {-half_size(i), half_size(i)}) {
+      const S t = (bound - p_BP0(i)) / d(i);
+      if (!(t > 0 && t < 1)) continue;
+      int k = num_pieces++;
+      for (; pieces[k - 1] > t; --k) pieces[k] = pieces[k - 1];
+      pieces[k] = t;
+    }
+  }
+
+  S min_squared_distance = std::numeric_limits<S>::max();
+  for (int k = 0; k + 1 < num_pieces; ++k) {
+    const S t_a = pieces[k];
+    const S t_b = pieces[k + 1];
+    const S t_m = (t_a + t_b) / 2;
+
+    // The squared distance on the piece is a * t^2 + 2 * b * t + c.
+    S a = 0;
+    S b = 0;
+    for (int i = 0; i < 3; ++i) {
+      const S coordinate = p_BP0(i) + t_m * d(i);
+      S offset;
+      if (coordinate > half_size(i))
+        offset = p_BP0(i) - half_size(i);
+      else if (coordinate < -half_size(i))
+        offset = p_BP0(i) + half_size(i);
+      else
+        continue;
+      a += d(i) * d(i);
+      b += d(i) * offset;
+    }
+
+    S t = t_a;
+    if (a > 0) t = std::min(std::max(-b / a, t_a), t_b);
+
+    const Vector3<S> p_BP = p_BP0 + t * d;
+    Vector3<S> p_BN;
+    nearestPointInBox(size, p_BP, &p_BN);
+    const S squared_distance = (p_BP - p_BN).squaredNorm();
+    if (squared_distance < min_squared_distance) {
+      min_squared_distance = squared_distance;
+      *t_ptr = t;
+      *p_BN_ptr = p_BN;
+    }
+  }
+
+  return min_squared_distance;
+}
+
+//==============================================================================
+
+template <typename S>
+FCL_EXPORT bool capsuleBoxIntersect(const Capsule<S>& capsule,
+                                    const Transform3<S>& X_FC,
+                                    const Box<S>& box,
+                                    const Transform3<S>& X_FB,
+                                    std::vector<ContactPoint<S>>* contacts) {
+  const S r = capsule.radius;
+  // Find the end points of the core segment of the capsule in the box's frame.
+  const Transform3<S> X_BC = X_FB.inverse() * X_FC;
+  const Vector3<S> p_BP0 = X_BC * Vector3<S>(0, 0, -capsule.lz / 2);
+  const Vector3<S> p_BP1 = X_BC * Vector3<S>(0, 0, capsule.lz / 2);
+
+  S t;
+  Vector3<S> p_BN;
+  const S squared_distance =
+      nearestPointsSegmentBox(box.side, p_BP0, p_BP1, &t, &p_BN);
+  // The nearest point to the core segment is *farther* than radius, they are
+  // *not* penetrating.
+  if (squared_distance > r * r)
+    return false;
+
+  // Now we know they are colliding.
+
+  if (contacts != nullptr) {
+    S depth{0};
+    Vector3<S> n_CB_B; // Normal pointing from capsule into box (in box's frame)
+    Vector3<S> p_BP;   // Contact position (P) in the box frame.
+    // Same precision argument as for the sphere-box intersection.
+    constexpr auto eps = 16 * constants<S>::eps();
+    if (squared_distance > eps * eps) {
+      // The core segment is outside: the capsule acts as a sphere centered on
+      // the nearest point Q of the segment.
+      const Vector3<S> p_BQ = p_BP0 + t * (p_BP1 - p_BP0);
+      const S distance = sqrt(squared_distance);
+      n_CB_B = (p_BN - p_BQ) / distance;
+      depth = r - distance;
+      p_BP = p_BN + n_CB_B * (depth * 0.5);
+    } else {
+      // The core segment reaches the box. The candidate axes are the face
+      // normals and the cross products of the segment with the box edges; the
+      // overlap along any other direction is never smaller.
+      const Vector3<S> half_size = box.side / 2;
+      const Vector3<S> d = p_BP1 - p_BP0;
+      const Vector3<S> p_BM = (p_BP0 + p_BP1) / 2;
+      depth = std::numeric_limits<S>::max();
+      S box_extent{0};
+      auto test_axis = [&](const Vector3<S>& axis) {
+        const S extent = half_size.dot(axis.cwiseAbs());
+        const S center = axis.dot(p_BM);
+        const S overlap =
+            extent + std::abs(axis.dot(d)) / 2 + r - std::abs(center);
+        // To be preferred, the axis has to overlap more than epsilon less.
+        if (overlap + eps < depth) {
+          depth = overlap;
+          box_extent = extent;
+          n_CB_B = center >= 0 ? -axis : axis;
+        }
+      };
+      for (int i = 0; i < 3; ++i)
+        test_axis(Vector3<S>::Unit(i));
+      for (int i = 0; i < 3; ++i) {
+        const Vector3<S> axis = d.cross(Vector3<S>::Unit(i));
+        const S norm = axis.norm();
+        if (norm > eps)
+          test_axis(axis / norm);
+      }
+
+      // Clip the segment to the box; the deepest point of the clipped part
+      // along the normal (or its middle when it is parallel to the face) is
+      // moved midway between the box face and the deepest plane of the
+      // capsule.
+      S t0 = 0;
+      S t1 = 1;
+      for (int i = 0; i < 3; ++i) {
+        if (d(i) == 0) continue;
+        S t_a = (-half_size(i) - p_BP0(i)) / d(i);
+        S t_b = (half_size(i) - p_BP0(i)) / d(i);
+        if (t_a > t_b) std::swap(t_a, t_b);
+        t0 = std::max(t0, t_a);
+        t1 = std::min(t1, t_b);
+      }
+      if (t0 > t1) t0 = t1 = t;
+      const Vector3<S> p_BQ0 = p_BP0 + t0 * d;
+      const Vector3<S> p_BQ1 = p_BP0 + t1 * d;
+      const S s0 = n_CB_B.dot(p_BQ0);
+      const S s1 = n_CB_B.dot(p_BQ1);
+      Vector3<S> p_BQ;
+      if (std::abs(s0 - s1) <= eps)
+        p_BQ = (p_BQ0 + p_BQ1) / 2;
+      else
+        p_BQ = s0 > s1 ? p_BQ0 : p_BQ1;
+      const S mid_plane = -box_extent + depth / 2;
+      p_BP = p_BQ + n_CB_B * (mid_plane - n_CB_B.dot(p_BQ));
+    }
+    contacts->emplace_back(X_FB.linear() * n_CB_B, X_FB * p_BP, depth);
+  }
+  return true;
+}
+
+//==============================================================================
+
+template <typename S>
+FCL_EXPORT bool capsuleBoxDistance(const Capsule<S>& capsule,
+                                   const Transform3<S>& X_FC,
+                                   const Box<S>& box,
+                                   const Transform3<S>& X_FB, S* distance,
+                                   Vector3<S>* p_FCb, Vector3<S>* p_FBc) {
+  const S r = capsule.radius;
+  // Find the end points of the core segment of the capsule in the box's frame.
+  const Transform3<S> X_BC = X_FB.inverse() * X_FC;
+  const Vector3<S> p_BP0 = X_BC * Vector3<S>(0, 0, -capsule.lz / 2);
+  const Vector3<S> p_BP1 = X_BC * Vector3<S>(0, 0, capsule.lz / 2);
+
+  S t;
+  Vector3<S> p_BN;
+  const S squared_distance =
+      nearestPointsSegmentBox(box.side, p_BP0, p_BP1, &t, &p_BN);
+
+  if (squared_distance > r * r) {
+    // The distance to the nearest point is greater than the radius, we have
+    // proven separation.
+    const S d = sqrt(squared_distance);
+    const Vector3<S> p_BQ = p_BP0 + t * (p_BP1 - p_BP0);
+    if (distance != nullptr)
+      *distance = d - r;
+    if (p_FBc != nullptr)
+      *p_FBc = X_FB * p_BN;
+    if (p_FCb != nullptr)
+      *p_FCb = X_FB * (p_BQ + (p_BN - p_BQ) * (r / d));
+    return true;
+  }
+
+  // We didn't *prove* separation, so we must be in penetration.
+  if (distance != nullptr) *distance = -1;
+  return false;
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif // FCL_NARROWPHASE_DETAIL_CAPSULEBOX_INL_H
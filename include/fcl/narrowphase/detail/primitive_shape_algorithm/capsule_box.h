@@ -0,0 +1,117 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_CAPSULEBOX_H
+#define FCL_NARROWPHASE_DETAIL_CAPSULEBOX_H
+
+#include "fcl/geometry/shape/box.h"
+#include "fcl/geometry/shape/capsule.h"
+#include "fcl/narrowphase/contact_point.h"
+
+namespace fcl {
+
+namespace detail {
+
+/** @name       Custom capsule-box proximity algorithms
+
+ These functions provide custom algorithms for analyzing the relationship
+ between a capsule and a box. They follow the conventions of the sphere-box
+ algorithms: both shapes are posed in a common frame F, the outputs are
+ reported in F, and touching shapes are colliding (not separated).
+
+ A capsule is the set of points within its radius of its core segment, so both
+ queries reduce to the segment-box problem. The squared distance from the
+ segment to the box is a convex piecewise quadratic function of the segment
+ parameter, whose pieces are delimited by the parameters where the segment
+ crosses the planes of the box faces; it is minimized exactly, piece by piece.
+ When the core segment reaches the box, the penetration is given by the
+ separating axis test on the box face normals and on the cross products of the
+ segment with the box edges.
+ */
+
+//@{
+
+/** Detect collision between the capsule and box. If colliding, return
+ characterization of collision in the provided vector.
+
+ While the core segment of the capsule is outside of the box, the normal is
+ the direction from the nearest point of the segment to the box, and it is
+ continuous. Once the segment reaches the box, the normal is the axis of
+ minimum overlap; on ties, the box faces have priority over the edge axes.
+
+ @param capsule        The capsule geometry.
+ @param X_FC           The pose of the capsule C in the common frame F.
+ @param box            The box geometry.
+ @param X_FB           The pose of the box B in the common frame F.
+ @param contacts[out]  (optional) If the shapes collide, the contact point data
+                       will be appended to the end of this vector.
+ @return True if the objects are colliding (including touching).
+ @tparam S The scalar parameter (must be a valid Eigen scalar).  */
+template <typename S>
+FCL_EXPORT bool capsuleBoxIntersect(const Capsule<S>& capsule,
+                                    const Transform3<S>& X_FC,
+                                    const Box<S>& box,
+                                    const Transform3<S>& X_FB,
+                                    std::vector<ContactPoint<S>>* contacts);
+
+/** Evaluate the minimum separating distance between a capsule and box. If
+ separated, the nearest points on each shape will be returned in frame F.
+ @param capsule        The capsule geometry.
+ @param X_FC           The pose of the capsule C in the common frame F.
+ @param box            The box geometry.
+ @param X_FB           The pose of the box B in the common frame F.
+ @param distance[out]  (optional) The separating distance between the box
+                       and capsule. Set to -1 if the shapes are penetrating.
+ @param p_FCb[out]     (optional) The closest point on the *capsule* to the box
+                       measured and expressed in frame F.
+ @param p_FBc[out]     (optional) The closest point on the *box* to the capsule
+                       measured and expressed in frame F.
+ @return True if the objects are separated.
+ @tparam S The scalar parameter (must be a valid Eigen scalar).  */
+template <typename S>
+FCL_EXPORT bool capsuleBoxDistance(const Capsule<S>& capsule,
+                                   const Transform3<S>& X_FC,
+                                   const Box<S>& box,
+                                   const Transform3<S>& X_FB, S* distance,
+                                   Vector3<S>* p_FCb, Vector3<S>* p_FBc);
+
+//@}
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_box-inl.h"
+
+#endif // FCL_NARROWPHASE_DETAIL_CAPSULEBOX_H
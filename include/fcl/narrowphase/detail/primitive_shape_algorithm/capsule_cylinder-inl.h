@@ -0,0 +1,154 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_CAPSULECYLINDER_INL_H
+#define FCL_NARROWPHASE_DETAIL_CAPSULECYLINDER_INL_H
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_cylinder.h"
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/sphere_cylinder.h"
+
+namespace fcl {
+namespace detail {
+
+extern template FCL_EXPORT bool
+capsuleCylinderDistance(const Capsule<double>& capsule,
+                        const Transform3<double>& X_FC,
+                        const Cylinder<double>& cylinder,
+                        const Transform3<double>& X_FY, double* distance,
+                        Vector3<double>* p_FCy, Vector3<double>* p_FYc);
+
+//==============================================================================
+
+template <typename S>
+FCL_EXPORT bool capsuleCylinderDistance(const Capsule<S>& capsule,
+                                        const Transform3<S>& X_FC,
+                                        const Cylinder<S>& cylinder,
+                                        const Transform3<S>& X_FY, S* distance,
+                                        Vector3<S>* p_FCy, Vector3<S>* p_FYc) {
+  const S r = capsule.radius;
+  // Find the end points of the core segment of the capsule in the cylinder's
+  // frame.
+  const Transform3<S> X_YC = X_FY.inverse() * X_FC;
+  const Vector3<S> p_YP0 = X_YC * Vector3<S>(0, 0, -capsule.lz / 2);
+  const Vector3<S> d = X_YC.linear().col(2) * capsule.lz;
+
+  // The squared distance from P(t) = P0 + t * d to its nearest point N inside
+  // the cylinder; as the square of a non-negative convex function, it is
+  // convex.
+  auto squared_distance = [&](S t, Vector3<S>* p_YN) {
+    const Vector3<S> p_YP = p_YP0 + t * d;
+    nearestPointInCylinder(cylinder.lz, cylinder.radius, p_YP, p_YN);
+    return (p_YP - *p_YN).squaredNorm();
+  };
+
+  // The minimum may be at an end point, which the interior probes of the
+  // search only approach.
+  Vector3<S> p_YN;
+  S t_min = 0;
+  S min_squared_distance = squared_distance(0, &p_YN);
+  Vector3<S> p_YN1;
+  const S squared_distance1 = squared_distance(1, &p_YN1);
+  if (squared_distance1 < min_squared_distance) {
+    t_min = 1;
+    min_squared_distance = squared_distance1;
+    p_YN = p_YN1;
+  }
+
+  const S r_squared = r * r;
+  // 1 / φ, with φ the golden ratio
+  const S inv_phi = S(0.61803398874989484820);
+  const S tolerance = constants<S>::eps_34();
+  S a = 0;
+  S b = 1;
+  S t1 = b - inv_phi * (b - a);
+  S t2 = a + inv_phi * (b - a);
+  Vector3<S> p_YN_t1;
+  Vector3<S> p_YN_t2;
+  S f1 = squared_distance(t1, &p_YN_t1);
+  S f2 = squared_distance(t2, &p_YN_t2);
+  // Any probe within the radius proves that the shapes are not separated.
+  while (min_squared_distance > r_squared && f1 > r_squared && f2 > r_squared
+         && b - a > tolerance) {
+    if (f1 <= f2) {
+      b = t2;
+      t2 = t1;
+      f2 = f1;
+      p_YN_t2 = p_YN_t1;
+      t1 = b - inv_phi * (b - a);
+      f1 = squared_distance(t1, &p_YN_t1);
+    } else {
+      a = t1;
+      t1 = t2;
+      f1 = f2;
+      p_YN_t1 = p_YN_t2;
+      t2 = a + inv_phi * (b - a);
+      f2 = squared_distance(t2, &p_YN_t2);
+    }
+  }
+  if (f1 < min_squared_distance) {
+    t_min = t1;
+    min_squared_distance = f1;
+    p_YN = p_YN_t1;
+  }
+  if (f2 < min_squared_distance) {
+    t_min = t2;
+    min_squared_distance = f2;
+    p_YN = p_YN_t2;
+  }
+
+  if (min_squared_distance > r_squared) {
+    // The distance to the nearest point is greater than the radius, we have
+    // proven separation.
+    const S dist = sqrt(min_squared_distance);
+    const Vector3<S> p_YP = p_YP0 + t_min * d;
+    if (distance != nullptr)
+      *distance = dist - r;
+    if (p_FYc != nullptr)
+      *p_FYc = X_FY * p_YN;
+    if (p_FCy != nullptr)
+      *p_FCy = X_FY * (p_YP + (p_YN - p_YP) * (r / dist));
+    return true;
+  }
+
+  // We didn't *prove* separation, so we must be in penetration.
+  if (distance != nullptr) *distance = -1;
+  return false;
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif // FCL_NARROWPHASE_DETAIL_CAPSULECYLINDER_INL_H
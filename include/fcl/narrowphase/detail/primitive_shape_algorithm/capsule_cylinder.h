@@ -0,0 +1,89 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_CAPSULECYLINDER_H
+#define FCL_NARROWPHASE_DETAIL_CAPSULECYLINDER_H
+
+#include "fcl/geometry/shape/capsule.h"
+#include "fcl/geometry/shape/cylinder.h"
+
+namespace fcl {
+
+namespace detail {
+
+/** @name       Custom capsule-cylinder proximity algorithms
+
+ These functions provide custom algorithms for analyzing the relationship
+ between a capsule and a cylinder. They follow the conventions of the
+ sphere-cylinder algorithms: both shapes are posed in a common frame F, the
+ outputs are reported in F, and touching shapes are not separated.
+
+ The distance from a point to the cylinder is closed-form, and it is a convex
+ function of the position of the point, hence of the parameter of the core
+ segment of the capsule. Its minimum over the segment is found by golden
+ section search, to a parameter tolerance of ε^¾.
+ */
+
+//@{
+
+/** Evaluate the minimum separating distance between a capsule and cylinder. If
+ separated, the nearest points on each shape will be returned in frame F.
+ @param capsule        The capsule geometry.
+ @param X_FC           The pose of the capsule C in the common frame F.
+ @param cylinder       The cylinder geometry.
+ @param X_FY           The pose of the cylinder Y in the common frame F.
+ @param distance[out]  (optional) The separating distance between the capsule
+                       and cylinder. Set to -1 if the shapes are penetrating.
+ @param p_FCy[out]     (optional) The closest point on the *capsule* to the
+                       cylinder measured and expressed in frame F.
+ @param p_FYc[out]     (optional) The closest point on the *cylinder* to the
+                       capsule measured and expressed in frame F.
+ @return True if the objects are separated.
+ @tparam S The scalar parameter (must be a valid Eigen scalar).  */
+template <typename S>
+FCL_EXPORT bool capsuleCylinderDistance(const Capsule<S>& capsule,
+                                        const Transform3<S>& X_FC,
+                                        const Cylinder<S>& cylinder,
+                                        const Transform3<S>& X_FY, S* distance,
+                                        Vector3<S>* p_FCy, Vector3<S>* p_FYc);
+
+//@}
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_cylinder-inl.h"
+
+#endif // FCL_NARROWPHASE_DETAIL_CAPSULECYLINDER_H
@@ -0,0 +1,108 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_CYLINDERBOX_INL_H
+#define FCL_NARROWPHASE_DETAIL_CYLINDERBOX_INL_H
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/cylinder_box.h"
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_box.h"
+
+namespace fcl {
+namespace detail {
+
+extern template FCL_EXPORT bool
+cylinderBoxSeparated(const Cylinder<double>& cylinder,
+                     const Transform3<double>& X_FY, const Box<double>& box,
+                     const Transform3<double>& X_FB);
+
+//==============================================================================
+
+template <typename S>
+FCL_EXPORT bool cylinderBoxSeparated(const Cylinder<S>& cylinder,
+                                     const Transform3<S>& X_FY,
+                                     const Box<S>& box,
+                                     const Transform3<S>& X_FB) {
+  const S r = cylinder.radius;
+  const S half_height = cylinder.lz / 2;
+  const Vector3<S> half_size = box.side / 2;
+  // The center and axis of the cylinder in the box's frame.
+  const Transform3<S> X_BY = X_FB.inverse() * X_FY;
+  const Vector3<S> p_BY = X_BY.translation();
+  const Vector3<S> a_B = X_BY.linear().col(2);
+
+  auto separates = [&](const Vector3<S>& axis) {
+    const S box_extent = half_size.dot(axis.cwiseAbs());
+    const S cos_angle = axis.dot(a_B);
+    const S sin_angle_squared = std::max(S(0), 1 - cos_angle * cos_angle);
+    const S cylinder_extent =
+        std::abs(cos_angle) * half_height + r * sqrt(sin_angle_squared);
+    return std::abs(axis.dot(p_BY)) > box_extent + cylinder_extent;
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    if (separates(Vector3<S>::Unit(i))) return true;
+  }
+  if (separates(a_B)) return true;
+
+  constexpr auto eps = 16 * constants<S>::eps();
+  for (int i = 0; i < 3; ++i) {
+    const Vector3<S> axis = a_B.cross(Vector3<S>::Unit(i));
+    const S norm = axis.norm();
+    if (norm > eps && separates(axis / norm)) return true;
+  }
+
+  // The direction between the box and the nearest point of the axis segment
+  // separates the shapes whenever the nearest feature of the cylinder is its
+  // side.
+  S t;
+  Vector3<S> p_BN;
+  const Vector3<S> p_BP0 = p_BY - a_B * half_height;
+  const Vector3<S> p_BP1 = p_BY + a_B * half_height;
+  const S squared_distance =
+      nearestPointsSegmentBox(box.side, p_BP0, p_BP1, &t, &p_BN);
+  if (squared_distance > eps * eps) {
+    const Vector3<S> axis =
+        (p_BP0 + t * (p_BP1 - p_BP0) - p_BN) / sqrt(squared_distance);
+    if (separates(axis)) return true;
+  }
+
+  return false;
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif // FCL_NARROWPHASE_DETAIL_CYLINDERBOX_INL_H
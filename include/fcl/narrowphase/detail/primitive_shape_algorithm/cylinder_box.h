@@ -0,0 +1,80 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_CYLINDERBOX_H
+#define FCL_NARROWPHASE_DETAIL_CYLINDERBOX_H
+
+#include "fcl/geometry/shape/box.h"
+#include "fcl/geometry/shape/cylinder.h"
+
+namespace fcl {
+
+namespace detail {
+
+/** @name       Custom cylinder-box proximity algorithms
+
+ The boundary of a cylinder is curved, so no finite set of axes decides the
+ cylinder-box intersection. This test only proves separation: it projects
+ both shapes, posed in a common frame F, on the box face normals, on the
+ cylinder axis, on the cross products of the cylinder axis with the box edges
+ and on the direction from the box to the nearest point of the cylinder axis.
+ When none of them separates the shapes, the caller falls back to a general
+ algorithm (GJK/EPA).
+ */
+
+//@{
+
+/** Search a separating axis between the cylinder and box.
+ @param cylinder       The cylinder geometry.
+ @param X_FY           The pose of the cylinder Y in the common frame F.
+ @param box            The box geometry.
+ @param X_FB           The pose of the box B in the common frame F.
+ @return True if a separating axis was found: the objects are separated.
+         False if the test is inconclusive.
+ @tparam S The scalar parameter (must be a valid Eigen scalar).  */
+template <typename S>
+FCL_EXPORT bool cylinderBoxSeparated(const Cylinder<S>& cylinder,
+                                     const Transform3<S>& X_FY,
+                                     const Box<S>& box,
+                                     const Transform3<S>& X_FB);
+
+//@}
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/cylinder_box-inl.h"
+
+#endif // FCL_NARROWPHASE_DETAIL_CYLINDERBOX_H
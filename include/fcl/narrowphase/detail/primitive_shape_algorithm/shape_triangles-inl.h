@@ -0,0 +1,298 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_SHAPETRIANGLES_INL_H
+#define FCL_NARROWPHASE_DETAIL_SHAPETRIANGLES_INL_H
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/shape_triangles.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "fcl/math/constants.h"
+
+namespace fcl {
+namespace detail {
+
+extern template struct FCL_EXPORT TriangleBatch<double>;
+
+extern template FCL_EXPORT void
+boxTrianglesSeparated(const Box<double>& box, const Transform3<double>& X_FB,
+                      const TriangleBatch<double>& triangles,
+                      std::vector<unsigned char>* separated);
+
+extern template FCL_EXPORT void
+capsuleTrianglesSeparated(const Capsule<double>& capsule,
+                          const Transform3<double>& X_FC,
+                          const TriangleBatch<double>& triangles,
+                          std::vector<unsigned char>* separated);
+
+//==============================================================================
+template <typename S>
+void TriangleBatch<S>::clear() {
+  ax.clear(); ay.clear(); az.clear();
+  bx.clear(); by.clear(); bz.clear();
+  cx.clear(); cy.clear(); cz.clear();
+}
+
+//==============================================================================
+template <typename S>
+void TriangleBatch<S>::push_back(const Vector3<S>& a, const Vector3<S>& b,
+                                 const Vector3<S>& c) {
+  ax.push_back(a[0]); ay.push_back(a[1]); az.push_back(a[2]);
+  bx.push_back(b[0]); by.push_back(b[1]); bz.push_back(b[2]);
+  cx.push_back(c[0]); cy.push_back(c[1]); cz.push_back(c[2]);
+}
+
+//==============================================================================
+template <typename S>
+int TriangleBatch<S>::size() const {
+  return static_cast<int>(ax.size());
+}
+
+//==============================================================================
+// True if the projection [t_min, t_max] of a triangle on an axis is farther
+// than pad from the projection [s_min, s_max] of the shape. Written without
+// branches so that the loops calling it vectorize.
+template <typename S>
+inline bool intervalsSeparated(S t_min, S t_max, S s_min, S s_max, S pad) {
+  return (t_min > s_max + pad) | (t_max < s_min - pad);
+}
+
+//==============================================================================
+template <typename S>
+inline S min3(S a, S b, S c) {
+  return std::min(a, std::min(b, c));
+}
+
+//==============================================================================
+template <typename S>
+inline S max3(S a, S b, S c) {
+  return std::max(a, std::max(b, c));
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT void boxTrianglesSeparated(const Box<S>& box,
+                                      const Transform3<S>& X_FB,
+                                      const TriangleBatch<S>& triangles,
+                                      std::vector<unsigned char>* separated) {
+  const int n = triangles.size();
+  separated->resize(n);
+
+  const S h0 = box.side[0] / 2;
+  const S h1 = box.side[1] / 2;
+  const S h2 = box.side[2] / 2;
+  // Projections closer than this count as overlapping, so that the boxes
+  // touching a triangle are not reported separated because of round off.
+  const S tolerance = constants<S>::eps_12() * (1 + std::max(h0, std::max(h1, h2)));
+  const Matrix3<S>& R_FB = X_FB.linear();
+  const Vector3<S>& p_FB = X_FB.translation();
+
+  for (int i = 0; i < n; ++i) {
+    // The vertices measured and expressed in the box frame.
+    const S dax = triangles.ax[i] - p_FB[0];
+    const S day = triangles.ay[i] - p_FB[1];
+    const S daz = triangles.az[i] - p_FB[2];
+    const S dbx = triangles.bx[i] - p_FB[0];
+    const S dby = triangles.by[i] - p_FB[1];
+    const S dbz = triangles.bz[i] - p_FB[2];
+    const S dcx = triangles.cx[i] - p_FB[0];
+    const S dcy = triangles.cy[i] - p_FB[1];
+    const S dcz = triangles.cz[i] - p_FB[2];
+    const S a0 = R_FB(0, 0) * dax + R_FB(1, 0) * day + R_FB(2, 0) * daz;
+    const S a1 = R_FB(0, 1) * dax + R_FB(1, 1) * day + R_FB(2, 1) * daz;
+    const S a2 = R_FB(0, 2) * dax + R_FB(1, 2) * day + R_FB(2, 2) * daz;
+    const S b0 = R_FB(0, 0) * dbx + R_FB(1, 0) * dby + R_FB(2, 0) * dbz;
+    const S b1 = R_FB(0, 1) * dbx + R_FB(1, 1) * dby + R_FB(2, 1) * dbz;
+    const S b2 = R_FB(0, 2) * dbx + R_FB(1, 2) * dby + R_FB(2, 2) * dbz;
+    const S c0 = R_FB(0, 0) * dcx + R_FB(1, 0) * dcy + R_FB(2, 0) * dcz;
+    const S c1 = R_FB(0, 1) * dcx + R_FB(1, 1) * dcy + R_FB(2, 1) * dcz;
+    const S c2 = R_FB(0, 2) * dcx + R_FB(1, 2) * dcy + R_FB(2, 2) * dcz;
+
+    // The box face normals.
+    bool sep = intervalsSeparated(min3(a0, b0, c0), max3(a0, b0, c0), -h0, h0, tolerance);
+    sep |= intervalsSeparated(min3(a1, b1, c1), max3(a1, b1, c1), -h1, h1, tolerance);
+    sep |= intervalsSeparated(min3(a2, b2, c2), max3(a2, b2, c2), -h2, h2, tolerance);
+
+    // The triangle edges.
+    const S e00 = b0 - a0, e01 = b1 - a1, e02 = b2 - a2;
+    const S e10 = c0 - b0, e11 = c1 - b1, e12 = c2 - b2;
+    const S e20 = a0 - c0, e21 = a1 - c1, e22 = a2 - c2;
+
+    // The triangle normal. All the vertices share one projection.
+    const S n0 = e01 * e12 - e02 * e11;
+    const S n1 = e02 * e10 - e00 * e12;
+    const S n2 = e00 * e11 - e01 * e10;
+    const S n_abs0 = std::abs(n0), n_abs1 = std::abs(n1), n_abs2 = std::abs(n2);
+    const S n_extent = h0 * n_abs0 + h1 * n_abs1 + h2 * n_abs2;
+    const S n_proj = n0 * a0 + n1 * a1 + n2 * a2;
+    sep |= intervalsSeparated(n_proj, n_proj, -n_extent, n_extent,
+                              tolerance * (n_abs0 + n_abs1 + n_abs2));
+
+    // The cross products of the box axes with the triangle edges. With
+    // u_0 x e = (0, -e_2, e_1) etc., each projection only involves two of the
+    // coordinates.
+    auto edge_axes = [&](S f0, S f1, S f2) {
+      const S f_abs0 = std::abs(f0), f_abs1 = std::abs(f1), f_abs2 = std::abs(f2);
+      // u_0 x f
+      S pa = f2 * a1 - f1 * a2, pb = f2 * b1 - f1 * b2, pc = f2 * c1 - f1 * c2;
+      S r = h1 * f_abs2 + h2 * f_abs1;
+      bool s = intervalsSeparated(min3(pa, pb, pc), max3(pa, pb, pc), -r, r,
+                                  tolerance * (f_abs1 + f_abs2));
+      // u_1 x f
+      pa = f0 * a2 - f2 * a0; pb = f0 * b2 - f2 * b0; pc = f0 * c2 - f2 * c0;
+      r = h0 * f_abs2 + h2 * f_abs0;
+      s |= intervalsSeparated(min3(pa, pb, pc), max3(pa, pb, pc), -r, r,
+                              tolerance * (f_abs0 + f_abs2));
+      // u_2 x f
+      pa = f1 * a0 - f0 * a1; pb = f1 * b0 - f0 * b1; pc = f1 * c0 - f0 * c1;
+      r = h0 * f_abs1 + h1 * f_abs0;
+      s |= intervalsSeparated(min3(pa, pb, pc), max3(pa, pb, pc), -r, r,
+                              tolerance * (f_abs0 + f_abs1));
+      return s;
+    };
+    sep |= edge_axes(e00, e01, e02);
+    sep |= edge_axes(e10, e11, e12);
+    sep |= edge_axes(e20, e21, e22);
+
+    (*separated)[i] = sep;
+  }
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT void capsuleTrianglesSeparated(const Capsule<S>& capsule,
+                                          const Transform3<S>& X_FC,
+                                          const TriangleBatch<S>& triangles,
+                                          std::vector<unsigned char>* separated) {
+  using std::sqrt;
+
+  const int n = triangles.size();
+  separated->resize(n);
+
+  const S radius = capsule.radius;
+  const S half_length = capsule.lz / 2;
+  const S tolerance = constants<S>::eps_12() * (1 + radius + half_length);
+  // The end points P and Q of the capsule's core segment, in frame F.
+  const Vector3<S> p_FP = X_FC * Vector3<S>(0, 0, -half_length);
+  const Vector3<S> p_FQ = X_FC * Vector3<S>(0, 0, half_length);
+  const Vector3<S> d = p_FQ - p_FP;
+  const S pad = radius + tolerance;
+
+  for (int i = 0; i < n; ++i) {
+    const S a0 = triangles.ax[i], a1 = triangles.ay[i], a2 = triangles.az[i];
+    const S b0 = triangles.bx[i], b1 = triangles.by[i], b2 = triangles.bz[i];
+    const S c0 = triangles.cx[i], c1 = triangles.cy[i], c2 = triangles.cz[i];
+
+    // The frame axes.
+    bool sep = intervalsSeparated(min3(a0, b0, c0), max3(a0, b0, c0),
+                                  std::min(p_FP[0], p_FQ[0]),
+                                  std::max(p_FP[0], p_FQ[0]), pad);
+    sep |= intervalsSeparated(min3(a1, b1, c1), max3(a1, b1, c1),
+                              std::min(p_FP[1], p_FQ[1]),
+                              std::max(p_FP[1], p_FQ[1]), pad);
+    sep |= intervalsSeparated(min3(a2, b2, c2), max3(a2, b2, c2),
+                              std::min(p_FP[2], p_FQ[2]),
+                              std::max(p_FP[2], p_FQ[2]), pad);
+
+    const S e00 = b0 - a0, e01 = b1 - a1, e02 = b2 - a2;
+    const S e10 = c0 - b0, e11 = c1 - b1, e12 = c2 - b2;
+    const S e20 = a0 - c0, e21 = a1 - c1, e22 = a2 - c2;
+
+    // The triangle normal.
+    const S n0 = e01 * e12 - e02 * e11;
+    const S n1 = e02 * e10 - e00 * e12;
+    const S n2 = e00 * e11 - e01 * e10;
+    const S n_norm = sqrt(n0 * n0 + n1 * n1 + n2 * n2);
+    const S n_proj = n0 * a0 + n1 * a1 + n2 * a2;
+    const S n_p = n0 * p_FP[0] + n1 * p_FP[1] + n2 * p_FP[2];
+    const S n_q = n0 * p_FQ[0] + n1 * p_FQ[1] + n2 * p_FQ[2];
+    sep |= intervalsSeparated(n_proj, n_proj, std::min(n_p, n_q),
+                              std::max(n_p, n_q), pad * n_norm);
+
+    // The cross products of the core segment with the triangle edges; the
+    // whole segment projects on a single value.
+    auto edge_axis = [&](S f0, S f1, S f2) {
+      const S g0 = d[1] * f2 - d[2] * f1;
+      const S g1 = d[2] * f0 - d[0] * f2;
+      const S g2 = d[0] * f1 - d[1] * f0;
+      const S g_norm = sqrt(g0 * g0 + g1 * g1 + g2 * g2);
+      const S pa = g0 * a0 + g1 * a1 + g2 * a2;
+      const S pb = g0 * b0 + g1 * b1 + g2 * b2;
+      const S pc = g0 * c0 + g1 * c1 + g2 * c2;
+      const S s = g0 * p_FP[0] + g1 * p_FP[1] + g2 * p_FP[2];
+      return intervalsSeparated(min3(pa, pb, pc), max3(pa, pb, pc), s, s,
+                                pad * g_norm);
+    };
+    sep |= edge_axis(e00, e01, e02);
+    sep |= edge_axis(e10, e11, e12);
+    sep |= edge_axis(e20, e21, e22);
+
+    (*separated)[i] = sep;
+  }
+}
+
+//==============================================================================
+template <typename S, typename Shape>
+FCL_EXPORT void shapeTrianglesSeparated(const Shape& /*shape*/,
+                                        const Transform3<S>& /*X_FS*/,
+                                        const TriangleBatch<S>& triangles,
+                                        std::vector<unsigned char>* separated) {
+  separated->assign(triangles.size(), 0);
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT void shapeTrianglesSeparated(const Box<S>& box,
+                                        const Transform3<S>& X_FB,
+                                        const TriangleBatch<S>& triangles,
+                                        std::vector<unsigned char>* separated) {
+  boxTrianglesSeparated(box, X_FB, triangles, separated);
+}
+
+//==============================================================================
+template <typename S>
+FCL_EXPORT void shapeTrianglesSeparated(const Capsule<S>& capsule,
+                                        const Transform3<S>& X_FC,
+                                        const TriangleBatch<S>& triangles,
+                                        std::vector<unsigned char>* separated) {
+  capsuleTrianglesSeparated(capsule, X_FC, triangles, separated);
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif // FCL_NARROWPHASE_DETAIL_SHAPETRIANGLES_INL_H
@@ -0,0 +1,149 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_DETAIL_SHAPETRIANGLES_H
+#define FCL_NARROWPHASE_DETAIL_SHAPETRIANGLES_H
+
+#include <type_traits>
+#include <vector>
+
+#include "fcl/geometry/shape/box.h"
+#include "fcl/geometry/shape/capsule.h"
+
+namespace fcl {
+
+namespace detail {
+
+/** @name       Batched shape-triangle separation tests
+
+ Testing one shape against the many triangles of a mesh subtree one pair at a
+ time pays the set up of a full GJK run per triangle, even though most of the
+ triangles are separated from the shape. These tests take the triangles as a
+ structure of arrays and run the same branch-free separating axis tests over
+ all of them in one loop, so the compiler can vectorize it. The triangles the
+ test does not reject are left to the per-triangle narrowphase.
+ */
+
+//@{
+
+/// @brief A set of triangles stored as a structure of arrays, one array per
+/// vertex coordinate.
+template <typename S>
+struct FCL_EXPORT TriangleBatch
+{
+  /// @brief Remove all the triangles, keeping the storage
+  void clear();
+
+  /// @brief Append the triangle (a, b, c)
+  void push_back(const Vector3<S>& a, const Vector3<S>& b, const Vector3<S>& c);
+
+  /// @brief Number of triangles
+  int size() const;
+
+  std::vector<S> ax, ay, az;
+  std::vector<S> bx, by, bz;
+  std::vector<S> cx, cy, cz;
+};
+
+/** Test the box against every triangle of the batch with the 13 axes of the
+ box-triangle separating axis theorem. The test is exact: a triangle which is
+ not marked separated intersects (or touches) the box.
+ @param box            The box geometry.
+ @param X_FB           The pose of the box B in the frame F of the triangles.
+ @param triangles      The triangles, measured and expressed in frame F.
+ @param separated      Set to the size of the batch; element i is non-zero iff
+                       the box is separated from triangle i.
+ @tparam S The scalar parameter (must be a valid Eigen scalar).  */
+template <typename S>
+FCL_EXPORT void boxTrianglesSeparated(const Box<S>& box,
+                                      const Transform3<S>& X_FB,
+                                      const TriangleBatch<S>& triangles,
+                                      std::vector<unsigned char>* separated);
+
+/** Test the capsule against every triangle of the batch on the frame axes,
+ the triangle normal and the cross products of the capsule axis with the
+ triangle edges. The test is conservative: only the triangles marked
+ separated are proven separated from the capsule.
+ @param capsule        The capsule geometry.
+ @param X_FC           The pose of the capsule C in the frame F of the
+                       triangles.
+ @param triangles      The triangles, measured and expressed in frame F.
+ @param separated      Set to the size of the batch; element i is non-zero if
+                       the capsule is separated from triangle i.
+ @tparam S The scalar parameter (must be a valid Eigen scalar).  */
+template <typename S>
+FCL_EXPORT void capsuleTrianglesSeparated(const Capsule<S>& capsule,
+                                          const Transform3<S>& X_FC,
+                                          const TriangleBatch<S>& triangles,
+                                          std::vector<unsigned char>* separated);
+
+/// @brief Whether Shape has a batched triangle test, shapeTrianglesSeparated()
+template <typename Shape>
+struct ShapeTrianglesBatchable : std::false_type {};
+
+template <typename S>
+struct ShapeTrianglesBatchable<Box<S>> : std::true_type {};
+
+template <typename S>
+struct ShapeTrianglesBatchable<Capsule<S>> : std::true_type {};
+
+/// @brief Dispatch to the batched test of the shape. The shapes without one
+/// (ShapeTrianglesBatchable is false) mark no triangle separated.
+template <typename S, typename Shape>
+FCL_EXPORT void shapeTrianglesSeparated(const Shape& shape,
+                                        const Transform3<S>& X_FS,
+                                        const TriangleBatch<S>& triangles,
+                                        std::vector<unsigned char>* separated);
+
+template <typename S>
+FCL_EXPORT void shapeTrianglesSeparated(const Box<S>& box,
+                                        const Transform3<S>& X_FB,
+                                        const TriangleBatch<S>& triangles,
+                                        std::vector<unsigned char>* separated);
+
+template <typename S>
+FCL_EXPORT void shapeTrianglesSeparated(const Capsule<S>& capsule,
+                                        const Transform3<S>& X_FC,
+                                        const TriangleBatch<S>& triangles,
+                                        std::vector<unsigned char>* separated);
+
+//@}
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/shape_triangles-inl.h"
+
+#endif // FCL_NARROWPHASE_DETAIL_SHAPETRIANGLES_H
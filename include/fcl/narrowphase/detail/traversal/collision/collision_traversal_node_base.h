@@ -62,6 +62,11 @@ public:
   /// @brief Leaf test between node b1 and b2, if they are both leafs
   virtual void leafTesting(int b1, int b2) const;
 
+  /// @brief Leaf test all the leaves below node b1 and b2 at once, after
+  /// their BVs overlapped. Return false, without testing anything, if the two
+  /// nodes have to be traversed one level at a time instead.
+  virtual bool batchLeafTesting(int b1, int b2) const;
+
   /// @brief Check whether the traversal can stop
   virtual bool canStop() const;
 
@@ -127,76 +127,23 @@ void MeshCollisionTraversalNode<BV>::leafTesting(int b1, int b2) const
 {
   if(this->enable_statistics) this->num_leaf_tests++;
 
-  const BVNode<BV>& node1 = this->model1->getBV(b1);
-  const BVNode<BV>& node2 = this->model2->getBV(b2);
-
-  int primitive_id1 = node1.primitiveId();
-  int primitive_id2 = node2.primitiveId();
-
-  const Triangle& tri_id1 = tri_indices1[primitive_id1];
-  const Triangle& tri_id2 = tri_indices2[primitive_id2];
-
-  const Vector3<S>& p1 = vertices1[tri_id1[0]];
-  const Vector3<S>& p2 = vertices1[tri_id1[1]];
-  const Vector3<S>& p3 = vertices1[tri_id1[2]];
-  const Vector3<S>& q1 = vertices2[tri_id2[0]];
-  const Vector3<S>& q2 = vertices2[tri_id2[1]];
-  const Vector3<S>& q3 = vertices2[tri_id2[2]];
-
-  if(this->model1->isOccupied() && this->model2->isOccupied())
-  {
-    bool is_intersect = false;
-
-    if(!this->request.enable_contact) // only interested in collision or not
-    {
-      if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3))
-      {
-        is_intersect = true;
-        if(this->result->numContacts() < this->request.num_max_contacts)
-          this->result->addContact(Contact<S>(this->model1, this->model2, primitive_id1, primitive_id2));
-      }
-    }
-    else // need compute the contact information
-    {
-      S penetration;
-      Vector3<S> normal;
-      unsigned int n_contacts;
-      Vector3<S> contacts[2];
-
-      if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3,
-                                       contacts,
-                                       &n_contacts,
-                                       &penetration,
-                                       &normal))
-      {
-        is_intersect = true;
-
-        if(this->request.num_max_contacts < n_contacts + this->result->numContacts())
-          n_contacts = (this->request.num_max_contacts >= this->result->numContacts()) ? (this->request.num_max_contacts - this->result->numContacts()) : 0;
-
-        for(unsigned int i = 0; i < n_contacts; ++i)
-        {
-          this->result->addContact(Contact<S>(this->model1, this->model2, primitive_id1, primitive_id2, contacts[i], normal, penetration));
-        }
-      }
-    }
-
-    if(is_intersect && this->request.enable_cost)
-    {
-      AABB<S> overlap_part;
-      AABB<S>(p1, p2, p3).overlap(AABB<S>(q1, q2, q3), overlap_part);
-      this->result->addCostSource(CostSource<S>(overlap_part, cost_density), this->request.num_max_cost_sources);
-    }
-  }
-  else if((!this->model1->isFree() && !this->model2->isFree()) && this->request.enable_cost)
-  {
-    if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3))
-    {
-      AABB<S> overlap_part;
-      AABB<S>(p1, p2, p3).overlap(AABB<S>(q1, q2, q3), overlap_part);
-      this->result->addCostSource(CostSource<S>(overlap_part, cost_density), this->request.num_max_cost_sources);
-    }
-  }
+  // initialize() moves both models to the world frame
+  meshCollisionTriangleLeafTesting<S>(
+        this->model1->getBV(b1).primitiveId(),
+        this->model2->getBV(b2).primitiveId(),
+        this->model1,
+        this->model2,
+        vertices1,
+        vertices2,
+        tri_indices1,
+        tri_indices2,
+        Matrix3<S>::Identity(),
+        Vector3<S>::Zero(),
+        this->tf1,
+        this->tf2,
+        cost_density,
+        this->request,
+        *this->result);
 }
 
 //==============================================================================
@@ -523,35 +470,24 @@ void MeshCollisionTraversalNodeOBBRSS<S>::leafTesting(int b1, int b2) const
         *this->result);
 }
 
-template <typename BV>
-void meshCollisionOrientedNodeLeafTesting(
-    int b1, int b2,
-    const BVHModel<BV>* model1,
-    const BVHModel<BV>* model2,
-    Vector3<typename BV::S>* vertices1,
-    Vector3<typename BV::S>* vertices2,
-    Triangle* tri_indices1,
-    Triangle* tri_indices2,
-    const Matrix3<typename BV::S>& R,
-    const Vector3<typename BV::S>& T,
-    const Transform3<typename BV::S>& tf1,
-    const Transform3<typename BV::S>& tf2,
-    bool enable_statistics,
-    typename BV::S cost_density,
-    int& num_leaf_tests,
-    const CollisionRequest<typename BV::S>& request,
-    CollisionResult<typename BV::S>& result)
+template <typename S>
+void meshCollisionTriangleLeafTesting(
+    int primitive_id1,
+    int primitive_id2,
+    const CollisionGeometry<S>* model1,
+    const CollisionGeometry<S>* model2,
+    const Vector3<S>* vertices1,
+    const Vector3<S>* vertices2,
+    const Triangle* tri_indices1,
+    const Triangle* tri_indices2,
+    const Matrix3<S>& R,
+    const Vector3<S>& T,
+    const Transform3<S>& tf1,
+    const Transform3<S>& tf2,
+    S cost_density,
+    const CollisionRequest<S>& request,
+    CollisionResult<S>& result)
 {
-  using S = typename BV::S;
-
-  if(enable_statistics) num_leaf_tests++;
-
-  const BVNode<BV>& node1 = model1->getBV(b1);
-  const BVNode<BV>& node2 = model2->getBV(b2);
-
-  int primitive_id1 = node1.primitiveId();
-  int primitive_id2 = node2.primitiveId();
-
   const Triangle& tri_id1 = tri_indices1[primitive_id1];
   const Triangle& tri_id2 = tri_indices2[primitive_id2];
 
@@ -622,15 +558,15 @@ void meshCollisionOrientedNodeLeafTesting(
 //==============================================================================
 template <typename BV>
 void meshCollisionOrientedNodeLeafTesting(
-    int b1,
-    int b2,
+    int b1, int b2,
     const BVHModel<BV>* model1,
     const BVHModel<BV>* model2,
     Vector3<typename BV::S>* vertices1,
     Vector3<typename BV::S>* vertices2,
     Triangle* tri_indices1,
     Triangle* tri_indices2,
-    const Transform3<typename BV::S>& tf,
+    const Matrix3<typename BV::S>& R,
+    const Vector3<typename BV::S>& T,
     const Transform3<typename BV::S>& tf1,
     const Transform3<typename BV::S>& tf2,
     bool enable_statistics,
@@ -643,73 +579,64 @@ void meshCollisionOrientedNodeLeafTesting(
 
   if(enable_statistics) num_leaf_tests++;
 
-  const BVNode<BV>& node1 = model1->getBV(b1);
-  const BVNode<BV>& node2 = model2->getBV(b2);
-
-  int primitive_id1 = node1.primitiveId();
-  int primitive_id2 = node2.primitiveId();
-
-  const Triangle& tri_id1 = tri_indices1[primitive_id1];
-  const Triangle& tri_id2 = tri_indices2[primitive_id2];
-
-  const Vector3<S>& p1 = vertices1[tri_id1[0]];
-  const Vector3<S>& p2 = vertices1[tri_id1[1]];
-  const Vector3<S>& p3 = vertices1[tri_id1[2]];
-  const Vector3<S>& q1 = vertices2[tri_id2[0]];
-  const Vector3<S>& q2 = vertices2[tri_id2[1]];
-  const Vector3<S>& q3 = vertices2[tri_id2[2]];
-
-  if(model1->isOccupied() && model2->isOccupied())
-  {
-    bool is_intersect = false;
-
-    if(!request.enable_contact) // only interested in collision or not
-    {
-      if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3, tf))
-      {
-        is_intersect = true;
-        if(result.numContacts() < request.num_max_contacts)
-          result.addContact(Contact<S>(model1, model2, primitive_id1, primitive_id2));
-      }
-    }
-    else // need compute the contact information
-    {
-      S penetration;
-      Vector3<S> normal;
-      unsigned int n_contacts;
-      Vector3<S> contacts[2];
-
-      if(Intersect<S>::intersect_Triangle(
-           p1, p2, p3, q1, q2, q3, tf, contacts, &n_contacts, &penetration, &normal))
-      {
-        is_intersect = true;
+  meshCollisionTriangleLeafTesting<S>(
+        model1->getBV(b1).primitiveId(),
+        model2->getBV(b2).primitiveId(),
+        model1,
+        model2,
+        vertices1,
+        vertices2,
+        tri_indices1,
+        tri_indices2,
+        R,
+        T,
+        tf1,
+        tf2,
+        cost_density,
+        request,
+        result);
+}
 
-        if(request.num_max_contacts < result.numContacts() + n_contacts)
-          n_contacts = (request.num_max_contacts > result.numContacts()) ? (request.num_max_contacts - result.numContacts()) : 0;
+//==============================================================================
+template <typename BV>
+void meshCollisionOrientedNodeLeafTesting(
+    int b1,
+    int b2,
+    const BVHModel<BV>* model1,
+    const BVHModel<BV>* model2,
+    Vector3<typename BV::S>* vertices1,
+    Vector3<typename BV::S>* vertices2,
+    Triangle* tri_indices1,
+    Triangle* tri_indices2,
+    const Transform3<typename BV::S>& tf,
+    const Transform3<typename BV::S>& tf1,
+    const Transform3<typename BV::S>& tf2,
+    bool enable_statistics,
+    typename BV::S cost_density,
+    int& num_leaf_tests,
+    const CollisionRequest<typename BV::S>& request,
+    CollisionResult<typename BV::S>& result)
+{
+  using S = typename BV::S;
 
-        for(unsigned int i = 0; i < n_contacts; ++i)
-        {
-          result.addContact(Contact<S>(model1, model2, primitive_id1, primitive_id2, tf1 * contacts[i], tf1.linear() * normal, penetration));
-        }
-      }
-    }
+  if(enable_statistics) num_leaf_tests++;
 
-    if(is_intersect && request.enable_cost)
-    {
-      AABB<S> overlap_part;
-      AABB<S>(tf1 * p1, tf1 * p2, tf1 * p3).overlap(AABB<S>(tf2 * q1, tf2 * q2, tf2 * q3), overlap_part);
-      result.addCostSource(CostSource<S>(overlap_part, cost_density), request.num_max_cost_sources);
-    }
-  }
-  else if((!model1->isFree() && !model2->isFree()) && request.enable_cost)
-  {
-    if(Intersect<S>::intersect_Triangle(p1, p2, p3, q1, q2, q3, tf))
-    {
-      AABB<S> overlap_part;
-      AABB<S>(tf1 * p1, tf1 * p2, tf1 * p3).overlap(AABB<S>(tf2 * q1, tf2 * q2, tf2 * q3), overlap_part);
-      result.addCostSource(CostSource<S>(overlap_part, cost_density), request.num_max_cost_sources);
-    }
-  }
+  meshCollisionTriangleLeafTesting<S>(
+        model1->getBV(b1).primitiveId(),
+        model2->getBV(b2).primitiveId(),
+        model1,
+        model2,
+        vertices1,
+        vertices2,
+        tri_indices1,
+        tri_indices2,
+        tf.linear(),
+        tf.translation(),
+        tf1,
+        tf2,
+        cost_density,
+        request,
+        result);
 }
 
 template<typename BV, typename OrientedNode>
@@ -242,6 +242,30 @@ bool initialize(
     const CollisionRequest<S>& request,
     CollisionResult<S>& result);
 
+/// @brief Test a pair of triangles and record the contacts and cost sources
+/// in result. The triangles of model2 are moved into the frame of model1 by
+/// (R, T), and tf1 and tf2 bring the triangles of model1 and model2 to the
+/// world frame. This is the leaf test of every mesh-mesh collision node,
+/// whatever the layout of its hierarchy.
+template <typename S>
+FCL_EXPORT
+void meshCollisionTriangleLeafTesting(
+    int primitive_id1,
+    int primitive_id2,
+    const CollisionGeometry<S>* model1,
+    const CollisionGeometry<S>* model2,
+    const Vector3<S>* vertices1,
+    const Vector3<S>* vertices2,
+    const Triangle* tri_indices1,
+    const Triangle* tri_indices2,
+    const Matrix3<S>& R,
+    const Vector3<S>& T,
+    const Transform3<S>& tf1,
+    const Transform3<S>& tf2,
+    S cost_density,
+    const CollisionRequest<S>& request,
+    CollisionResult<S>& result);
+
 template <typename BV>
 FCL_EXPORT
 void meshCollisionOrientedNodeLeafTesting(
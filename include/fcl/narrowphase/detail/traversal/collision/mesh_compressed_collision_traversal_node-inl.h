@@ -0,0 +1,264 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_TRAVERSAL_MESHCOMPRESSEDCOLLISIONTRAVERSALNODE_INL_H
+#define FCL_TRAVERSAL_MESHCOMPRESSEDCOLLISIONTRAVERSALNODE_INL_H
+
+#include "fcl/narrowphase/detail/traversal/collision/mesh_compressed_collision_traversal_node.h"
+
+#include "fcl/math/bv/OBB.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+template <typename BV, typename Q>
+MeshCompressedCollisionTraversalNode<BV, Q>::MeshCompressedCollisionTraversalNode()
+  : CollisionTraversalNodeBase<typename BV::S>()
+{
+  model1 = nullptr;
+  model2 = nullptr;
+
+  num_bv_tests = 0;
+  num_leaf_tests = 0;
+  query_time_seconds = 0.0;
+
+  R.setIdentity();
+  T.setZero();
+  R_box.setIdentity();
+  T_box.setZero();
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+bool MeshCompressedCollisionTraversalNode<BV, Q>::isFirstNodeLeaf(int b) const
+{
+  return model1->getBV(b).isLeaf();
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+bool MeshCompressedCollisionTraversalNode<BV, Q>::isSecondNodeLeaf(int b) const
+{
+  return model2->getBV(b).isLeaf();
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+bool MeshCompressedCollisionTraversalNode<BV, Q>::firstOverSecond(
+    const AABB<float>& box1, int b1, const AABB<float>& box2, int b2) const
+{
+  bool l1 = model1->getBV(b1).isLeaf();
+  bool l2 = model2->getBV(b2).isLeaf();
+
+  if(l2 || (!l1 && (box1.size() > box2.size())))
+    return true;
+  return false;
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+int MeshCompressedCollisionTraversalNode<BV, Q>::getFirstLeftChild(int b) const
+{
+  return model1->getBV(b).leftChild();
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+int MeshCompressedCollisionTraversalNode<BV, Q>::getFirstRightChild(int b) const
+{
+  return model1->getBV(b).rightChild();
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+int MeshCompressedCollisionTraversalNode<BV, Q>::getSecondLeftChild(int b) const
+{
+  return model2->getBV(b).leftChild();
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+int MeshCompressedCollisionTraversalNode<BV, Q>::getSecondRightChild(int b) const
+{
+  return model2->getBV(b).rightChild();
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+bool MeshCompressedCollisionTraversalNode<BV, Q>::BVTesting(
+    const AABB<float>& box1, const AABB<float>& box2) const
+{
+  if(this->enable_statistics) num_bv_tests++;
+
+  const Vector3<S> c1 = box1.center().template cast<S>();
+  const Vector3<S> c2 = box2.center().template cast<S>();
+
+  // The extents are computed in S from the float bounds, so that no rounding
+  // makes the decoded boxes smaller
+  Vector3<S> a, b;
+  for(int j = 0; j < 3; ++j)
+  {
+    a[j] = 0.5 * (static_cast<S>(box1.max_[j]) - static_cast<S>(box1.min_[j]));
+    b[j] = 0.5 * (static_cast<S>(box2.max_[j]) - static_cast<S>(box2.min_[j]));
+  }
+
+  const Vector3<S> t = R_box * c2 + T_box - c1;
+
+  return obbDisjoint(R_box, t, a, b);
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+void MeshCompressedCollisionTraversalNode<BV, Q>::leafTesting(int b1, int b2) const
+{
+  if(this->enable_statistics) num_leaf_tests++;
+
+  meshCollisionTriangleLeafTesting<S>(
+        model1->getBV(b1).primitiveId(),
+        model2->getBV(b2).primitiveId(),
+        model1,
+        model2,
+        model1->vertices.data(),
+        model2->vertices.data(),
+        model1->tri_indices.data(),
+        model2->tri_indices.data(),
+        R,
+        T,
+        this->tf1,
+        this->tf2,
+        cost_density,
+        this->request,
+        *this->result);
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+bool MeshCompressedCollisionTraversalNode<BV, Q>::canStop() const
+{
+  return this->request.isSatisfied(*(this->result));
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+bool initialize(
+    MeshCompressedCollisionTraversalNode<BV, Q>& node,
+    const BVHCompressed<BV, Q>& model1,
+    const Transform3<typename BV::S>& tf1,
+    const BVHCompressed<BV, Q>& model2,
+    const Transform3<typename BV::S>& tf2,
+    const CollisionRequest<typename BV::S>& request,
+    CollisionResult<typename BV::S>& result)
+{
+  if(model1.getNumBVs() == 0 || model2.getNumBVs() == 0)
+    return false;
+
+  node.model1 = &model1;
+  node.tf1 = tf1;
+  node.model2 = &model2;
+  node.tf2 = tf2;
+
+  node.request = request;
+  node.result = &result;
+
+  node.cost_density = model1.cost_density * model2.cost_density;
+
+  node.R.noalias() = tf1.linear().transpose() * tf2.linear();
+  node.T.noalias() = tf1.linear().transpose() * (tf2.translation() - tf1.translation());
+
+  node.R_box.noalias() = model1.getAxis().transpose() * node.R * model2.getAxis();
+  node.T_box.noalias() = model1.getAxis().transpose() * node.T;
+
+  return true;
+}
+
+//==============================================================================
+template <typename BV, typename Q>
+void collisionRecurse(
+    MeshCompressedCollisionTraversalNode<BV, Q>* node,
+    int b1, const AABB<float>& box1,
+    int b2, const AABB<float>& box2)
+{
+  bool l1 = node->isFirstNodeLeaf(b1);
+  bool l2 = node->isSecondNodeLeaf(b2);
+
+  if(l1 && l2)
+  {
+    if(node->BVTesting(box1, box2)) return;
+
+    node->leafTesting(b1, b2);
+    return;
+  }
+
+  if(node->BVTesting(box1, box2))
+    return;
+
+  if(node->firstOverSecond(box1, b1, box2, b2))
+  {
+    int c1 = node->getFirstLeftChild(b1);
+    int c2 = node->getFirstRightChild(b1);
+
+    AABB<float> child;
+    node->model1->decodeBox(c1, box1, child);
+    collisionRecurse(node, c1, child, b2, box2);
+
+    if(node->canStop()) return;
+
+    node->model1->decodeBox(c2, box1, child);
+    collisionRecurse(node, c2, child, b2, box2);
+  }
+  else
+  {
+    int c1 = node->getSecondLeftChild(b2);
+    int c2 = node->getSecondRightChild(b2);
+
+    AABB<float> child;
+    node->model2->decodeBox(c1, box2, child);
+    collisionRecurse(node, b1, box1, c1, child);
+
+    if(node->canStop()) return;
+
+    node->model2->decodeBox(c2, box2, child);
+    collisionRecurse(node, b1, box1, c2, child);
+  }
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_TRAVERSAL_MESHCOMPRESSEDCOLLISIONTRAVERSALNODE_H
+#define FCL_TRAVERSAL_MESHCOMPRESSEDCOLLISIONTRAVERSALNODE_H
+
+#include "fcl/geometry/bvh/BVH_compressed.h"
+#include "fcl/narrowphase/contact.h"
+#include "fcl/narrowphase/cost_source.h"
+#include "fcl/narrowphase/detail/traversal/collision/intersect.h"
+#include "fcl/narrowphase/detail/traversal/collision/collision_traversal_node_base.h"
+#include "fcl/narrowphase/detail/traversal/collision/mesh_collision_traversal_node.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Traversal node for collision between two compressed meshes.
+///
+/// The boxes of the nodes are not stored explicitly, so BV testing works on
+/// the boxes decoded by the recursion (see collisionRecurse below). Both boxes
+/// are axis-aligned in the shared frame of their model, which makes the test
+/// an OBB test with a rotation that is constant for the whole traversal.
+template <typename BV, typename Q>
+class FCL_EXPORT MeshCompressedCollisionTraversalNode
+    : public CollisionTraversalNodeBase<typename BV::S>
+{
+public:
+
+  using S = typename BV::S;
+
+  MeshCompressedCollisionTraversalNode();
+
+  /// @brief Whether the BV node in the first BVH tree is leaf
+  bool isFirstNodeLeaf(int b) const;
+
+  /// @brief Whether the BV node in the second BVH tree is leaf
+  bool isSecondNodeLeaf(int b) const;
+
+  /// @brief Determine the traversal order, is the first BVTT subtree better
+  bool firstOverSecond(const AABB<float>& box1, int b1,
+                       const AABB<float>& box2, int b2) const;
+
+  /// @brief Get the left child of the node b in the first tree
+  int getFirstLeftChild(int b) const;
+
+  /// @brief Get the right child of the node b in the first tree
+  int getFirstRightChild(int b) const;
+
+  /// @brief Get the left child of the node b in the second tree
+  int getSecondLeftChild(int b) const;
+
+  /// @brief Get the right child of the node b in the second tree
+  int getSecondRightChild(int b) const;
+
+  /// @brief BV culling test between two decoded boxes
+  bool BVTesting(const AABB<float>& box1, const AABB<float>& box2) const;
+
+  /// @brief Intersection testing between leaves (two triangles)
+  void leafTesting(int b1, int b2) const;
+
+  /// @brief Whether the traversal process can stop early
+  bool canStop() const;
+
+  /// @brief The first compressed model
+  const BVHCompressed<BV, Q>* model1;
+
+  /// @brief The second compressed model
+  const BVHCompressed<BV, Q>* model2;
+
+  /// @brief statistical information
+  mutable int num_bv_tests;
+  mutable int num_leaf_tests;
+  mutable S query_time_seconds;
+
+  S cost_density;
+
+  /// @brief Rotation and translation from the frame of model2 to the frame
+  /// of model1
+  Matrix3<S> R;
+  Vector3<S> T;
+
+  /// @brief Rotation and translation from the shared box frame of model2 to
+  /// the shared box frame of model1
+  Matrix3<S> R_box;
+  Vector3<S> T_box;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// @brief Initialize traversal node for collision between two compressed
+/// meshes, given the current transforms
+template <typename BV, typename Q>
+FCL_EXPORT
+bool initialize(
+    MeshCompressedCollisionTraversalNode<BV, Q>& node,
+    const BVHCompressed<BV, Q>& model1,
+    const Transform3<typename BV::S>& tf1,
+    const BVHCompressed<BV, Q>& model2,
+    const Transform3<typename BV::S>& tf2,
+    const CollisionRequest<typename BV::S>& request,
+    CollisionResult<typename BV::S>& result);
+
+/// @brief Recurse function for collision between two compressed meshes.
+/// box1 and box2 are the decoded boxes of b1 and b2.
+template <typename BV, typename Q>
+FCL_EXPORT
+void collisionRecurse(
+    MeshCompressedCollisionTraversalNode<BV, Q>* node,
+    int b1, const AABB<float>& box1,
+    int b2, const AABB<float>& box2);
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/narrowphase/detail/traversal/collision/mesh_compressed_collision_traversal_node-inl.h"
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_TRAVERSAL_MESHMIXEDCOLLISIONTRAVERSALNODE_INL_H
+#define FCL_TRAVERSAL_MESHMIXEDCOLLISIONTRAVERSALNODE_INL_H
+
+#include "fcl/narrowphase/detail/traversal/collision/mesh_mixed_collision_traversal_node.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+template <typename BV>
+MeshMixedCollisionTraversalNode<BV>::MeshMixedCollisionTraversalNode()
+  : CollisionTraversalNodeBase<typename BV::S>()
+{
+  model1 = nullptr;
+  model2 = nullptr;
+
+  num_bv_tests = 0;
+  num_leaf_tests = 0;
+  query_time_seconds = 0.0;
+
+  R.setIdentity();
+  T.setZero();
+  Rf.setIdentity();
+  Tf.setZero();
+}
+
+//==============================================================================
+template <typename BV>
+bool MeshMixedCollisionTraversalNode<BV>::isFirstNodeLeaf(int b) const
+{
+  return model1->getBV(b).isLeaf();
+}
+
+//==============================================================================
+template <typename BV>
+bool MeshMixedCollisionTraversalNode<BV>::isSecondNodeLeaf(int b) const
+{
+  return model2->getBV(b).isLeaf();
+}
+
+//==============================================================================
+template <typename BV>
+bool MeshMixedCollisionTraversalNode<BV>::firstOverSecond(int b1, int b2) const
+{
+  float sz1 = model1->getBV(b1).bv.size();
+  float sz2 = model2->getBV(b2).bv.size();
+
+  bool l1 = model1->getBV(b1).isLeaf();
+  bool l2 = model2->getBV(b2).isLeaf();
+
+  if(l2 || (!l1 && (sz1 > sz2)))
+    return true;
+  return false;
+}
+
+//==============================================================================
+template <typename BV>
+int MeshMixedCollisionTraversalNode<BV>::getFirstLeftChild(int b) const
+{
+  return model1->getBV(b).leftChild();
+}
+
+//==============================================================================
+template <typename BV>
+int MeshMixedCollisionTraversalNode<BV>::getFirstRightChild(int b) const
+{
+  return model1->getBV(b).rightChild();
+}
+
+//==============================================================================
+template <typename BV>
+int MeshMixedCollisionTraversalNode<BV>::getSecondLeftChild(int b) const
+{
+  return model2->getBV(b).leftChild();
+}
+
+//==============================================================================
+template <typename BV>
+int MeshMixedCollisionTraversalNode<BV>::getSecondRightChild(int b) const
+{
+  return model2->getBV(b).rightChild();
+}
+
+//==============================================================================
+template <typename BV>
+bool MeshMixedCollisionTraversalNode<BV>::BVTesting(int b1, int b2) const
+{
+  if(this->enable_statistics) num_bv_tests++;
+
+  return !overlap(Rf, Tf, model1->getBV(b1).bv, model2->getBV(b2).bv);
+}
+
+//==============================================================================
+template <typename BV>
+void MeshMixedCollisionTraversalNode<BV>::leafTesting(int b1, int b2) const
+{
+  if(this->enable_statistics) num_leaf_tests++;
+
+  meshCollisionTriangleLeafTesting<S>(
+        model1->getBV(b1).primitiveId(),
+        model2->getBV(b2).primitiveId(),
+        model1,
+        model2,
+        model1->vertices.data(),
+        model2->vertices.data(),
+        model1->tri_indices.data(),
+        model2->tri_indices.data(),
+        R,
+        T,
+        this->tf1,
+        this->tf2,
+        cost_density,
+        this->request,
+        *this->result);
+}
+
+//==============================================================================
+template <typename BV>
+bool MeshMixedCollisionTraversalNode<BV>::canStop() const
+{
+  return this->request.isSatisfied(*(this->result));
+}
+
+//==============================================================================
+template <typename BV>
+bool initialize(
+    MeshMixedCollisionTraversalNode<BV>& node,
+    const BVHMixed<BV>& model1,
+    const Transform3<typename BV::S>& tf1,
+    const BVHMixed<BV>& model2,
+    const Transform3<typename BV::S>& tf2,
+    const CollisionRequest<typename BV::S>& request,
+    CollisionResult<typename BV::S>& result)
+{
+  if(model1.getNumBVs() == 0 || model2.getNumBVs() == 0)
+    return false;
+
+  node.model1 = &model1;
+  node.tf1 = tf1;
+  node.model2 = &model2;
+  node.tf2 = tf2;
+
+  node.request = request;
+  node.result = &result;
+
+  node.cost_density = model1.cost_density * model2.cost_density;
+
+  node.R.noalias() = tf1.linear().transpose() * tf2.linear();
+  node.T.noalias() = tf1.linear().transpose() * (tf2.translation() - tf1.translation());
+
+  node.Rf = node.R.template cast<float>();
+  node.Tf = node.T.template cast<float>();
+
+  return true;
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
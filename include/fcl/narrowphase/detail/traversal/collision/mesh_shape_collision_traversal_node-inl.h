@@ -57,6 +57,8 @@ MeshShapeCollisionTraversalNode<BV, Shape, NarrowPhaseSolver>::MeshShapeCollisio
   tri_indices = nullptr;
 
   nsolver = nullptr;
+
+  max_batch_size = 64;
 }
 
 //==============================================================================
@@ -125,6 +127,32 @@ void MeshShapeCollisionTraversalNode<BV, Shape, NarrowPhaseSolver>::leafTesting(
   }
 }
 
+//==============================================================================
+template <typename BV, typename Shape, typename NarrowPhaseSolver>
+bool MeshShapeCollisionTraversalNode<BV, Shape, NarrowPhaseSolver>::batchLeafTesting(int b1, int b2) const
+{
+  if(!ShapeTrianglesBatchable<Shape>::value
+     || this->model1->getBV(b1).num_primitives > max_batch_size)
+    return false;
+
+  const Transform3<S> X_MS = this->tf1.inverse(Eigen::Isometry) * this->tf2;
+  meshShapeBatchSeparated(this->model1, b1, vertices, tri_indices, *(this->model2), X_MS, batch);
+
+  for(std::size_t i = 0; i < batch.leaves.size(); ++i)
+  {
+    if(batch.separated[i])
+    {
+      if(this->enable_statistics) this->num_leaf_tests++;
+      continue;
+    }
+
+    this->leafTesting(batch.leaves[i], b2);
+    if(canStop()) break;
+  }
+
+  return true;
+}
+
 //==============================================================================
 template <typename BV, typename Shape, typename NarrowPhaseSolver>
 bool MeshShapeCollisionTraversalNode<BV, Shape, NarrowPhaseSolver>::canStop() const
@@ -132,6 +160,45 @@ bool MeshShapeCollisionTraversalNode<BV, Shape, NarrowPhaseSolver>::canStop() co
   return this->request.isSatisfied(*(this->result));
 }
 
+//==============================================================================
+template <typename BV, typename Shape>
+void meshShapeBatchSeparated(
+    const BVHModel<BV>* mesh,
+    int b,
+    const Vector3<typename BV::S>* vertices,
+    const Triangle* tri_indices,
+    const Shape& shape,
+    const Transform3<typename BV::S>& X_MS,
+    MeshShapeLeafBatch<typename BV::S>& batch)
+{
+  batch.leaves.clear();
+  batch.triangles.clear();
+
+  // Depth first, left child first: the order of the recursive traversal
+  batch.stack.clear();
+  batch.stack.push_back(b);
+  while(!batch.stack.empty())
+  {
+    const int id = batch.stack.back();
+    batch.stack.pop_back();
+    const BVNode<BV>& node = mesh->getBV(id);
+
+    if(node.isLeaf())
+    {
+      const Triangle& tri_id = tri_indices[node.primitiveId()];
+      batch.leaves.push_back(id);
+      batch.triangles.push_back(vertices[tri_id[0]], vertices[tri_id[1]], vertices[tri_id[2]]);
+    }
+    else
+    {
+      batch.stack.push_back(node.rightChild());
+      batch.stack.push_back(node.leftChild());
+    }
+  }
+
+  shapeTrianglesSeparated(shape, X_MS, batch.triangles, &batch.separated);
+}
+
 //==============================================================================
 template <typename BV, typename Shape, typename NarrowPhaseSolver>
 bool initialize(
@@ -39,6 +39,7 @@
 #define FCL_TRAVERSAL_MESHSHAPECOLLISIONTRAVERSALNODE_H
 
 #include "fcl/geometry/shape/utility.h"
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/shape_triangles.h"
 #include "fcl/narrowphase/detail/traversal/collision/bvh_shape_collision_traversal_node.h"
 
 namespace fcl
@@ -47,6 +48,37 @@ namespace fcl
 namespace detail
 {
 
+/// @brief The triangles below one node of a mesh, gathered to be tested
+/// against a shape in one batch
+template <typename S>
+struct FCL_EXPORT MeshShapeLeafBatch
+{
+  /// @brief The leaf nodes, in traversal order
+  std::vector<int> leaves;
+
+  /// @brief The triangles of the leaves
+  TriangleBatch<S> triangles;
+
+  /// @brief Whether the shape is separated from each triangle
+  std::vector<unsigned char> separated;
+
+  /// @brief Traversal stack
+  std::vector<int> stack;
+};
+
+/// @brief Gather the triangles below node b of the mesh and test them against
+/// the shape, posed by X_MS in the frame of the mesh vertices
+template <typename BV, typename Shape>
+FCL_EXPORT
+void meshShapeBatchSeparated(
+    const BVHModel<BV>* mesh,
+    int b,
+    const Vector3<typename BV::S>* vertices,
+    const Triangle* tri_indices,
+    const Shape& shape,
+    const Transform3<typename BV::S>& X_MS,
+    MeshShapeLeafBatch<typename BV::S>& batch);
+
 /// @brief Traversal node for collision between mesh and shape
 template <typename BV, typename Shape, typename NarrowPhaseSolver>
 class FCL_EXPORT MeshShapeCollisionTraversalNode
@@ -61,6 +93,12 @@ public:
   /// @brief Intersection testing between leaves (one triangle and one shape)
   void leafTesting(int b1, int b2) const;
 
+  /// @brief Test the triangles below node b1 against the shape in one batch
+  /// when the shape has a batched triangle test (see ShapeTrianglesBatchable)
+  /// and there are at most max_batch_size of them. Only the triangles the
+  /// batch does not prove separated are leaf tested.
+  bool batchLeafTesting(int b1, int b2) const;
+
   /// @brief Whether the traversal process can stop early
   bool canStop() const;
 
@@ -70,6 +108,12 @@ public:
   S cost_density;
 
   const NarrowPhaseSolver* nsolver;
+
+  /// @brief The largest number of triangles tested in one batch, 0 disables
+  /// batched leaf testing
+  int max_batch_size;
+
+  mutable MeshShapeLeafBatch<S> batch;
 };
 
 /// @brief Initialize traversal node for collision between one mesh and one
@@ -58,6 +58,8 @@ ShapeMeshCollisionTraversalNode<Shape, BV, NarrowPhaseSolver>::ShapeMeshCollisio
   tri_indices = nullptr;
 
   nsolver = nullptr;
+
+  max_batch_size = 64;
 }
 
 //==============================================================================
@@ -129,6 +131,33 @@ void ShapeMeshCollisionTraversalNode<Shape, BV, NarrowPhaseSolver>::leafTesting(
   }
 }
 
+//==============================================================================
+template <typename Shape, typename BV, typename NarrowPhaseSolver>
+FCL_EXPORT
+bool ShapeMeshCollisionTraversalNode<Shape, BV, NarrowPhaseSolver>::batchLeafTesting(int b1, int b2) const
+{
+  if(!ShapeTrianglesBatchable<Shape>::value
+     || this->model2->getBV(b2).num_primitives > max_batch_size)
+    return false;
+
+  const Transform3<S> X_MS = this->tf2.inverse(Eigen::Isometry) * this->tf1;
+  meshShapeBatchSeparated(this->model2, b2, vertices, tri_indices, *(this->model1), X_MS, batch);
+
+  for(std::size_t i = 0; i < batch.leaves.size(); ++i)
+  {
+    if(batch.separated[i])
+    {
+      if(this->enable_statistics) this->num_leaf_tests++;
+      continue;
+    }
+
+    this->leafTesting(b1, batch.leaves[i]);
+    if(canStop()) break;
+  }
+
+  return true;
+}
+
 //==============================================================================
 template <typename Shape, typename BV, typename NarrowPhaseSolver>
 FCL_EXPORT
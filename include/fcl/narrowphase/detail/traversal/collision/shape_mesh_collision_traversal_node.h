@@ -39,6 +39,7 @@
 #define FCL_TRAVERSAL_SHAPEMESHCOLLISIONTRAVERSALNODE_H
 
 #include "fcl/geometry/shape/utility.h"
+#include "fcl/narrowphase/detail/traversal/collision/mesh_shape_collision_traversal_node.h"
 #include "fcl/narrowphase/detail/traversal/collision/shape_bvh_collision_traversal_node.h"
 
 namespace fcl
@@ -60,6 +61,12 @@ public:
   /// @brief Intersection testing between leaves (one shape and one triangle)
   void leafTesting(int b1, int b2) const;
 
+  /// @brief Test the triangles below node b2 against the shape in one batch
+  /// when the shape has a batched triangle test (see ShapeTrianglesBatchable)
+  /// and there are at most max_batch_size of them. Only the triangles the
+  /// batch does not prove separated are leaf tested.
+  bool batchLeafTesting(int b1, int b2) const;
+
   /// @brief Whether the traversal process can stop early
   bool canStop() const;
 
@@ -69,6 +76,12 @@ public:
   S cost_density;
 
   const NarrowPhaseSolver* nsolver;
+
+  /// @brief The largest number of triangles tested in one batch, 0 disables
+  /// batched leaf testing
+  int max_batch_size;
+
+  mutable MeshShapeLeafBatch<S> batch;
 };
 
 /// @brief Initialize traversal node for collision between one mesh and one
@@ -117,6 +117,14 @@ void collide2(MeshCollisionTraversalNodeRSS<S>* node, BVHFrontList* front_list)
   }
 }
 
+//==============================================================================
+template <typename BV, typename Q>
+void collide(MeshCompressedCollisionTraversalNode<BV, Q>* node)
+{
+  collisionRecurse(node, 0, node->model1->getRootBox(),
+                   0, node->model2->getRootBox());
+}
+
 //==============================================================================
 template <typename S>
 void selfCollide(CollisionTraversalNodeBase<S>* node, BVHFrontList* front_list)
@@ -42,6 +42,7 @@
 #include "fcl/narrowphase/detail/traversal/traversal_recurse.h"
 #include "fcl/narrowphase/detail/traversal/collision/collision_traversal_node_base.h"
 #include "fcl/narrowphase/detail/traversal/collision/mesh_collision_traversal_node.h"
+#include "fcl/narrowphase/detail/traversal/collision/mesh_compressed_collision_traversal_node.h"
 #include "fcl/narrowphase/detail/traversal/distance/distance_traversal_node_base.h"
 
 /// @brief collision and distance function on traversal nodes. these functions provide a higher level abstraction for collision functions provided in collision_func_matrix
@@ -76,6 +77,12 @@ template <typename S>
 FCL_EXPORT
 void collide2(MeshCollisionTraversalNodeRSS<S>* node, BVHFrontList* front_list = nullptr);
 
+/// @brief collision on compressed mesh traversal node; the boxes are decoded
+/// during the recursion, so front list is not supported
+template <typename BV, typename Q>
+FCL_EXPORT
+void collide(MeshCompressedCollisionTraversalNode<BV, Q>* node);
+
 } // namespace detail
 } // namespace fcl
 
@@ -0,0 +1,248 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_TRAVERSAL_MESHMIXEDDISTANCETRAVERSALNODE_INL_H
+#define FCL_TRAVERSAL_MESHMIXEDDISTANCETRAVERSALNODE_INL_H
+
+#include "fcl/narrowphase/detail/traversal/distance/mesh_mixed_distance_traversal_node.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+//==============================================================================
+template <typename BV>
+MeshMixedDistanceTraversalNode<BV>::MeshMixedDistanceTraversalNode()
+  : DistanceTraversalNodeBase<typename BV::S>(),
+    tf(Transform3<S>::Identity())
+{
+  model1 = nullptr;
+  model2 = nullptr;
+
+  num_bv_tests = 0;
+  num_leaf_tests = 0;
+  query_time_seconds = 0.0;
+
+  rel_err = this->request.rel_err;
+  abs_err = this->request.abs_err;
+
+  Rf.setIdentity();
+  Tf.setZero();
+}
+
+//==============================================================================
+template <typename BV>
+void MeshMixedDistanceTraversalNode<BV>::preprocess()
+{
+  // start with the distance between the first triangles, so that the BV
+  // tests can prune from the beginning
+  const Triangle& init_tri1 = model1->tri_indices[0];
+  const Triangle& init_tri2 = model2->tri_indices[0];
+
+  Vector3<S> p1, p2;
+  S d = TriangleDistance<S>::triDistance(
+        model1->vertices[init_tri1[0]],
+        model1->vertices[init_tri1[1]],
+        model1->vertices[init_tri1[2]],
+        model2->vertices[init_tri2[0]],
+        model2->vertices[init_tri2[1]],
+        model2->vertices[init_tri2[2]],
+        tf, p1, p2);
+
+  if(this->request.enable_nearest_points)
+    this->result->update(d, model1, model2, 0, 0, p1, p2);
+  else
+    this->result->update(d, model1, model2, 0, 0);
+}
+
+//==============================================================================
+template <typename BV>
+void MeshMixedDistanceTraversalNode<BV>::postprocess()
+{
+  // the nearest points are in the frame of model1
+  if(this->request.enable_nearest_points
+     && (this->result->o1 == model1) && (this->result->o2 == model2))
+  {
+    this->result->nearest_points[0] = this->tf1 * this->result->nearest_points[0];
+    this->result->nearest_points[1] = this->tf1 * this->result->nearest_points[1];
+  }
+}
+
+//==============================================================================
+template <typename BV>
+bool MeshMixedDistanceTraversalNode<BV>::isFirstNodeLeaf(int b) const
+{
+  return model1->getBV(b).isLeaf();
+}
+
+//==============================================================================
+template <typename BV>
+bool MeshMixedDistanceTraversalNode<BV>::isSecondNodeLeaf(int b) const
+{
+  return model2->getBV(b).isLeaf();
+}
+
+//==============================================================================
+template <typename BV>
+bool MeshMixedDistanceTraversalNode<BV>::firstOverSecond(int b1, int b2) const
+{
+  float sz1 = model1->getBV(b1).bv.size();
+  float sz2 = model2->getBV(b2).bv.size();
+
+  bool l1 = model1->getBV(b1).isLeaf();
+  bool l2 = model2->getBV(b2).isLeaf();
+
+  if(l2 || (!l1 && (sz1 > sz2)))
+    return true;
+  return false;
+}
+
+//==============================================================================
+template <typename BV>
+int MeshMixedDistanceTraversalNode<BV>::getFirstLeftChild(int b) const
+{
+  return model1->getBV(b).leftChild();
+}
+
+//==============================================================================
+template <typename BV>
+int MeshMixedDistanceTraversalNode<BV>::getFirstRightChild(int b) const
+{
+  return model1->getBV(b).rightChild();
+}
+
+//==============================================================================
+template <typename BV>
+int MeshMixedDistanceTraversalNode<BV>::getSecondLeftChild(int b) const
+{
+  return model2->getBV(b).leftChild();
+}
+
+//==============================================================================
+template <typename BV>
+int MeshMixedDistanceTraversalNode<BV>::getSecondRightChild(int b) const
+{
+  return model2->getBV(b).rightChild();
+}
+
+//==============================================================================
+template <typename BV>
+typename BV::S MeshMixedDistanceTraversalNode<BV>::BVTesting(int b1, int b2) const
+{
+  if(this->enable_statistics) num_bv_tests++;
+
+  return static_cast<S>(
+        distance(Rf, Tf, model1->getBV(b1).bv, model2->getBV(b2).bv));
+}
+
+//==============================================================================
+template <typename BV>
+void MeshMixedDistanceTraversalNode<BV>::leafTesting(int b1, int b2) const
+{
+  if(this->enable_statistics) num_leaf_tests++;
+
+  int primitive_id1 = model1->getBV(b1).primitiveId();
+  int primitive_id2 = model2->getBV(b2).primitiveId();
+
+  const Triangle& tri_id1 = model1->tri_indices[primitive_id1];
+  const Triangle& tri_id2 = model2->tri_indices[primitive_id2];
+
+  const Vector3<S>& t11 = model1->vertices[tri_id1[0]];
+  const Vector3<S>& t12 = model1->vertices[tri_id1[1]];
+  const Vector3<S>& t13 = model1->vertices[tri_id1[2]];
+
+  const Vector3<S>& t21 = model2->vertices[tri_id2[0]];
+  const Vector3<S>& t22 = model2->vertices[tri_id2[1]];
+  const Vector3<S>& t23 = model2->vertices[tri_id2[2]];
+
+  // nearest point pair
+  Vector3<S> P1, P2;
+
+  S d = TriangleDistance<S>::triDistance(
+        t11, t12, t13, t21, t22, t23, tf, P1, P2);
+
+  if(this->request.enable_nearest_points)
+    this->result->update(d, model1, model2, primitive_id1, primitive_id2, P1, P2);
+  else
+    this->result->update(d, model1, model2, primitive_id1, primitive_id2);
+}
+
+//==============================================================================
+template <typename BV>
+bool MeshMixedDistanceTraversalNode<BV>::canStop(typename BV::S c) const
+{
+  if((c >= this->result->min_distance - abs_err) && (c * (1 + rel_err) >= this->result->min_distance))
+    return true;
+  return false;
+}
+
+//==============================================================================
+template <typename BV>
+bool initialize(
+    MeshMixedDistanceTraversalNode<BV>& node,
+    const BVHMixed<BV>& model1,
+    const Transform3<typename BV::S>& tf1,
+    const BVHMixed<BV>& model2,
+    const Transform3<typename BV::S>& tf2,
+    const DistanceRequest<typename BV::S>& request,
+    DistanceResult<typename BV::S>& result)
+{
+  if(model1.getNumBVs() == 0 || model2.getNumBVs() == 0)
+    return false;
+
+  node.request = request;
+  node.result = &result;
+
+  node.model1 = &model1;
+  node.tf1 = tf1;
+  node.model2 = &model2;
+  node.tf2 = tf2;
+
+  node.rel_err = request.rel_err;
+  node.abs_err = request.abs_err;
+
+  node.tf = tf1.inverse(Eigen::Isometry) * tf2;
+  node.Rf = node.tf.linear().template cast<float>();
+  node.Tf = node.tf.translation().template cast<float>();
+
+  return true;
+}
+
+} // namespace detail
+} // namespace fcl
+
+#endif
@@ -0,0 +1,141 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_TRAVERSAL_MESHMIXEDDISTANCETRAVERSALNODE_H
+#define FCL_TRAVERSAL_MESHMIXEDDISTANCETRAVERSALNODE_H
+
+#include "fcl/geometry/bvh/BVH_mixed.h"
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/triangle_distance.h"
+#include "fcl/narrowphase/detail/traversal/distance/distance_traversal_node_base.h"
+
+namespace fcl
+{
+
+namespace detail
+{
+
+/// @brief Traversal node for distance computation between two mixed precision
+/// meshes. The BV distances are computed in float and are lower bounds of the
+/// exact ones; the triangle distances are computed in the precision of BV.
+/// Supported BV types are RSS, OBBRSS and kIOS.
+template <typename BV>
+class FCL_EXPORT MeshMixedDistanceTraversalNode
+    : public DistanceTraversalNodeBase<typename BV::S>
+{
+public:
+
+  using S = typename BV::S;
+
+  MeshMixedDistanceTraversalNode();
+
+  void preprocess();
+
+  void postprocess();
+
+  /// @brief Whether the BV node in the first BVH tree is leaf
+  bool isFirstNodeLeaf(int b) const;
+
+  /// @brief Whether the BV node in the second BVH tree is leaf
+  bool isSecondNodeLeaf(int b) const;
+
+  /// @brief Determine the traversal order, is the first BVTT subtree better
+  bool firstOverSecond(int b1, int b2) const;
+
+  /// @brief Get the left child of the node b in the first tree
+  int getFirstLeftChild(int b) const;
+
+  /// @brief Get the right child of the node b in the first tree
+  int getFirstRightChild(int b) const;
+
+  /// @brief Get the left child of the node b in the second tree
+  int getSecondLeftChild(int b) const;
+
+  /// @brief Get the right child of the node b in the second tree
+  int getSecondRightChild(int b) const;
+
+  /// @brief BV distance lower bound, computed in float
+  S BVTesting(int b1, int b2) const;
+
+  /// @brief Distance testing between leaves (two triangles)
+  void leafTesting(int b1, int b2) const;
+
+  /// @brief Whether the traversal process can stop early
+  bool canStop(S c) const;
+
+  /// @brief The first mixed precision model
+  const BVHMixed<BV>* model1;
+
+  /// @brief The second mixed precision model
+  const BVHMixed<BV>* model2;
+
+  /// @brief statistical information
+  mutable int num_bv_tests;
+  mutable int num_leaf_tests;
+  mutable S query_time_seconds;
+
+  /// @brief relative and absolute error, default value is 0.01 for both terms
+  S rel_err;
+  S abs_err;
+
+  /// @brief Transform from the frame of model2 to the frame of model1
+  Transform3<S> tf;
+
+  /// @brief The rotation and translation of tf rounded to float, for the BV
+  /// tests
+  Matrix3<float> Rf;
+  Vector3<float> Tf;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/// @brief Initialize traversal node for distance computation between two
+/// mixed precision meshes, given the current transforms
+template <typename BV>
+FCL_EXPORT
+bool initialize(
+    MeshMixedDistanceTraversalNode<BV>& node,
+    const BVHMixed<BV>& model1,
+    const Transform3<typename BV::S>& tf1,
+    const BVHMixed<BV>& model2,
+    const Transform3<typename BV::S>& tf2,
+    const DistanceRequest<typename BV::S>& request,
+    DistanceResult<typename BV::S>& result);
+
+} // namespace detail
+} // namespace fcl
+
+#include "fcl/narrowphase/detail/traversal/distance/mesh_mixed_distance_traversal_node-inl.h"
+
+#endif
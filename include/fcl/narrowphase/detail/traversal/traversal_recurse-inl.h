@@ -102,6 +102,9 @@ void collisionRecurse(CollisionTraversalNodeBase<S>* node, int b1, int b2, BVHFr
     return;
   }
 
+  // the front list records the leaves, which batched leaf testing skips
+  if(!front_list && node->batchLeafTesting(b1, b2)) return;
+
   if(node->firstOverSecond(b1, b2))
   {
     int c1 = node->getFirstLeftChild(b1);
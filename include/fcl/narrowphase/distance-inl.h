@@ -41,6 +41,7 @@
 #include "fcl/narrowphase/distance.h"
 
 #include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/gjk_solver_dispatch.h"
 
 namespace fcl
 {
@@ -200,7 +201,8 @@ S distance(
     const DistanceRequest<S>& request,
     DistanceResult<S>& result)
 {
-  switch(request.gjk_solver_type)
+  switch(resolveGJKSolverType(request.gjk_solver_type,
+                              o1->getNodeType(), o2->getNodeType()))
   {
   case GST_LIBCCD:
     {
@@ -226,7 +228,8 @@ S distance(
     const CollisionGeometry<S>* o2, const Transform3<S>& tf2,
     const DistanceRequest<S>& request, DistanceResult<S>& result)
 {
-  switch(request.gjk_solver_type)
+  switch(resolveGJKSolverType(request.gjk_solver_type,
+                              o1->getNodeType(), o2->getNodeType()))
   {
   case GST_LIBCCD:
     {
@@ -77,6 +77,9 @@ struct FCL_EXPORT DistanceRequest
   /// NP_X: The pair of nearest points are NOT guaranteed to be on the surface
   ///       of objects.
   ///
+  /// With GST_AUTO, the column is the one of the solver that
+  /// GJKSolverDispatch picks for the pair.
+  ///
   /// If this flag is set to true, FCL will perform additional collision
   /// checking when the two objects are in collision in order to get the exact
   /// negative distance, which is the negated penetration depth. If there are
@@ -86,6 +89,9 @@ struct FCL_EXPORT DistanceRequest
   /// If this flag is set to false, the result minimum distance is
   /// implementation defined (mostly -1).
   ///
+  /// For pairs of closed triangle meshes, meshSignedDistance() estimates the
+  /// penetration depth from precomputed BVHSignedDistance structures instead.
+  ///
   /// The default is false.
   ///
   /// @sa DistanceResult::min_distance
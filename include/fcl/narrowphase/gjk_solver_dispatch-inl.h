@@ -0,0 +1,215 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_GJKSOLVERDISPATCH_INL_H
+#define FCL_NARROWPHASE_GJKSOLVERDISPATCH_INL_H
+
+#include "fcl/narrowphase/gjk_solver_dispatch.h"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "fcl/common/time.h"
+#include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/geometry/convex_hull.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/geometry/shape/box.h"
+#include "fcl/geometry/shape/capsule.h"
+#include "fcl/geometry/shape/cone.h"
+#include "fcl/geometry/shape/cylinder.h"
+#include "fcl/geometry/shape/ellipsoid.h"
+#include "fcl/geometry/shape/sphere.h"
+#include "fcl/math/bv/OBBRSS.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+
+namespace fcl
+{
+
+//==============================================================================
+extern template
+void GJKSolverDispatch::calibrate<double>(int num_samples, unsigned int seed);
+
+namespace detail
+{
+
+//==============================================================================
+/// @brief Random pose whose translation is in [-range, range]^3
+template <typename S>
+Transform3<S> randomDispatchPose(std::mt19937& rng, S range)
+{
+  std::uniform_real_distribution<S> uniform(-range, range);
+  std::normal_distribution<S> normal;
+  Quaternion<S> q(normal(rng), normal(rng), normal(rng), normal(rng));
+  q.normalize();
+
+  Transform3<S> pose = Transform3<S>::Identity();
+  pose.linear() = q.toRotationMatrix();
+  pose.translation() << uniform(rng), uniform(rng), uniform(rng);
+  return pose;
+}
+
+//==============================================================================
+/// @brief Seconds spent by collide() and distance() of o1 and o2 at the
+/// poses with the solver, whose results are stored in colliding and
+/// distances.
+template <typename S>
+double timeGJKSolver(
+    const CollisionGeometry<S>* o1,
+    const CollisionGeometry<S>* o2,
+    const std::vector<Transform3<S>>& poses,
+    GJKSolverType type,
+    std::vector<bool>& colliding,
+    std::vector<S>& distances)
+{
+  CollisionRequest<S> collision_request;
+  collision_request.gjk_solver_type = type;
+  DistanceRequest<S> distance_request;
+  distance_request.gjk_solver_type = type;
+
+  const std::size_t num_samples = poses.size() / 2;
+  colliding.resize(num_samples);
+  distances.resize(num_samples);
+
+  const time::point start = time::now();
+  for(std::size_t i = 0; i < num_samples; ++i)
+  {
+    const Transform3<S>& tf1 = poses[2 * i];
+    const Transform3<S>& tf2 = poses[2 * i + 1];
+    CollisionResult<S> collision_result;
+    colliding[i] =
+        collide(o1, tf1, o2, tf2, collision_request, collision_result) > 0;
+    DistanceResult<S> distance_result;
+    distances[i] =
+        distance(o1, tf1, o2, tf2, distance_request, distance_result);
+  }
+  return time::seconds(time::now() - start);
+}
+
+//==============================================================================
+/// @brief The solver calibrate() picks for o1 and o2
+template <typename S>
+GJKSolverType calibrateGJKSolver(
+    const CollisionGeometry<S>* o1,
+    const CollisionGeometry<S>* o2,
+    int num_samples,
+    std::mt19937& rng)
+{
+  std::vector<Transform3<S>> poses(2 * num_samples);
+  for(auto& pose : poses)
+    pose = randomDispatchPose<S>(rng, 0.75);
+
+  std::vector<bool> colliding_libccd, colliding_indep;
+  std::vector<S> distances_libccd, distances_indep;
+
+  // Each solver runs twice, interleaved, and keeps its fastest run, so that
+  // a one-off stall does not decide the pair.
+  double time_libccd = 0;
+  double time_indep = 0;
+  for(int run = 0; run < 2; ++run)
+  {
+    const double t_libccd = timeGJKSolver(
+        o1, o2, poses, GST_LIBCCD, colliding_libccd, distances_libccd);
+    const double t_indep = timeGJKSolver(
+        o1, o2, poses, GST_INDEP, colliding_indep, distances_indep);
+    time_libccd = (run == 0) ? t_libccd : std::min(time_libccd, t_libccd);
+    time_indep = (run == 0) ? t_indep : std::min(time_indep, t_indep);
+  }
+
+  // The distances of the solvers differ by their tolerances
+  const S tolerance = 1e-3;
+  for(int i = 0; i < num_samples; ++i)
+  {
+    if(colliding_libccd[i] != colliding_indep[i])
+      return GST_LIBCCD;
+    if(!colliding_libccd[i]
+       && std::abs(distances_libccd[i] - distances_indep[i])
+          > tolerance * (1 + std::abs(distances_libccd[i])))
+      return GST_LIBCCD;
+  }
+
+  return (time_indep < time_libccd) ? GST_INDEP : GST_LIBCCD;
+}
+
+} // namespace detail
+
+//==============================================================================
+template <typename S>
+void GJKSolverDispatch::calibrate(int num_samples, unsigned int seed)
+{
+  std::mt19937 rng(seed);
+
+  std::vector<std::shared_ptr<CollisionGeometry<S>>> shapes;
+  shapes.push_back(std::make_shared<Box<S>>(1.0, 0.8, 0.6));
+  shapes.push_back(std::make_shared<Sphere<S>>(0.5));
+  shapes.push_back(std::make_shared<Ellipsoid<S>>(0.6, 0.4, 0.3));
+  shapes.push_back(std::make_shared<Capsule<S>>(0.3, 1.0));
+  shapes.push_back(std::make_shared<Cone<S>>(0.5, 1.0));
+  shapes.push_back(std::make_shared<Cylinder<S>>(0.4, 1.0));
+
+  std::uniform_real_distribution<S> uniform(-0.5, 0.5);
+  std::vector<Vector3<S>> points(16);
+  for(auto& point : points)
+    point << uniform(rng), uniform(rng), uniform(rng);
+  shapes.push_back(convexHull(points));
+
+  for(std::size_t i = 0; i < shapes.size(); ++i)
+  {
+    for(std::size_t j = i; j < shapes.size(); ++j)
+    {
+      setSolverType(shapes[i]->getNodeType(), shapes[j]->getNodeType(),
+                    detail::calibrateGJKSolver(
+                        shapes[i].get(), shapes[j].get(), num_samples, rng));
+    }
+  }
+
+  // The solver of a mesh-shape pair runs on the triangles, whatever the
+  // bounding volume, so one mesh stands for all the BVH node types.
+  BVHModel<OBBRSS<S>> mesh;
+  generateBVHModel(mesh, Sphere<S>(0.5), Transform3<S>::Identity(), 16, 16);
+  for(const auto& shape : shapes)
+  {
+    const GJKSolverType type = detail::calibrateGJKSolver<S>(
+        &mesh, shape.get(), num_samples, rng);
+    for(int bv = BV_AABB; bv <= BV_KDOP24; ++bv)
+      setSolverType(static_cast<NODE_TYPE>(bv), shape->getNodeType(), type);
+  }
+}
+
+} // namespace fcl
+
+#endif
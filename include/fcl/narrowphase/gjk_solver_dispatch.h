@@ -0,0 +1,100 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_GJKSOLVERDISPATCH_H
+#define FCL_NARROWPHASE_GJKSOLVERDISPATCH_H
+
+#include "fcl/geometry/collision_geometry.h"
+#include "fcl/narrowphase/gjk_solver_type.h"
+
+namespace fcl
+{
+
+/// @brief Choice of the GJK solver for each pair of node types, used by the
+/// queries whose request asks for GST_AUTO.
+///
+/// The table starts with the bundled choices, which calibrate() measured on
+/// the primitive shape pairs: an entry is GST_INDEP only where the
+/// independent solver was faster and agreed with libccd on every sampled
+/// pose, and GST_LIBCCD everywhere else. calibrate() can be called at startup
+/// to measure on the running machine instead.
+///
+/// The table is not synchronized: calibrate() and setSolverType() must not
+/// run concurrently with queries that use GST_AUTO.
+class FCL_EXPORT GJKSolverDispatch
+{
+public:
+
+  /// @brief The table used by collide(), distance() and continuousCollide()
+  static GJKSolverDispatch& getDefault();
+
+  /// @brief Table with the bundled choices
+  GJKSolverDispatch();
+
+  /// @brief Restore the bundled choices
+  void reset();
+
+  /// @brief Solver used for the pair of node types, GST_LIBCCD or GST_INDEP.
+  /// The order of the types does not matter.
+  GJKSolverType getSolverType(NODE_TYPE type1, NODE_TYPE type2) const;
+
+  /// @brief Set the solver of the pair of node types, in both orders. type
+  /// must not be GST_AUTO.
+  void setSolverType(NODE_TYPE type1, NODE_TYPE type2, GJKSolverType type);
+
+  /// @brief Time collide() and distance() with both solvers on num_samples
+  /// random poses of each pair of primitive shapes, and of a sphere mesh
+  /// against each shape for the BVH node types. A pair uses GST_INDEP if it
+  /// was faster and its results agreed with GST_LIBCCD on every pose.
+  template <typename S>
+  void calibrate(int num_samples = 200, unsigned int seed = 0);
+
+private:
+
+  GJKSolverType table[NODE_COUNT][NODE_COUNT];
+};
+
+/// @brief The solver that a query between the node types runs for the
+/// requested solver type: type itself, or the choice of
+/// GJKSolverDispatch::getDefault() if it is GST_AUTO.
+FCL_EXPORT
+GJKSolverType resolveGJKSolverType(
+    GJKSolverType type, NODE_TYPE type1, NODE_TYPE type2);
+
+} // namespace fcl
+
+#include "fcl/narrowphase/gjk_solver_dispatch-inl.h"
+
+#endif
@@ -41,8 +41,9 @@
 namespace fcl
 {
 
-/// @brief Type of narrow phase GJK solver
-enum GJKSolverType {GST_LIBCCD, GST_INDEP};
+/// @brief Type of narrow phase GJK solver. GST_AUTO picks GST_LIBCCD or
+/// GST_INDEP for each pair of node types from GJKSolverDispatch.
+enum GJKSolverType {GST_LIBCCD, GST_INDEP, GST_AUTO};
 
 } // namespace fcl
 
@@ -0,0 +1,191 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_MESH_SIGNED_DISTANCE_INL_H
+#define FCL_NARROWPHASE_MESH_SIGNED_DISTANCE_INL_H
+
+#include "fcl/narrowphase/mesh_signed_distance.h"
+
+#include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace fcl
+{
+
+//==============================================================================
+template <typename BV>
+typename BV::S meshSignedDistance(
+    const BVHSignedDistance<BV>& mesh1,
+    const Transform3<typename BV::S>& tf1,
+    const BVHSignedDistance<BV>& mesh2,
+    const Transform3<typename BV::S>& tf2,
+    const DistanceRequest<typename BV::S>& request,
+    DistanceResult<typename BV::S>& result)
+{
+  using S = typename BV::S;
+
+  if(!mesh1.isValid() || !mesh2.isValid())
+  {
+    std::cerr << "Warning: meshSignedDistance() was given an invalid BVHSignedDistance.\n";
+    result.min_distance = std::numeric_limits<S>::max();
+    return result.min_distance;
+  }
+
+  const BVHModel<BV>& model1 = mesh1.getModel();
+  const BVHModel<BV>& model2 = mesh2.getModel();
+
+  distance(&model1, tf1, &model2, tf2, request, result);
+
+  const Transform3<S> tf12 = tf2.inverse(Eigen::Isometry) * tf1;
+  const Transform3<S> tf21 = tf1.inverse(Eigen::Isometry) * tf2;
+
+  // Without a surface contact, the meshes overlap only if one of them is
+  // completely inside the other one, and then any of its vertices is.
+  if(result.min_distance > 0)
+  {
+    const bool inside1 = model1.num_vertices > 0
+        && mesh2.isInside(tf12 * model1.vertices[0]);
+    const bool inside2 = model2.num_vertices > 0
+        && mesh1.isInside(tf21 * model2.vertices[0]);
+    if(!inside1 && !inside2)
+      return result.min_distance;
+  }
+
+  int v1 = -1, t1 = -1;
+  Vector3<S> q1;
+  const S d1 = detail::deepestVertexInside(mesh1, mesh2, tf12, v1, q1, t1);
+
+  int v2 = -1, t2 = -1;
+  Vector3<S> q2;
+  const S d2 = detail::deepestVertexInside(mesh2, mesh1, tf21, v2, q2, t2);
+
+  if(v1 < 0 && v2 < 0)
+  {
+    result.min_distance = 0;
+    return result.min_distance;
+  }
+
+  result.min_distance = std::min(d1, d2);
+  result.o1 = &model1;
+  result.o2 = &model2;
+  if(d1 <= d2)
+  {
+    result.b1 = mesh1.getVertexTriangle(v1);
+    result.b2 = t1;
+    if(request.enable_nearest_points)
+    {
+      result.nearest_points[0] = tf1 * model1.vertices[v1];
+      result.nearest_points[1] = tf2 * q1;
+    }
+  }
+  else
+  {
+    result.b1 = t2;
+    result.b2 = mesh2.getVertexTriangle(v2);
+    if(request.enable_nearest_points)
+    {
+      result.nearest_points[0] = tf1 * q2;
+      result.nearest_points[1] = tf2 * model2.vertices[v2];
+    }
+  }
+
+  return result.min_distance;
+}
+
+namespace detail
+{
+
+//==============================================================================
+template <typename BV>
+typename BV::S deepestVertexInside(
+    const BVHSignedDistance<BV>& mesh1,
+    const BVHSignedDistance<BV>& mesh2,
+    const Transform3<typename BV::S>& tf12,
+    int& vertex_id,
+    Vector3<typename BV::S>& surface_point,
+    int& tri_id)
+{
+  using S = typename BV::S;
+
+  vertex_id = -1;
+  tri_id = -1;
+  if(!mesh1.isValid() || !mesh2.isValid())
+    return 0;
+
+  const BVHModel<BV>& model1 = mesh1.getModel();
+  const AABB<S>& box2 = mesh2.getRootBox();
+
+  // The vertices inside the box of mesh2, the one nearest to its center
+  // first: it is likely deep and gives a good bound for the other ones.
+  std::vector<std::pair<int, Vector3<S>>> candidates;
+  const Vector3<S> center = box2.center();
+  for(int i = 0; i < model1.num_vertices; ++i)
+  {
+    const Vector3<S> p = tf12 * model1.vertices[i];
+    if(!box2.contain(p)) continue;
+
+    candidates.emplace_back(i, p);
+    if((p - center).squaredNorm() < (candidates.front().second - center).squaredNorm())
+      std::swap(candidates.front(), candidates.back());
+  }
+
+  S deepest = 0;
+  for(const auto& candidate : candidates)
+  {
+    // only the vertices deeper than the current one are of interest
+    Vector3<S> closest;
+    int t;
+    S d;
+    if(!mesh2.signedDistanceBeyond(candidate.second, -deepest, d, closest, t))
+      continue;
+    if(d < deepest)
+    {
+      deepest = d;
+      vertex_id = candidate.first;
+      surface_point = closest;
+      tri_id = t;
+    }
+  }
+
+  return deepest;
+}
+
+} // namespace detail
+
+} // namespace fcl
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef FCL_NARROWPHASE_MESH_SIGNED_DISTANCE_H
+#define FCL_NARROWPHASE_MESH_SIGNED_DISTANCE_H
+
+#include "fcl/geometry/bvh/BVH_signed_distance.h"
+#include "fcl/narrowphase/distance.h"
+
+namespace fcl
+{
+
+/// @brief Signed distance between two closed triangle meshes.
+///
+/// When the meshes are apart, this is the regular BVH distance. When they
+/// are in collision (including the case where one mesh is completely inside
+/// the other one), the result is the negated penetration depth, estimated as
+/// the largest distance from a vertex of one mesh to the surface of the other
+/// mesh it is inside of. This is exact when the deepest point of the overlap
+/// is a vertex and a lower bound of the translational penetration depth
+/// otherwise; overlaps which only contain edges return 0.
+///
+/// With DistanceRequest::enable_nearest_points, nearest_points (in the world
+/// frame) are the deepest vertex and its closest point on the other surface.
+/// b1 and b2 are triangle ids in both cases.
+///
+/// If mesh1 or mesh2 is not valid (BVHSignedDistance::isValid()), a warning
+/// is printed and std::numeric_limits<S>::max() is returned.
+template <typename BV>
+FCL_EXPORT
+typename BV::S meshSignedDistance(
+    const BVHSignedDistance<BV>& mesh1,
+    const Transform3<typename BV::S>& tf1,
+    const BVHSignedDistance<BV>& mesh2,
+    const Transform3<typename BV::S>& tf2,
+    const DistanceRequest<typename BV::S>& request,
+    DistanceResult<typename BV::S>& result);
+
+namespace detail
+{
+
+/// @brief Deepest vertex of mesh1 inside mesh2, where tf12 maps the frame of
+/// mesh1 to the frame of mesh2. Returns the (non-positive) signed distance of
+/// that vertex, or 0 (with vertex_id = -1) if no vertex of mesh1 is inside
+/// mesh2 or if one of the structures is not valid.
+template <typename BV>
+FCL_EXPORT
+typename BV::S deepestVertexInside(
+    const BVHSignedDistance<BV>& mesh1,
+    const BVHSignedDistance<BV>& mesh2,
+    const Transform3<typename BV::S>& tf12,
+    int& vertex_id,
+    Vector3<typename BV::S>& surface_point,
+    int& tri_id);
+
+} // namespace detail
+
+} // namespace fcl
+
+#include "fcl/narrowphase/mesh_signed_distance-inl.h"
+
+#endif
@@ -76,5 +76,23 @@ bool boxBoxIntersect(const Box<double>& s1, const Transform3<double>& tf1,
                      const Box<double>& s2, const Transform3<double>& tf2,
                      std::vector<ContactPoint<double>>* contacts_);
 
+//==============================================================================
+template
+double boxBoxAxisSeparation(int code,
+                            const Vector3<double>& side1, const Transform3<double>& tf1,
+                            const Vector3<double>& side2, const Transform3<double>& tf2);
+
+//==============================================================================
+template
+int boxBoxSeparatingAxis(const Vector3<double>& side1, const Transform3<double>& tf1,
+                         const Vector3<double>& side2, const Transform3<double>& tf2);
+
+//==============================================================================
+template
+bool boxBoxIntersect(const Box<double>& s1, const Transform3<double>& tf1,
+                     const Box<double>& s2, const Transform3<double>& tf2,
+                     ContactManifold<double>& manifold,
+                     std::vector<ContactPoint<double>>* contacts_);
+
 } // namespace detail
 } // namespace fcl
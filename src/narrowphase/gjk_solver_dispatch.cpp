@@ -0,0 +1,116 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fcl/narrowphase/gjk_solver_dispatch-inl.h"
+
+#include <iostream>
+
+namespace fcl
+{
+
+//==============================================================================
+template
+void GJKSolverDispatch::calibrate<double>(int num_samples, unsigned int seed);
+
+//==============================================================================
+GJKSolverDispatch& GJKSolverDispatch::getDefault()
+{
+  static GJKSolverDispatch dispatch;
+  return dispatch;
+}
+
+//==============================================================================
+GJKSolverDispatch::GJKSolverDispatch()
+{
+  reset();
+}
+
+//==============================================================================
+void GJKSolverDispatch::reset()
+{
+  for(int i = 0; i < NODE_COUNT; ++i)
+  {
+    for(int j = 0; j < NODE_COUNT; ++j)
+      table[i][j] = GST_LIBCCD;
+  }
+
+  // The choices of calibrate<double>() over several seeds: the independent
+  // solver is faster on the triangles of meshes against every shape, and on
+  // the shape pairs below, which both solvers answer alike.
+  for(int bv = BV_AABB; bv <= BV_KDOP24; ++bv)
+  {
+    for(int shape = GEOM_BOX; shape <= GEOM_CONVEX; ++shape)
+    {
+      setSolverType(static_cast<NODE_TYPE>(bv), static_cast<NODE_TYPE>(shape),
+                    GST_INDEP);
+    }
+  }
+  setSolverType(GEOM_BOX, GEOM_BOX, GST_INDEP);
+  setSolverType(GEOM_BOX, GEOM_CAPSULE, GST_INDEP);
+  setSolverType(GEOM_SPHERE, GEOM_CAPSULE, GST_INDEP);
+}
+
+//==============================================================================
+GJKSolverType GJKSolverDispatch::getSolverType(
+    NODE_TYPE type1, NODE_TYPE type2) const
+{
+  return table[type1][type2];
+}
+
+//==============================================================================
+void GJKSolverDispatch::setSolverType(
+    NODE_TYPE type1, NODE_TYPE type2, GJKSolverType type)
+{
+  if(type == GST_AUTO)
+  {
+    std::cerr << "Warning: GST_AUTO is not a solver of the dispatch table\n";
+    return;
+  }
+
+  table[type1][type2] = type;
+  table[type2][type1] = type;
+}
+
+//==============================================================================
+GJKSolverType resolveGJKSolverType(
+    GJKSolverType type, NODE_TYPE type1, NODE_TYPE type2)
+{
+  if(type != GST_AUTO)
+    return type;
+
+  return GJKSolverDispatch::getDefault().getSolverType(type1, type2);
+}
+
+} // namespace fcl
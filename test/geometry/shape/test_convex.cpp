@@ -38,6 +38,7 @@
 
 #include "fcl/geometry/shape/convex.h"
 
+#include <limits>
 #include <vector>
 
 #include <Eigen/StdVector>
@@ -864,6 +865,44 @@ GTEST_TEST(ConvexGeometry, UseEdgeWalkingConditions) {
     }
 }
 
+// Confirm that the edge walk finds the extreme vertex from any start vertex,
+// and when it is warm started with the answer for a nearby direction.
+GTEST_TEST(ConvexGeometry, SupportVertexWarmStart) {
+  TessellatedSphere poly;
+  Convex<double> convex = poly.MakeConvex(true);
+  ASSERT_TRUE(ConvexTester::find_extreme_via_neighbors(convex));
+  const std::vector<Vector3d>& vertices = convex.getVertices();
+  const int num_vertices = static_cast<int>(vertices.size());
+
+  auto max_value = [&vertices](const Vector3d& v) {
+    double value = -std::numeric_limits<double>::max();
+    for (const auto& p : vertices) value = max(value, v.dot(p));
+    return value;
+  };
+
+  int hint = 0;
+  for (int i = 0; i < 100; ++i) {
+    const double angle = i * 0.05;
+    const Vector3d v(std::cos(angle), std::sin(angle), std::sin(3 * angle));
+    const double expected = max_value(v);
+
+    for (int start = 0; start < num_vertices; start += 7) {
+      const int index = convex.findExtremeVertexIndex(v, start);
+      EXPECT_EQ(v.dot(vertices[index]), expected);
+    }
+
+    hint = convex.findExtremeVertexIndex(v, hint);
+    EXPECT_EQ(v.dot(vertices[hint]), expected);
+    EXPECT_EQ(v.dot(convex.findExtremeVertex(v)), expected);
+  }
+
+  // An invalid hint falls back to the first vertex.
+  const Vector3d v(0, 0, 1);
+  EXPECT_EQ(v.dot(vertices[convex.findExtremeVertexIndex(v, -1)]), max_value(v));
+  EXPECT_EQ(v.dot(vertices[convex.findExtremeVertexIndex(v, num_vertices)]),
+            max_value(v));
+}
+
 // TODO(SeanCurtis-TRI): Add Tetrahedron inertia unit test.
 
 // TODO(SeanCurtis-TRI): Extend the moment of inertia test.
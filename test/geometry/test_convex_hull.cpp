@@ -0,0 +1,212 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "fcl/geometry/convex_hull.h"
+
+#include <gtest/gtest.h>
+
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/math/bv/OBBRSS.h"
+#include "fcl/narrowphase/collision.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+//==============================================================================
+/// @brief Largest signed distance of the points above the faces of the hull
+template <typename S>
+S maxDistanceAboveHull(const Convex<S>& hull, const std::vector<Vector3<S>>& points)
+{
+  const std::vector<Vector3<S>>& vertices = hull.getVertices();
+  const std::vector<int>& faces = hull.getFaces();
+
+  S max_distance = -std::numeric_limits<S>::max();
+  for(std::size_t i = 0; i < faces.size(); i += faces[i] + 1)
+  {
+    const Vector3<S>& a = vertices[faces[i + 1]];
+    const Vector3<S>& b = vertices[faces[i + 2]];
+    const Vector3<S>& c = vertices[faces[i + 3]];
+    const Vector3<S> normal = (b - a).cross(c - a).normalized();
+    for(const auto& p : points)
+      max_distance = std::max(max_distance, normal.dot(p - a));
+  }
+
+  return max_distance;
+}
+
+//==============================================================================
+template <typename S>
+std::vector<Vector3<S>> randomPointsOnSphere(std::size_t n, S radius)
+{
+  std::vector<Vector3<S>> points(n);
+  for(auto& p : points)
+  {
+    do
+    {
+      p = Vector3<S>::Random();
+    } while(p.squaredNorm() < S(0.01) || p.squaredNorm() > 1);
+    p = p.normalized() * radius;
+  }
+  return points;
+}
+
+//==============================================================================
+template <typename S>
+void test_convex_hull_box()
+{
+  std::vector<Vector3<S>> points;
+  for(int i = 0; i < 1000; ++i)
+    points.push_back(Vector3<S>::Random() * S(0.5));
+  for(int i = 0; i < 8; ++i)
+    points.emplace_back((i & 1) ? 1 : -1, (i & 2) ? 1 : -1, (i & 4) ? 1 : -1);
+
+  auto hull = convexHull(points);
+  ASSERT_TRUE(hull != nullptr);
+  EXPECT_EQ(hull->getVertices().size(), 8u);
+  EXPECT_EQ(hull->getFaceCount(), 12);
+  EXPECT_NEAR(hull->computeVolume(), 8, 1e-4);
+  EXPECT_LE(maxDistanceAboveHull(*hull, points), 1e-4);
+
+  // Points which do not span a volume have no hull
+  std::vector<Vector3<S>> planar;
+  for(int i = 0; i < 100; ++i)
+    planar.emplace_back(Vector3<S>::Random()[0], Vector3<S>::Random()[1], 0);
+  EXPECT_TRUE(convexHull(planar) == nullptr);
+}
+
+//==============================================================================
+template <typename S>
+void test_convex_hull_sphere()
+{
+  const std::vector<Vector3<S>> points = randomPointsOnSphere<S>(2000, 2);
+
+  S error = -1;
+  auto hull = convexHull(points, 0, 1, &error);
+  ASSERT_TRUE(hull != nullptr);
+  EXPECT_EQ(error, 0);
+  EXPECT_EQ(hull->getVertices().size(), points.size());
+  // Euler: a triangulated sphere with V vertices has 2V - 4 triangles
+  EXPECT_EQ(hull->getFaceCount(), 2 * static_cast<int>(points.size()) - 4);
+  EXPECT_LE(maxDistanceAboveHull(*hull, points), 1e-4);
+
+  // The hull of the hulls of chunks is the same
+  auto parallel_hull = convexHull(points, 0, 4);
+  ASSERT_TRUE(parallel_hull != nullptr);
+  EXPECT_EQ(parallel_hull->getVertices().size(), points.size());
+  EXPECT_NEAR(parallel_hull->computeVolume(), hull->computeVolume(), 1e-4);
+
+  // Simplification keeps the hull inside and reports how far it is
+  auto simple_hull = convexHull(points, 32, 1, &error);
+  ASSERT_TRUE(simple_hull != nullptr);
+  EXPECT_LE(simple_hull->getVertices().size(), 32u);
+  EXPECT_GT(error, 0);
+  EXPECT_LT(error, 1);
+  EXPECT_LE(maxDistanceAboveHull(*simple_hull, points), error + 1e-4);
+  EXPECT_LE(maxDistanceAboveHull(*hull, simple_hull->getVertices()), 1e-4);
+  EXPECT_LT(simple_hull->computeVolume(), hull->computeVolume());
+}
+
+//==============================================================================
+template <typename S>
+void test_convex_hull_bvh_model()
+{
+  BVHModel<OBBRSS<S>> model;
+  generateBVHModel(model, Sphere<S>(1), Transform3<S>::Identity(), 16, 16);
+
+  auto hull = convexHull(model);
+  ASSERT_TRUE(hull != nullptr);
+  // the poles of the tessellation may be repeated
+  EXPECT_LE(hull->getVertices().size(), static_cast<std::size_t>(model.num_vertices));
+  EXPECT_GT(hull->getVertices().size(), static_cast<std::size_t>(model.num_vertices / 2));
+
+  const std::vector<Vector3<S>> points(model.vertices, model.vertices + model.num_vertices);
+  EXPECT_LE(maxDistanceAboveHull(*hull, points), 1e-4);
+
+  // The hull of a convex mesh collides like the mesh
+  auto mesh = std::make_shared<BVHModel<OBBRSS<S>>>(model);
+  auto box = std::make_shared<Box<S>>(S(0.5), S(0.5), S(0.5));
+
+  S extents[] = {-2, -2, -2, 2, 2, 2};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, 200);
+
+  CollisionRequest<S> request;
+  for(const auto& tf : transforms)
+  {
+    CollisionResult<S> mesh_result;
+    collide(mesh.get(), Transform3<S>::Identity(), box.get(), tf, request, mesh_result);
+    CollisionResult<S> hull_result;
+    collide(hull.get(), Transform3<S>::Identity(), box.get(), tf, request, hull_result);
+
+    // The mesh is hollow and the hull is solid, so they only differ when the
+    // box is inside the mesh
+    if(mesh_result.isCollision())
+    {
+      EXPECT_TRUE(hull_result.isCollision());
+    }
+    else if(hull_result.isCollision())
+    {
+      EXPECT_LT(tf.translation().norm(), 1);
+    }
+  }
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONVEX_HULL, box)
+{
+  test_convex_hull_box<float>();
+  test_convex_hull_box<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONVEX_HULL, sphere)
+{
+  test_convex_hull_sphere<float>();
+  test_convex_hull_sphere<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_CONVEX_HULL, bvh_model)
+{
+  test_convex_hull_bvh_model<double>();
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
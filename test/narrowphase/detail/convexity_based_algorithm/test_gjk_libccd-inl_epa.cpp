@@ -1586,6 +1586,80 @@ GTEST_TEST(FCL_GJK_EPA, convert2SimplexToTetrahedron) {
   TestSimplexToPolytope3<float>();
 }
 
+
+// Runs EPA on the penetrating shapes s1 and s2 with and without a polytope
+// storage, and checks that both pick the same nearest feature. The storage is
+// shared by the calls, as it is across the queries of ccdGJKSignedDist().
+template <typename Shape1, typename Shape2>
+void CheckEPAWithStorage(const Shape1& s1, const Transform3<double>& X_WS1,
+                         const Shape2& s2, const Transform3<double>& X_WS2,
+                         libccd_extension::PolytopeStorage* storage) {
+  using Initializer1 = GJKInitializer<double, Shape1>;
+  using Initializer2 = GJKInitializer<double, Shape2>;
+  void* o1 = Initializer1::createGJKObject(s1, X_WS1);
+  void* o2 = Initializer2::createGJKObject(s2, X_WS2);
+  ccd_t ccd;
+  CCD_INIT(&ccd);
+  ccd.support1 = Initializer1::getSupportFunction();
+  ccd.support2 = Initializer2::getSupportFunction();
+  ccd.max_iterations = 1000;
+  ccd.dist_tolerance = 1E-6;
+
+  ccd_simplex_t simplex;
+  ASSERT_EQ(libccd_extension::__ccdGJK(o1, o2, &ccd, &simplex), 0);
+  ccd_simplex_t simplex_pooled = simplex;
+
+  ccd_pt_t polytope;
+  ccd_pt_el_t* nearest;
+  ccdPtInit(&polytope);
+  ASSERT_EQ(libccd_extension::__ccdEPA(o1, o2, &ccd, &simplex, &polytope,
+                                       &nearest),
+            0);
+
+  storage->reset();
+  ccd_pt_t polytope_pooled;
+  ccd_pt_el_t* nearest_pooled;
+  ccdPtInit(&polytope_pooled);
+  ASSERT_EQ(libccd_extension::__ccdEPA(o1, o2, &ccd, &simplex_pooled,
+                                       &polytope_pooled, &nearest_pooled,
+                                       storage),
+            0);
+
+  ASSERT_NE(nearest, nullptr);
+  ASSERT_NE(nearest_pooled, nullptr);
+  EXPECT_EQ(nearest_pooled->type, nearest->type);
+  EXPECT_EQ(nearest_pooled->dist, nearest->dist);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_EQ(nearest_pooled->witness.v[i], nearest->witness.v[i]);
+
+  ccdPtDestroy(&polytope);
+  Initializer1::deleteGJKObject(o1);
+  Initializer2::deleteGJKObject(o2);
+}
+
+GTEST_TEST(FCL_GJK_EPA, PolytopeStorage) {
+  libccd_extension::PolytopeStorage storage;
+
+  Transform3<double> X_WB1 = Transform3<double>::Identity();
+  Transform3<double> X_WB2 = Transform3<double>::Identity();
+  X_WB2.translation() << 0.6, 0.1, 0.2;
+  CheckEPAWithStorage(Box<double>(2, 2, 2), X_WB1, Box<double>(1, 1, 2), X_WB2,
+                      &storage);
+
+  X_WB2.linear() =
+      AngleAxis<double>(0.3, Vector3<double>(1, 2, 3).normalized())
+          .toRotationMatrix();
+  CheckEPAWithStorage(Box<double>(2, 2, 2), X_WB1, Box<double>(1, 1, 2), X_WB2,
+                      &storage);
+
+  // Curved shapes expand the polytope for many iterations, so that the
+  // nearest face is often renewed from the heap.
+  CheckEPAWithStorage(Cylinder<double>(1, 2), X_WB1, Ellipsoid<double>(1, 2, 3),
+                      X_WB2, &storage);
+  CheckEPAWithStorage(Sphere<double>(1), X_WB1, Capsule<double>(0.5, 2), X_WB2,
+                      &storage);
+}
+
 }  // namespace detail
 }  // namespace fcl
 
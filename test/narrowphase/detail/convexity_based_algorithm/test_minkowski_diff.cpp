@@ -0,0 +1,194 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "fcl/narrowphase/detail/convexity_based_algorithm/minkowski_diff.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "fcl/math/constants.h"
+#include "test_fcl_utility.h"
+
+namespace fcl {
+namespace detail {
+namespace {
+
+template <typename S>
+Convex<S> makeCube(S half)
+{
+  auto vertices = std::make_shared<std::vector<Vector3<S>>>();
+  for (int i = 0; i < 8; ++i)
+    vertices->emplace_back((i & 1) ? half : -half, (i & 2) ? half : -half,
+                           (i & 4) ? half : -half);
+  auto faces = std::make_shared<std::vector<int>>(std::initializer_list<int>{
+      4, 0, 2, 3, 1,
+      4, 4, 5, 7, 6,
+      4, 0, 1, 5, 4,
+      4, 2, 6, 7, 3,
+      4, 0, 4, 6, 2,
+      4, 1, 3, 7, 5});
+  return Convex<S>(vertices, 6, faces);
+}
+
+template <typename S>
+std::vector<Vector3<S>> makeDirections(int n)
+{
+  std::vector<Vector3<S>> directions;
+  for (int i = 0; i < n; ++i) {
+    const S a = S(0.37) * i;
+    const S b = S(0.11) * i;
+    directions.emplace_back(std::cos(a) * std::cos(b), std::sin(a) * std::cos(b),
+                            std::sin(b));
+  }
+  return directions;
+}
+
+// The support function bound to the concrete type gives the same answer as
+// the one dispatching on the node type.
+template <typename S, typename Shape>
+void testTypedSupport(const Shape& shape)
+{
+  for (const auto& d : makeDirections<S>(200)) {
+    int hint_typed = 0;
+    int hint_dynamic = 0;
+    const Vector3<S> typed = getTypedSupport<S, Shape>(&shape, d, &hint_typed);
+    const Vector3<S> dynamic = getSupport(&shape, d, &hint_dynamic);
+    EXPECT_EQ(typed, dynamic) << shape.getNodeType();
+    EXPECT_EQ(hint_typed, hint_dynamic);
+  }
+}
+
+template <typename S>
+void testAllTypedSupports()
+{
+  testTypedSupport<S>(Box<S>(1, 2, 3));
+  testTypedSupport<S>(Sphere<S>(0.5));
+  testTypedSupport<S>(Ellipsoid<S>(1, 2, 3));
+  testTypedSupport<S>(Capsule<S>(0.5, 2));
+  testTypedSupport<S>(Cone<S>(0.5, 2));
+  testTypedSupport<S>(Cylinder<S>(0.5, 2));
+  testTypedSupport<S>(makeCube<S>(0.5));
+  testTypedSupport<S>(TriangleP<S>(Vector3<S>(0, 0, 0), Vector3<S>(1, 0, 0),
+                                   Vector3<S>(0, 1, 1)));
+}
+
+GTEST_TEST(MinkowskiDiff, TypedSupportMatchesDispatch)
+{
+  testAllTypedSupports<double>();
+  testAllTypedSupports<float>();
+}
+
+// Times the support of the Minkowski difference of a shape pair, with the
+// support functions bound by setShapes() or left to the node type dispatch.
+template <typename S, typename Shape0, typename Shape1>
+void benchmarkPair(const std::string& name, const Shape0& shape0,
+                   const Shape1& shape1)
+{
+  Transform3<S> tf = Transform3<S>::Identity();
+  tf.translation() = Vector3<S>(0.1, 0.2, 0.3);
+  tf.linear() = AngleAxis<S>(S(0.3), Vector3<S>::UnitY()).toRotationMatrix();
+
+  MinkowskiDiff<S> dynamic;
+  dynamic.shapes[0] = &shape0;
+  dynamic.shapes[1] = &shape1;
+  dynamic.toshape1 = tf.linear().transpose();
+  dynamic.toshape0 = tf;
+
+  MinkowskiDiff<S> typed;
+  typed.setShapes(&shape0, &shape1);
+  typed.toshape1 = dynamic.toshape1;
+  typed.toshape0 = dynamic.toshape0;
+
+  const std::vector<Vector3<S>> directions = makeDirections<S>(1000);
+#ifdef NDEBUG
+  const int repeats = 1000;
+#else
+  const int repeats = 10;
+#endif
+
+  Vector3<S> sum_dynamic = Vector3<S>::Zero();
+  test::Timer timer_dynamic;
+  timer_dynamic.start();
+  for (int r = 0; r < repeats; ++r)
+    for (const auto& d : directions) sum_dynamic += dynamic.support(d);
+  timer_dynamic.stop();
+
+  Vector3<S> sum_typed = Vector3<S>::Zero();
+  test::Timer timer_typed;
+  timer_typed.start();
+  for (int r = 0; r < repeats; ++r)
+    for (const auto& d : directions) sum_typed += typed.support(d);
+  timer_typed.stop();
+
+  EXPECT_EQ(sum_dynamic, sum_typed) << name;
+  std::cout << name << " support: dispatch "
+            << timer_dynamic.getElapsedTimeInMilliSec() << " ms, typed "
+            << timer_typed.getElapsedTimeInMilliSec() << " ms" << std::endl;
+}
+
+GTEST_TEST(MinkowskiDiff, SupportBenchmark)
+{
+  using S = double;
+  const Box<S> box(1, 2, 3);
+  const Sphere<S> sphere(0.5);
+  const Capsule<S> capsule(0.5, 2);
+  const Cylinder<S> cylinder(0.5, 2);
+  const Cone<S> cone(0.5, 2);
+  const Ellipsoid<S> ellipsoid(1, 2, 3);
+  const Convex<S> cube = makeCube<S>(0.5);
+
+  benchmarkPair<S>("box-box", box, box);
+  benchmarkPair<S>("sphere-box", sphere, box);
+  benchmarkPair<S>("capsule-box", capsule, box);
+  benchmarkPair<S>("cylinder-box", cylinder, box);
+  benchmarkPair<S>("capsule-cylinder", capsule, cylinder);
+  benchmarkPair<S>("cone-cylinder", cone, cylinder);
+  benchmarkPair<S>("ellipsoid-capsule", ellipsoid, capsule);
+  benchmarkPair<S>("convex-box", cube, box);
+}
+
+}  // namespace
+}  // namespace detail
+}  // namespace fcl
+
+//==============================================================================
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
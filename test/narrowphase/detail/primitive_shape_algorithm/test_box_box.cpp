@@ -0,0 +1,327 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+// Tests the box-box axis helpers and the manifold variant of boxBoxIntersect.
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/box_box-inl.h"
+
+#include <gtest/gtest.h>
+
+#include "fcl/narrowphase/detail/gjk_solver_indep.h"
+#include "fcl/geometry/shape/capsule.h"
+#include "fcl/geometry/shape/sphere.h"
+#include "test_fcl_utility.h"
+
+namespace fcl {
+namespace detail {
+namespace {
+
+//==============================================================================
+template <typename S>
+void expectSameContacts(const std::vector<ContactPoint<S>>& a,
+                        const std::vector<ContactPoint<S>>& b, S tol)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (std::size_t i = 0; i < a.size(); ++i)
+  {
+    EXPECT_LT((a[i].pos - b[i].pos).norm(), tol);
+    EXPECT_LT((a[i].normal - b[i].normal).norm(), tol);
+    EXPECT_NEAR(a[i].penetration_depth, b[i].penetration_depth, tol);
+  }
+}
+
+//==============================================================================
+template <typename S>
+void testSeparatingAxis()
+{
+  const Vector3<S> side1(1, 2, 3);
+  const Vector3<S> side2(S(0.5), S(1.5), S(2.5));
+
+  S extents[] = {-3, -3, -3, 3, 3, 3};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, 500);
+
+  for (std::size_t i = 0; i + 1 < transforms.size(); i += 2)
+  {
+    const Transform3<S>& tf1 = transforms[i];
+    const Transform3<S>& tf2 = transforms[i + 1];
+
+    std::vector<ContactPoint<S>> contacts;
+    Vector3<S> normal;
+    S depth;
+    int return_code;
+    boxBox2(side1, tf1, side2, tf2, normal, &depth, &return_code, 4, contacts);
+
+    const int code = boxBoxSeparatingAxis(side1, tf1, side2, tf2);
+    if (code == 0)
+    {
+      EXPECT_NE(return_code, 0);
+      continue;
+    }
+
+    const S d = boxBoxAxisSeparation(code, side1, tf1, side2, tf2);
+    EXPECT_GT(d, 0);
+    // boxBox2 pads the edge axes, so only compare clearly separated pairs
+    if (d > constants<S>::eps_34())
+    {
+      EXPECT_EQ(return_code, 0);
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void testManifoldRestingPair()
+{
+  const Box<S> box1(4, 4, 1);
+  const Box<S> box2(1, 1, 1);
+
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  tf2.translation() = Vector3<S>(S(0.2), S(-0.1), S(0.9));
+  tf2.linear() = AngleAxis<S>(S(0.3), Vector3<S>::UnitZ()).toRotationMatrix();
+
+  std::vector<ContactPoint<S>> expected;
+  ASSERT_TRUE(boxBoxIntersect(box1, tf1, box2, tf2, &expected));
+
+  ContactManifold<S> manifold;
+  std::vector<ContactPoint<S>> contacts;
+  EXPECT_TRUE(boxBoxIntersect(box1, tf1, box2, tf2, manifold, &contacts));
+  EXPECT_TRUE(manifold.isColliding());
+  EXPECT_GE(manifold.getFeatureId(), 1);
+  EXPECT_EQ(manifold.numContacts(), expected.size());
+  expectSameContacts(contacts, expected, S(1e-5));
+
+  // A pair at rest returns the cached contacts
+  EXPECT_TRUE(manifold.revalidate(tf1, tf2, nullptr));
+  contacts.clear();
+  EXPECT_TRUE(boxBoxIntersect(box1, tf1, box2, tf2, manifold, &contacts));
+  expectSameContacts(contacts, expected, S(1e-5));
+
+  // Moving both boxes together keeps the cache valid, and the contacts follow
+  Transform3<S> motion = Transform3<S>::Identity();
+  motion.translation() = Vector3<S>(1, 2, 3);
+  motion.linear() = AngleAxis<S>(S(0.7), Vector3<S>(1, 1, 0).normalized()).toRotationMatrix();
+  const Transform3<S> moved1 = motion * tf1;
+  const Transform3<S> moved2 = motion * tf2;
+  ASSERT_TRUE(manifold.revalidate(moved1, moved2, nullptr));
+  contacts.clear();
+  EXPECT_TRUE(boxBoxIntersect(box1, moved1, box2, moved2, manifold, &contacts));
+  std::vector<ContactPoint<S>> moved_expected;
+  ASSERT_TRUE(boxBoxIntersect(box1, moved1, box2, moved2, &moved_expected));
+  expectSameContacts(contacts, moved_expected, S(1e-4));
+
+  // A relative motion beyond the tolerance runs the full test again
+  tf2.translation()[2] += S(0.05);
+  EXPECT_FALSE(manifold.revalidate(tf1, tf2, nullptr));
+  ASSERT_TRUE(boxBoxIntersect(box1, tf1, box2, tf2, &expected));
+  contacts.clear();
+  EXPECT_TRUE(boxBoxIntersect(box1, tf1, box2, tf2, manifold, &contacts));
+  expectSameContacts(contacts, expected, S(1e-5));
+
+  // Contacts which were not cached cannot be returned
+  manifold.clear();
+  std::vector<ContactPoint<S>>* no_contacts = nullptr;
+  EXPECT_TRUE(boxBoxIntersect(box1, tf1, box2, tf2, manifold, no_contacts));
+  EXPECT_TRUE(manifold.revalidate(tf1, tf2, nullptr));
+  EXPECT_FALSE(manifold.revalidate(tf1, tf2, &contacts));
+}
+
+//==============================================================================
+template <typename S>
+void testManifoldSeparatedPair()
+{
+  const Box<S> box1(1, 2, 3);
+  const Box<S> box2(S(0.5), S(1.5), S(2.5));
+
+  S extents[] = {-2, -2, -2, 2, 2, 2};
+  aligned_vector<Transform3<S>> transforms;
+  test::generateRandomTransforms(extents, transforms, 200);
+
+  // Follow a pair along small motions: the manifold must always agree with the
+  // query without it.
+  ContactManifold<S> manifold;
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  for (const auto& target : transforms)
+  {
+    for (int step = 0; step < 5; ++step)
+    {
+      Transform3<S> tf2 = target;
+      tf2.translation() *= S(1) + S(step) * S(0.01);
+
+      std::vector<ContactPoint<S>> expected;
+      std::vector<ContactPoint<S>> contacts;
+      const bool res = boxBoxIntersect(box1, tf1, box2, tf2, &expected);
+      EXPECT_EQ(boxBoxIntersect(box1, tf1, box2, tf2, manifold, &contacts), res);
+      EXPECT_EQ(manifold.isColliding(), res);
+      if (res)
+      {
+        expectSameContacts(contacts, expected, S(1e-5));
+      }
+      else
+      {
+        EXPECT_GT(boxBoxAxisSeparation(manifold.getFeatureId(), box1.side, tf1,
+                                       box2.side, tf2), 0);
+      }
+    }
+  }
+}
+
+//==============================================================================
+template <typename S>
+void testSolverManifold()
+{
+  GJKSolver_indep<S> solver;
+  const Sphere<S> sphere(1);
+  const Capsule<S> capsule(S(0.5), 2);
+
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  tf2.translation() = Vector3<S>(S(1.2), 0, S(0.3));
+
+  std::vector<ContactPoint<S>> expected;
+  ASSERT_TRUE(solver.shapeIntersect(sphere, tf1, capsule, tf2, &expected));
+
+  ContactManifold<S> manifold;
+  std::vector<ContactPoint<S>> contacts;
+  EXPECT_TRUE(solver.shapeIntersect(sphere, tf1, capsule, tf2, manifold, &contacts));
+  expectSameContacts(contacts, expected, S(1e-5));
+
+  contacts.clear();
+  EXPECT_TRUE(solver.shapeIntersect(sphere, tf1, capsule, tf2, manifold, &contacts));
+  expectSameContacts(contacts, expected, S(1e-5));
+
+  tf2.translation()[0] = 3;
+  EXPECT_FALSE(solver.shapeIntersect(sphere, tf1, capsule, tf2, manifold, &contacts));
+  EXPECT_FALSE(manifold.isColliding());
+
+  // Box pairs go through the box-box manifold test
+  const Box<S> box(1, 1, 1);
+  tf2.translation() = Vector3<S>(S(0.9), 0, 0);
+  manifold.clear();
+  EXPECT_TRUE(solver.shapeIntersect(box, tf1, box, tf2, manifold, &contacts));
+  EXPECT_GE(manifold.getFeatureId(), 1);
+  tf2.translation() = Vector3<S>(S(1.5), 0, 0);
+  EXPECT_FALSE(solver.shapeIntersect(box, tf1, box, tf2, manifold, &contacts));
+  EXPECT_EQ(manifold.getFeatureId(), 1);
+}
+
+//==============================================================================
+template <typename S>
+void testSolverManifoldAppends()
+{
+  GJKSolver_indep<S> solver;
+  const ContactPoint<S> marker(Vector3<S>::UnitZ(), Vector3<S>(7, 7, 7), 3);
+
+  const Sphere<S> sphere(1);
+  const Capsule<S> capsule(S(0.5), 2);
+  const Box<S> box(1, 1, 1);
+  const Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  tf2.translation() = Vector3<S>(S(0.9), 0, S(0.1));
+
+  std::vector<ContactPoint<S>> sphere_expected;
+  ASSERT_TRUE(solver.shapeIntersect(sphere, tf1, capsule, tf2, &sphere_expected));
+  std::vector<ContactPoint<S>> box_expected;
+  ASSERT_TRUE(solver.shapeIntersect(box, tf1, box, tf2, &box_expected));
+
+  // Both the full query and the revalidation of the cached contacts keep the
+  // contacts already in the vector, for the generic path and the box pair
+  ContactManifold<S> sphere_manifold;
+  ContactManifold<S> box_manifold;
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    std::vector<ContactPoint<S>> contacts(1, marker);
+    EXPECT_TRUE(solver.shapeIntersect(sphere, tf1, capsule, tf2,
+                                      sphere_manifold, &contacts));
+    ASSERT_EQ(contacts.size(), sphere_expected.size() + 1);
+    EXPECT_EQ(contacts[0].pos, marker.pos);
+    expectSameContacts(std::vector<ContactPoint<S>>(contacts.begin() + 1, contacts.end()),
+                       sphere_expected, S(1e-5));
+
+    contacts.assign(1, marker);
+    EXPECT_TRUE(solver.shapeIntersect(box, tf1, box, tf2, box_manifold, &contacts));
+    ASSERT_EQ(contacts.size(), box_expected.size() + 1);
+    EXPECT_EQ(contacts[0].pos, marker.pos);
+    expectSameContacts(std::vector<ContactPoint<S>>(contacts.begin() + 1, contacts.end()),
+                       box_expected, S(1e-5));
+  }
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BOX_BOX, separating_axis)
+{
+  testSeparatingAxis<float>();
+  testSeparatingAxis<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BOX_BOX, manifold_resting_pair)
+{
+  testManifoldRestingPair<float>();
+  testManifoldRestingPair<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BOX_BOX, manifold_separated_pair)
+{
+  testManifoldSeparatedPair<float>();
+  testManifoldSeparatedPair<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BOX_BOX, solver_manifold)
+{
+  testSolverManifold<float>();
+  testSolverManifold<double>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BOX_BOX, solver_manifold_appends)
+{
+  testSolverManifoldAppends<float>();
+  testSolverManifoldAppends<double>();
+}
+
+} // namespace
+} // namespace detail
+} // namespace fcl
+
+//==============================================================================
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
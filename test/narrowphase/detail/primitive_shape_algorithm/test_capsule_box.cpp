@@ -0,0 +1,359 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Tests the custom capsule-box tests: distance and collision.
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_box-inl.h"
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "eigen_matrix_compare.h"
+#include "fcl/geometry/convex_hull.h"
+#include "fcl/geometry/shape/box.h"
+#include "fcl/geometry/shape/capsule.h"
+#include "fcl/narrowphase/detail/gjk_solver_indep.h"
+#include "test_fcl_utility.h"
+
+namespace fcl {
+namespace detail {
+namespace {
+
+// A pose with a random orientation and a position in [-extent, extent]^3.
+template <typename S>
+Transform3<S> RandomPose(std::mt19937& generator, S extent) {
+  std::uniform_real_distribution<S> position(-extent, extent);
+  std::normal_distribution<S> quaternion;
+  Transform3<S> pose = Transform3<S>::Identity();
+  pose.linear() = Quaternion<S>(quaternion(generator), quaternion(generator),
+                                quaternion(generator), quaternion(generator))
+                      .normalized()
+                      .toRotationMatrix();
+  pose.translation() << position(generator), position(generator),
+      position(generator);
+  return pose;
+}
+
+// Distance between the capsule and the box by sampling the core segment.
+template <typename S>
+S SampledDistance(const Capsule<S>& capsule, const Transform3<S>& X_FC,
+                  const Box<S>& box, const Transform3<S>& X_FB,
+                  int num_samples) {
+  const Transform3<S> X_BC = X_FB.inverse() * X_FC;
+  S min_distance = std::numeric_limits<S>::max();
+  for (int i = 0; i <= num_samples; ++i) {
+    const S z = capsule.lz * (S(i) / num_samples - S(0.5));
+    const Vector3<S> p_BQ = X_BC * Vector3<S>(0, 0, z);
+    Vector3<S> p_BN;
+    nearestPointInBox(box.side, p_BQ, &p_BN);
+    min_distance = std::min(min_distance, (p_BQ - p_BN).norm());
+  }
+  return min_distance - capsule.radius;
+}
+
+// The configurations are posed in a frame F, itself posed in the world frame.
+template <typename S>
+void DistanceSimpleConfigurations(const Transform3<S>& X_WF) {
+  const S eps = 16 * constants<S>::eps();
+  const Box<S> box(2, 3, 4);
+  const Capsule<S> capsule(0.5, 2);
+
+  // The capsule lies along x, above the +z face.
+  Transform3<S> X_FC = Transform3<S>::Identity();
+  X_FC.linear() = AngleAxis<S>(constants<S>::pi() / 2, Vector3<S>::UnitY())
+                      .toRotationMatrix();
+  X_FC.translation() << 0, 0, 4;
+  S distance;
+  Vector3<S> p_WCb;
+  Vector3<S> p_WBc;
+  EXPECT_TRUE(capsuleBoxDistance(capsule, X_WF * X_FC, box,
+                                 X_WF * Transform3<S>::Identity(), &distance,
+                                 &p_WCb, &p_WBc));
+  EXPECT_NEAR(distance, 1.5, eps);
+  EXPECT_NEAR((X_WF.inverse() * p_WCb)(2), 3.5, eps);
+  EXPECT_NEAR((X_WF.inverse() * p_WBc)(2), 2, eps);
+
+  // The capsule points at the (+x, +y, +z) corner: the end cap is nearest.
+  const Vector3<S> corner(1, 1.5, 2);
+  const Vector3<S> direction = Vector3<S>(1, 1, 1).normalized();
+  X_FC.linear() = Quaternion<S>::FromTwoVectors(Vector3<S>::UnitZ(), direction)
+                      .toRotationMatrix();
+  X_FC.translation() = corner + direction * 2;
+  EXPECT_TRUE(capsuleBoxDistance(capsule, X_WF * X_FC, box, X_WF, &distance,
+                                 &p_WCb, &p_WBc));
+  EXPECT_NEAR(distance, 0.5, eps);
+  EXPECT_TRUE(CompareMatrices(X_WF.inverse() * p_WBc, corner, eps,
+                              MatrixCompareType::absolute));
+  EXPECT_TRUE(CompareMatrices(X_WF.inverse() * p_WCb, corner + direction * 0.5,
+                              eps, MatrixCompareType::absolute));
+
+  // Barely penetrating is not separated.
+  X_FC.translation() = corner + direction * (1.5 - 1e-4);
+  EXPECT_FALSE(capsuleBoxDistance(capsule, X_WF * X_FC, box, X_WF, &distance,
+                                  &p_WCb, &p_WBc));
+  EXPECT_EQ(distance, -1);
+}
+
+template <typename S>
+void CollisionSimpleConfigurations(const Transform3<S>& X_WF) {
+  const S eps = 16 * constants<S>::eps();
+  const Box<S> box(2, 3, 4);
+  const Capsule<S> capsule(0.5, 4);
+  std::vector<ContactPoint<S>> contacts;
+
+  // The capsule lies along z, its lower cap 0.25 into the +z face: the core
+  // is outside of the box.
+  Transform3<S> X_FC = Transform3<S>::Identity();
+  X_FC.translation() << 0.25, 0, 2 + 2 + 0.25;
+  EXPECT_TRUE(capsuleBoxIntersect(capsule, X_WF * X_FC, box, X_WF, &contacts));
+  ASSERT_EQ(contacts.size(), 1u);
+  EXPECT_NEAR(contacts[0].penetration_depth, 0.25, eps);
+  EXPECT_TRUE(CompareMatrices(X_WF.linear().transpose() * contacts[0].normal,
+                              Vector3<S>(0, 0, -1), eps,
+                              MatrixCompareType::absolute));
+  EXPECT_TRUE(CompareMatrices(X_WF.inverse() * contacts[0].pos,
+                              Vector3<S>(0.25, 0, 2 - 0.125), eps,
+                              MatrixCompareType::absolute));
+
+  // The capsule goes through the box along x: the core is inside, and the y
+  // face has priority over the z face it ties with.
+  contacts.clear();
+  const Box<S> cube(2, 2, 2);
+  X_FC.linear() = AngleAxis<S>(constants<S>::pi() / 2, Vector3<S>::UnitY())
+                      .toRotationMatrix();
+  X_FC.translation() << 0, 0, 0;
+  EXPECT_TRUE(capsuleBoxIntersect(capsule, X_WF * X_FC, cube, X_WF, &contacts));
+  ASSERT_EQ(contacts.size(), 1u);
+  EXPECT_NEAR(contacts[0].penetration_depth, 1.5, eps);
+  EXPECT_TRUE(CompareMatrices(X_WF.linear().transpose() * contacts[0].normal,
+                              Vector3<S>(0, -1, 0), eps,
+                              MatrixCompareType::absolute));
+
+  // Separated.
+  contacts.clear();
+  X_FC.translation() << 0, 0, 1 + 0.5 + 0.01;
+  EXPECT_FALSE(capsuleBoxIntersect(capsule, X_WF * X_FC, cube, X_WF, &contacts));
+  EXPECT_TRUE(contacts.empty());
+}
+
+// The separating distance matches a dense sampling of the core segment.
+template <typename S>
+void DistanceMatchesSampling() {
+  std::mt19937 generator(1234);
+  const Box<S> box(0.8, 1.2, 0.5);
+  const Capsule<S> capsule(0.2, 1.5);
+  const int num_samples = 4000;
+  // The error of the sampling is at most half of the sample spacing.
+  const S sampling_error = capsule.lz / num_samples;
+  int num_separated = 0;
+  for (int i = 0; i < 500; ++i) {
+    const Transform3<S> X_FC = RandomPose<S>(generator, 1.5);
+    const Transform3<S> X_FB = RandomPose<S>(generator, 0.2);
+    const S expected = SampledDistance(capsule, X_FC, box, X_FB, num_samples);
+    if (std::abs(expected) < 2 * sampling_error) continue;
+
+    S distance;
+    Vector3<S> p_FCb;
+    Vector3<S> p_FBc;
+    const bool separated =
+        capsuleBoxDistance(capsule, X_FC, box, X_FB, &distance, &p_FCb, &p_FBc);
+    EXPECT_EQ(separated, expected > 0) << "pose " << i;
+    if (!separated) continue;
+
+    ++num_separated;
+    EXPECT_LE(distance, expected + 1e-12) << "pose " << i;
+    EXPECT_GE(distance, expected - sampling_error) << "pose " << i;
+    EXPECT_NEAR((p_FCb - p_FBc).norm(), distance, 1e-12) << "pose " << i;
+  }
+  EXPECT_GT(num_separated, 100);
+}
+
+// The penetration depth is the minimum translation separating the shapes:
+// translating the capsule by the depth along the normal separates them, and
+// by a little less does not.
+template <typename S>
+void CollisionDepthIsMinimal() {
+  std::mt19937 generator(4321);
+  const Box<S> box(0.8, 1.2, 0.5);
+  const Capsule<S> capsule(0.2, 1.5);
+  int num_core_inside = 0;
+  int num_core_outside = 0;
+  for (int i = 0; i < 500; ++i) {
+    const Transform3<S> X_FC = RandomPose<S>(generator, 0.8);
+    const Transform3<S> X_FB = RandomPose<S>(generator, 0.2);
+    std::vector<ContactPoint<S>> contacts;
+    if (!capsuleBoxIntersect(capsule, X_FC, box, X_FB, &contacts)) continue;
+    ASSERT_EQ(contacts.size(), 1u);
+    const ContactPoint<S>& contact = contacts[0];
+    EXPECT_GE(contact.penetration_depth, 0) << "pose " << i;
+    EXPECT_NEAR(contact.normal.norm(), 1, 1e-12) << "pose " << i;
+
+    // A core segment sample inside the box is at distance 0 from it.
+    if (SampledDistance(capsule, X_FC, box, X_FB, 100) <= -capsule.radius)
+      ++num_core_inside;
+    else
+      ++num_core_outside;
+
+    Transform3<S> X_FC_moved = X_FC;
+    X_FC_moved.translation() -= contact.normal * (contact.penetration_depth + 1e-9);
+    EXPECT_TRUE(capsuleBoxDistance(capsule, X_FC_moved, box, X_FB,
+                                   static_cast<S*>(nullptr),
+                                   static_cast<Vector3<S>*>(nullptr),
+                                   static_cast<Vector3<S>*>(nullptr)))
+        << "pose " << i;
+
+    if (contact.penetration_depth > 1e-6) {
+      X_FC_moved.translation() = X_FC.translation()
+          - contact.normal * (contact.penetration_depth * (1 - 1e-6));
+      EXPECT_TRUE(capsuleBoxIntersect(capsule, X_FC_moved, box, X_FB,
+                                      static_cast<std::vector<ContactPoint<S>>*>(nullptr)))
+          << "pose " << i;
+    }
+  }
+  EXPECT_GT(num_core_inside, 20);
+  EXPECT_GT(num_core_outside, 20);
+}
+
+// Compares the kernels with GJK/EPA on the convex hull of the box, and reports
+// the time of both.
+template <typename S>
+void VersusGJK() {
+  std::mt19937 generator(2468);
+  const Box<S> box(0.8, 1.2, 0.5);
+  const Capsule<S> capsule(0.2, 1.5);
+  std::vector<Vector3<S>> corners;
+  for (int k = 0; k < 8; ++k) {
+    corners.emplace_back((k & 1) ? 0.4 : -0.4, (k & 2) ? 0.6 : -0.6,
+                         (k & 4) ? 0.25 : -0.25);
+  }
+  const std::shared_ptr<Convex<S>> convex = convexHull(corners);
+  ASSERT_NE(convex, nullptr);
+
+  const int num_poses = 2000;
+  std::vector<Transform3<S>> X_FC(num_poses);
+  for (auto& pose : X_FC) pose = RandomPose<S>(generator, 1.2);
+  const Transform3<S> X_FB = Transform3<S>::Identity();
+
+  GJKSolver_indep<S> solver;
+  std::vector<S> kernel_distances(num_poses);
+  std::vector<S> gjk_distances(num_poses);
+  std::vector<bool> kernel_collisions(num_poses);
+  std::vector<bool> gjk_collisions(num_poses);
+
+  test::Timer timer;
+  timer.start();
+  for (int i = 0; i < num_poses; ++i) {
+    kernel_collisions[i] = capsuleBoxIntersect(
+        capsule, X_FC[i], box, X_FB,
+        static_cast<std::vector<ContactPoint<S>>*>(nullptr));
+    capsuleBoxDistance(capsule, X_FC[i], box, X_FB, &kernel_distances[i],
+                       static_cast<Vector3<S>*>(nullptr),
+                       static_cast<Vector3<S>*>(nullptr));
+  }
+  timer.stop();
+  const double kernel_time = timer.getElapsedTimeInMicroSec();
+
+  timer.start();
+  for (int i = 0; i < num_poses; ++i) {
+    gjk_collisions[i] = solver.shapeIntersect(
+        capsule, X_FC[i], *convex, X_FB,
+        static_cast<std::vector<ContactPoint<S>>*>(nullptr));
+    solver.shapeDistance(capsule, X_FC[i], *convex, X_FB, &gjk_distances[i],
+                         static_cast<Vector3<S>*>(nullptr),
+                         static_cast<Vector3<S>*>(nullptr));
+  }
+  timer.stop();
+  const double gjk_time = timer.getElapsedTimeInMicroSec();
+
+  for (int i = 0; i < num_poses; ++i) {
+    // GJK is accurate up to its tolerance.
+    if (kernel_distances[i] > 1e-5)
+    {
+      EXPECT_FALSE(gjk_collisions[i]) << "pose " << i;
+      EXPECT_NEAR(kernel_distances[i], gjk_distances[i], 1e-5) << "pose " << i;
+    }
+    else if (kernel_distances[i] == -1)
+    {
+      EXPECT_TRUE(kernel_collisions[i]) << "pose " << i;
+    }
+  }
+
+  std::cout << "capsule-box, " << num_poses
+            << " collision and distance queries: kernels " << kernel_time
+            << " us, GJK " << gjk_time << " us" << std::endl;
+}
+
+GTEST_TEST(CapsuleBoxPrimitiveTest, DistanceSimpleConfigurations) {
+  Transform3<double> X_WF = Transform3<double>::Identity();
+  DistanceSimpleConfigurations<double>(X_WF);
+  DistanceSimpleConfigurations<float>(X_WF.cast<float>());
+  X_WF.linear() = AngleAxis<double>(0.7, Vector3<double>(1, -2, 3).normalized())
+                      .toRotationMatrix();
+  X_WF.translation() << 1, 2, -3;
+  DistanceSimpleConfigurations<double>(X_WF);
+}
+
+GTEST_TEST(CapsuleBoxPrimitiveTest, CollisionSimpleConfigurations) {
+  Transform3<double> X_WF = Transform3<double>::Identity();
+  CollisionSimpleConfigurations<double>(X_WF);
+  CollisionSimpleConfigurations<float>(X_WF.cast<float>());
+  X_WF.linear() = AngleAxis<double>(0.7, Vector3<double>(1, -2, 3).normalized())
+                      .toRotationMatrix();
+  X_WF.translation() << 1, 2, -3;
+  CollisionSimpleConfigurations<double>(X_WF);
+}
+
+GTEST_TEST(CapsuleBoxPrimitiveTest, DistanceMatchesSampling) {
+  DistanceMatchesSampling<double>();
+}
+
+GTEST_TEST(CapsuleBoxPrimitiveTest, CollisionDepthIsMinimal) {
+  CollisionDepthIsMinimal<double>();
+}
+
+GTEST_TEST(CapsuleBoxPrimitiveTest, VersusGJK) {
+  VersusGJK<double>();
+}
+
+} // namespace
+} // namespace detail
+} // namespace fcl
+
+//==============================================================================
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,243 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Tests the custom capsule-cylinder distance.
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/capsule_cylinder-inl.h"
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "eigen_matrix_compare.h"
+#include "fcl/geometry/shape/capsule.h"
+#include "fcl/geometry/shape/cylinder.h"
+#include "fcl/narrowphase/detail/gjk_solver_libccd.h"
+#include "test_fcl_utility.h"
+
+namespace fcl {
+namespace detail {
+namespace {
+
+// A pose with a random orientation and a position in [-extent, extent]^3.
+template <typename S>
+Transform3<S> RandomPose(std::mt19937& generator, S extent) {
+  std::uniform_real_distribution<S> position(-extent, extent);
+  std::normal_distribution<S> quaternion;
+  Transform3<S> pose = Transform3<S>::Identity();
+  pose.linear() = Quaternion<S>(quaternion(generator), quaternion(generator),
+                                quaternion(generator), quaternion(generator))
+                      .normalized()
+                      .toRotationMatrix();
+  pose.translation() << position(generator), position(generator),
+      position(generator);
+  return pose;
+}
+
+// Distance between the capsule and the cylinder by sampling the core segment.
+template <typename S>
+S SampledDistance(const Capsule<S>& capsule, const Transform3<S>& X_FC,
+                  const Cylinder<S>& cylinder, const Transform3<S>& X_FY,
+                  int num_samples) {
+  const Transform3<S> X_YC = X_FY.inverse() * X_FC;
+  S min_distance = std::numeric_limits<S>::max();
+  for (int i = 0; i <= num_samples; ++i) {
+    const S z = capsule.lz * (S(i) / num_samples - S(0.5));
+    const Vector3<S> p_YQ = X_YC * Vector3<S>(0, 0, z);
+    Vector3<S> p_YN;
+    nearestPointInCylinder(cylinder.lz, cylinder.radius, p_YQ, &p_YN);
+    min_distance = std::min(min_distance, (p_YQ - p_YN).norm());
+  }
+  return min_distance - capsule.radius;
+}
+
+template <typename S>
+void DistanceSimpleConfigurations(const Transform3<S>& X_WF) {
+  // The search stops at a parameter tolerance of ε^¾, which bounds the error
+  // on the distance by the length of the capsule times ε^¾.
+  const S eps = 4 * constants<S>::eps_34();
+  const Cylinder<S> cylinder(1, 2);
+  const Capsule<S> capsule(0.25, 2);
+  S distance;
+  Vector3<S> p_WCy;
+  Vector3<S> p_WYc;
+
+  // The capsule lies along x, above the top cap.
+  Transform3<S> X_FC = Transform3<S>::Identity();
+  X_FC.linear() = AngleAxis<S>(constants<S>::pi() / 2, Vector3<S>::UnitY())
+                      .toRotationMatrix();
+  X_FC.translation() << 0.5, 0, 1 + 0.25 + 0.5;
+  EXPECT_TRUE(capsuleCylinderDistance(capsule, X_WF * X_FC, cylinder, X_WF,
+                                      &distance, &p_WCy, &p_WYc));
+  EXPECT_NEAR(distance, 0.5, eps);
+  EXPECT_NEAR((X_WF.inverse() * p_WCy)(2), 1.5, eps);
+  EXPECT_NEAR((X_WF.inverse() * p_WYc)(2), 1, eps);
+
+  // The capsule stands beside the side.
+  X_FC.linear().setIdentity();
+  X_FC.translation() << 0, 1 + 0.25 + 0.3, 0.5;
+  EXPECT_TRUE(capsuleCylinderDistance(capsule, X_WF * X_FC, cylinder, X_WF,
+                                      &distance, &p_WCy, &p_WYc));
+  EXPECT_NEAR(distance, 0.3, eps);
+  EXPECT_NEAR((X_WF.inverse() * p_WYc)(1), 1, eps);
+
+  // The capsule points at the rim.
+  const Vector3<S> rim(1, 0, 1);
+  const Vector3<S> direction = Vector3<S>(1, 0, 1).normalized();
+  X_FC.linear() = Quaternion<S>::FromTwoVectors(Vector3<S>::UnitZ(), direction)
+                      .toRotationMatrix();
+  X_FC.translation() = rim + direction * (1 + 0.25 + 0.4);
+  EXPECT_TRUE(capsuleCylinderDistance(capsule, X_WF * X_FC, cylinder, X_WF,
+                                      &distance, &p_WCy, &p_WYc));
+  EXPECT_NEAR(distance, 0.4, eps);
+  EXPECT_TRUE(CompareMatrices(X_WF.inverse() * p_WYc, rim, eps,
+                              MatrixCompareType::absolute));
+
+  // Penetrating.
+  X_FC.translation() = rim + direction * (1 + 0.25 - 0.1);
+  EXPECT_FALSE(capsuleCylinderDistance(capsule, X_WF * X_FC, cylinder, X_WF,
+                                       &distance, &p_WCy, &p_WYc));
+  EXPECT_EQ(distance, -1);
+}
+
+template <typename S>
+void DistanceMatchesSampling() {
+  std::mt19937 generator(1234);
+  const Cylinder<S> cylinder(0.4, 1.1);
+  const Capsule<S> capsule(0.2, 1.5);
+  const int num_samples = 4000;
+  const S sampling_error = capsule.lz / num_samples;
+  int num_separated = 0;
+  for (int i = 0; i < 500; ++i) {
+    const Transform3<S> X_FC = RandomPose<S>(generator, 1.5);
+    const Transform3<S> X_FY = RandomPose<S>(generator, 0.2);
+    const S expected =
+        SampledDistance(capsule, X_FC, cylinder, X_FY, num_samples);
+    if (std::abs(expected) < 2 * sampling_error) continue;
+
+    S distance;
+    Vector3<S> p_FCy;
+    Vector3<S> p_FYc;
+    const bool separated = capsuleCylinderDistance(capsule, X_FC, cylinder,
+                                                   X_FY, &distance, &p_FCy,
+                                                   &p_FYc);
+    EXPECT_EQ(separated, expected > 0) << "pose " << i;
+    if (!separated) continue;
+
+    ++num_separated;
+    EXPECT_LE(distance, expected + 1e-9) << "pose " << i;
+    EXPECT_GE(distance, expected - sampling_error) << "pose " << i;
+    EXPECT_NEAR((p_FCy - p_FYc).norm(), distance, 1e-12) << "pose " << i;
+  }
+  EXPECT_GT(num_separated, 100);
+}
+
+// Compares the kernel with GJK, and reports the time of both.
+template <typename S>
+void VersusGJK() {
+  std::mt19937 generator(2468);
+  const Cylinder<S> cylinder(0.4, 1.1);
+  const Capsule<S> capsule(0.2, 1.5);
+  const int num_poses = 2000;
+  std::vector<Transform3<S>> X_FC(num_poses);
+  for (auto& pose : X_FC) pose = RandomPose<S>(generator, 1.2);
+  const Transform3<S> X_FY = Transform3<S>::Identity();
+
+  // The libccd solver has no custom capsule-cylinder algorithm.
+  GJKSolver_libccd<S> solver;
+  std::vector<S> kernel_distances(num_poses);
+  std::vector<S> gjk_distances(num_poses);
+
+  test::Timer timer;
+  timer.start();
+  for (int i = 0; i < num_poses; ++i) {
+    capsuleCylinderDistance(capsule, X_FC[i], cylinder, X_FY,
+                            &kernel_distances[i],
+                            static_cast<Vector3<S>*>(nullptr),
+                            static_cast<Vector3<S>*>(nullptr));
+  }
+  timer.stop();
+  const double kernel_time = timer.getElapsedTimeInMicroSec();
+
+  timer.start();
+  for (int i = 0; i < num_poses; ++i) {
+    solver.shapeDistance(capsule, X_FC[i], cylinder, X_FY, &gjk_distances[i],
+                         static_cast<Vector3<S>*>(nullptr),
+                         static_cast<Vector3<S>*>(nullptr));
+  }
+  timer.stop();
+  const double gjk_time = timer.getElapsedTimeInMicroSec();
+
+  for (int i = 0; i < num_poses; ++i) {
+    // GJK converges slowly on the curved side of the cylinder: its distance
+    // is an upper bound, a little above the exact one.
+    if (kernel_distances[i] > 1e-5 && gjk_distances[i] > 1e-5) {
+      EXPECT_LE(kernel_distances[i], gjk_distances[i] + 1e-9) << "pose " << i;
+      EXPECT_NEAR(kernel_distances[i], gjk_distances[i], 1e-3) << "pose " << i;
+    }
+  }
+
+  std::cout << "capsule-cylinder, " << num_poses
+            << " distance queries: kernel " << kernel_time << " us, GJK "
+            << gjk_time << " us" << std::endl;
+}
+
+GTEST_TEST(CapsuleCylinderPrimitiveTest, DistanceSimpleConfigurations) {
+  Transform3<double> X_WF = Transform3<double>::Identity();
+  DistanceSimpleConfigurations<double>(X_WF);
+  DistanceSimpleConfigurations<float>(X_WF.cast<float>());
+  X_WF.linear() = AngleAxis<double>(0.7, Vector3<double>(1, -2, 3).normalized())
+                      .toRotationMatrix();
+  X_WF.translation() << 1, 2, -3;
+  DistanceSimpleConfigurations<double>(X_WF);
+}
+
+GTEST_TEST(CapsuleCylinderPrimitiveTest, DistanceMatchesSampling) {
+  DistanceMatchesSampling<double>();
+}
+
+GTEST_TEST(CapsuleCylinderPrimitiveTest, VersusGJK) {
+  VersusGJK<double>();
+}
+
+} // namespace
+} // namespace detail
+} // namespace fcl
+
+//==============================================================================
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
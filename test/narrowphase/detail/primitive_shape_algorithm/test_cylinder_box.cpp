@@ -0,0 +1,151 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Tests the custom cylinder-box separation test.
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/cylinder_box-inl.h"
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "fcl/geometry/shape/box.h"
+#include "fcl/geometry/shape/cylinder.h"
+#include "fcl/narrowphase/detail/gjk_solver_libccd.h"
+#include "test_fcl_utility.h"
+
+namespace fcl {
+namespace detail {
+namespace {
+
+// A pose with a random orientation and a position in [-extent, extent]^3.
+template <typename S>
+Transform3<S> RandomPose(std::mt19937& generator, S extent) {
+  std::uniform_real_distribution<S> position(-extent, extent);
+  std::normal_distribution<S> quaternion;
+  Transform3<S> pose = Transform3<S>::Identity();
+  pose.linear() = Quaternion<S>(quaternion(generator), quaternion(generator),
+                                quaternion(generator), quaternion(generator))
+                      .normalized()
+                      .toRotationMatrix();
+  pose.translation() << position(generator), position(generator),
+      position(generator);
+  return pose;
+}
+
+GTEST_TEST(CylinderBoxPrimitiveTest, SimpleConfigurations) {
+  using S = double;
+  const Cylinder<S> cylinder(0.5, 2);
+  const Box<S> box(2, 2, 2);
+  Transform3<S> X_FY = Transform3<S>::Identity();
+
+  // Above the +z face.
+  X_FY.translation() << 0, 0, 2.01;
+  EXPECT_TRUE(cylinderBoxSeparated(cylinder, X_FY, box, Transform3<S>::Identity()));
+  X_FY.translation() << 0, 0, 1.99;
+  EXPECT_FALSE(cylinderBoxSeparated(cylinder, X_FY, box, Transform3<S>::Identity()));
+
+  // Lying along x, beside the (+y, +z) edge: separated by the direction from
+  // the edge to the axis.
+  X_FY.linear() = AngleAxis<S>(constants<S>::pi() / 2, Vector3<S>::UnitY())
+                      .toRotationMatrix();
+  const S offset = (0.5 + 0.01) / std::sqrt(S(2));
+  X_FY.translation() << 0, 1 + offset, 1 + offset;
+  EXPECT_TRUE(cylinderBoxSeparated(cylinder, X_FY, box, Transform3<S>::Identity()));
+}
+
+// The test never reports intersecting shapes as separated, and it is
+// conclusive for most of the separated ones. Reports the time of the test
+// and of GJK.
+GTEST_TEST(CylinderBoxPrimitiveTest, VersusGJK) {
+  using S = double;
+  std::mt19937 generator(1357);
+  const Cylinder<S> cylinder(0.3, 1.2);
+  const Box<S> box(0.8, 1.2, 0.5);
+  const int num_poses = 2000;
+  std::vector<Transform3<S>> X_FY(num_poses);
+  for (auto& pose : X_FY) pose = RandomPose<S>(generator, 1.5);
+  const Transform3<S> X_FB = Transform3<S>::Identity();
+
+  // The libccd solver has no custom cylinder-box algorithm.
+  GJKSolver_libccd<S> solver;
+  std::vector<bool> separated(num_poses);
+  std::vector<S> gjk_distances(num_poses);
+
+  test::Timer timer;
+  timer.start();
+  for (int i = 0; i < num_poses; ++i)
+    separated[i] = cylinderBoxSeparated(cylinder, X_FY[i], box, X_FB);
+  timer.stop();
+  const double separation_time = timer.getElapsedTimeInMicroSec();
+
+  timer.start();
+  for (int i = 0; i < num_poses; ++i) {
+    solver.shapeDistance(cylinder, X_FY[i], box, X_FB, &gjk_distances[i],
+                         static_cast<Vector3<S>*>(nullptr),
+                         static_cast<Vector3<S>*>(nullptr));
+  }
+  timer.stop();
+  const double gjk_time = timer.getElapsedTimeInMicroSec();
+
+  int num_gjk_separated = 0;
+  int num_conclusive = 0;
+  for (int i = 0; i < num_poses; ++i) {
+    // GJK is accurate up to its tolerance.
+    if (separated[i]) {
+      EXPECT_GT(gjk_distances[i], -1e-6) << "pose " << i;
+    }
+    if (gjk_distances[i] > 1e-3) {
+      ++num_gjk_separated;
+      if (separated[i]) ++num_conclusive;
+    }
+  }
+  EXPECT_GT(num_conclusive, 0.9 * num_gjk_separated);
+
+  std::cout << "cylinder-box, " << num_poses << " queries: separating axes "
+            << separation_time << " us, GJK distance " << gjk_time << " us, "
+            << num_conclusive << " of " << num_gjk_separated
+            << " separated pairs proven" << std::endl;
+}
+
+} // namespace
+} // namespace detail
+} // namespace fcl
+
+//==============================================================================
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,261 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// Tests the batched shape-triangle separation tests and the mesh-shape leaf
+// testing built on them.
+
+#include "fcl/narrowphase/detail/primitive_shape_algorithm/shape_triangles-inl.h"
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/detail/gjk_solver_libccd.h"
+#include "test_fcl_utility.h"
+
+namespace fcl {
+namespace detail {
+namespace {
+
+// A pose with a random orientation and a position in [-extent, extent]^3.
+template <typename S>
+Transform3<S> RandomPose(std::mt19937& generator, S extent) {
+  std::uniform_real_distribution<S> position(-extent, extent);
+  std::normal_distribution<S> quaternion;
+  Transform3<S> pose = Transform3<S>::Identity();
+  pose.linear() = Quaternion<S>(quaternion(generator), quaternion(generator),
+                                quaternion(generator), quaternion(generator))
+                      .normalized()
+                      .toRotationMatrix();
+  pose.translation() << position(generator), position(generator),
+      position(generator);
+  return pose;
+}
+
+// Triangles with their centers in [-extent, extent]^3 and edges up to size.
+template <typename S>
+TriangleBatch<S> RandomTriangles(std::mt19937& generator, int count, S extent,
+                                 S size) {
+  std::uniform_real_distribution<S> center(-extent, extent);
+  std::uniform_real_distribution<S> offset(-size / 2, size / 2);
+  TriangleBatch<S> triangles;
+  for (int i = 0; i < count; ++i) {
+    const Vector3<S> c(center(generator), center(generator), center(generator));
+    Vector3<S> v[3];
+    for (auto& p : v)
+      p = c + Vector3<S>(offset(generator), offset(generator), offset(generator));
+    triangles.push_back(v[0], v[1], v[2]);
+  }
+  return triangles;
+}
+
+template <typename S>
+void Vertices(const TriangleBatch<S>& triangles, int i, Vector3<S>* a,
+              Vector3<S>* b, Vector3<S>* c) {
+  *a << triangles.ax[i], triangles.ay[i], triangles.az[i];
+  *b << triangles.bx[i], triangles.by[i], triangles.bz[i];
+  *c << triangles.cx[i], triangles.cy[i], triangles.cz[i];
+}
+
+// Compares the batched test of the shape with the libccd distance of each
+// triangle. Returns the fraction of the triangles farther than 1e-3 which the
+// batched test proved separated.
+template <typename Shape>
+double CompareWithGJK(const Shape& shape, const char* name) {
+  using S = typename Shape::S;
+  std::mt19937 generator(2468);
+  const int num_triangles = 4000;
+  const TriangleBatch<S> triangles =
+      RandomTriangles<S>(generator, num_triangles, 1.5, 1);
+  const Transform3<S> X_FS = RandomPose<S>(generator, 0.2);
+
+  std::vector<unsigned char> separated;
+  test::Timer timer;
+  timer.start();
+  shapeTrianglesSeparated(shape, X_FS, triangles, &separated);
+  timer.stop();
+  const double batch_time = timer.getElapsedTimeInMicroSec();
+  EXPECT_EQ(static_cast<int>(separated.size()), num_triangles);
+
+  GJKSolver_libccd<S> solver;
+  std::vector<S> distances(num_triangles);
+  timer.start();
+  for (int i = 0; i < num_triangles; ++i) {
+    Vector3<S> a, b, c;
+    Vertices(triangles, i, &a, &b, &c);
+    if (!solver.shapeTriangleDistance(shape, X_FS, a, b, c, &distances[i]))
+      distances[i] = -1;
+  }
+  timer.stop();
+  const double gjk_time = timer.getElapsedTimeInMicroSec();
+
+  int num_gjk_separated = 0;
+  int num_proven = 0;
+  for (int i = 0; i < num_triangles; ++i) {
+    // GJK is accurate up to its tolerance.
+    if (separated[i]) {
+      EXPECT_GT(distances[i], -1e-6) << name << " triangle " << i;
+    }
+    if (distances[i] > 1e-3) {
+      ++num_gjk_separated;
+      if (separated[i]) ++num_proven;
+    }
+  }
+  EXPECT_GT(num_gjk_separated, 0);
+
+  std::cout << name << "-triangle, " << num_triangles
+            << " triangles: batched separating axes " << batch_time
+            << " us, GJK distance " << gjk_time << " us, " << num_proven
+            << " of " << num_gjk_separated << " separated triangles proven"
+            << std::endl;
+  return static_cast<double>(num_proven) / num_gjk_separated;
+}
+
+GTEST_TEST(ShapeTrianglesPrimitiveTest, SimpleConfigurations) {
+  using S = double;
+  TriangleBatch<S> triangles;
+  // Above the box / capsule, in a plane z = const.
+  triangles.push_back(Vector3<S>(-1, -1, 1.01), Vector3<S>(1, -1, 1.01),
+                      Vector3<S>(0, 1, 1.01));
+  triangles.push_back(Vector3<S>(-1, -1, 0.99), Vector3<S>(1, -1, 0.99),
+                      Vector3<S>(0, 1, 0.99));
+  // Beside the (+x, +y) edge of the box, in the plane x + y = 2.05: only
+  // separated by the triangle normal.
+  triangles.push_back(Vector3<S>(1.2, 0.85, -1), Vector3<S>(0.85, 1.2, -1),
+                      Vector3<S>(1.025, 1.025, 1));
+  // In the plane z = 0, beyond the line x + y = 2.06: only separated by the
+  // cross product of the box's z axis with the edge along (1, -1, 0).
+  triangles.push_back(Vector3<S>(1.53, 0.53, 0), Vector3<S>(0.53, 1.53, 0),
+                      Vector3<S>(3, 3, 0));
+  EXPECT_EQ(triangles.size(), 4);
+
+  std::vector<unsigned char> separated;
+  boxTrianglesSeparated(Box<S>(2, 2, 2), Transform3<S>::Identity(), triangles,
+                        &separated);
+  ASSERT_EQ(separated.size(), 4u);
+  EXPECT_TRUE(separated[0]);
+  EXPECT_FALSE(separated[1]);
+  EXPECT_TRUE(separated[2]);
+  EXPECT_TRUE(separated[3]);
+
+  // A capsule along z, reaching z = 1.
+  capsuleTrianglesSeparated(Capsule<S>(0.5, 1), Transform3<S>::Identity(),
+                            triangles, &separated);
+  ASSERT_EQ(separated.size(), 4u);
+  EXPECT_TRUE(separated[0]);
+  EXPECT_FALSE(separated[1]);
+  EXPECT_TRUE(separated[2]);
+  EXPECT_TRUE(separated[3]);
+
+  triangles.clear();
+  EXPECT_EQ(triangles.size(), 0);
+  boxTrianglesSeparated(Box<S>(2, 2, 2), Transform3<S>::Identity(), triangles,
+                        &separated);
+  EXPECT_TRUE(separated.empty());
+}
+
+GTEST_TEST(ShapeTrianglesPrimitiveTest, BoxVersusGJK) {
+  // The box test is exact: all the separated triangles are proven.
+  EXPECT_EQ(CompareWithGJK(Box<double>(0.8, 1.2, 0.5), "box"), 1.0);
+  EXPECT_EQ(CompareWithGJK(Box<float>(0.8f, 1.2f, 0.5f), "box (float)"), 1.0);
+}
+
+GTEST_TEST(ShapeTrianglesPrimitiveTest, CapsuleVersusGJK) {
+  EXPECT_GT(CompareWithGJK(Capsule<double>(0.3, 1.2), "capsule"), 0.9);
+}
+
+// Collides the shape with a dense sphere mesh and checks that the reported
+// triangles are those a per-triangle test finds.
+template <typename Shape>
+void CompareMeshShapeWithBruteForce(const Shape& shape, const char* name) {
+  using S = double;
+  BVHModel<OBBRSS<S>> mesh;
+  generateBVHModel(mesh, Sphere<S>(1), Transform3<S>::Identity(), 64, 64);
+  std::mt19937 generator(97531);
+  GJKSolver_libccd<S> solver;
+
+  CollisionRequest<S> request(100000, false);
+  int num_colliding = 0;
+  double traversal_time = 0;
+  test::Timer timer;
+  for (int pose = 0; pose < 20; ++pose) {
+    Transform3<S> X_FS = RandomPose<S>(generator, 0.3);
+    X_FS.translation() += Vector3<S>(0.9, 0, 0);
+    const Transform3<S> X_FM = RandomPose<S>(generator, 0.1);
+
+    CollisionResult<S> result;
+    timer.start();
+    collide(&mesh, X_FM, &shape, X_FS, request, result);
+    timer.stop();
+    traversal_time += timer.getElapsedTimeInMicroSec();
+
+    std::vector<int> reported;
+    for (size_t i = 0; i < result.numContacts(); ++i)
+      reported.push_back(result.getContact(i).b1);
+    std::sort(reported.begin(), reported.end());
+
+    std::vector<int> expected;
+    for (int i = 0; i < mesh.num_tris; ++i) {
+      const Triangle& t = mesh.tri_indices[i];
+      if (solver.shapeTriangleIntersect(shape, X_FS, mesh.vertices[t[0]],
+                                        mesh.vertices[t[1]],
+                                        mesh.vertices[t[2]], X_FM))
+        expected.push_back(i);
+    }
+    EXPECT_EQ(reported, expected) << name << " pose " << pose;
+    num_colliding += expected.size();
+  }
+  EXPECT_GT(num_colliding, 0);
+  std::cout << name << "-mesh: " << traversal_time << " us for 20 queries, "
+            << num_colliding << " colliding triangles" << std::endl;
+}
+
+GTEST_TEST(ShapeTrianglesPrimitiveTest, MeshShapeCollision) {
+  CompareMeshShapeWithBruteForce(Box<double>(0.3, 0.2, 0.4), "box");
+  CompareMeshShapeWithBruteForce(Capsule<double>(0.1, 0.4), "capsule");
+}
+
+} // namespace
+} // namespace detail
+} // namespace fcl
+
+//==============================================================================
+int main(int argc, char *argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
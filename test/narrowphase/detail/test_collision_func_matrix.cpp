@@ -74,6 +74,7 @@ std::ostream& operator<<(std::ostream& out, const NODE_TYPE& node) {
     NODE_CASE(GEOM_HALFSPACE)
     NODE_CASE(GEOM_TRIANGLE)
     NODE_CASE(GEOM_OCTREE)
+    NODE_CASE(GEOM_COMPOUND)
     NODE_CASE(NODE_COUNT)
   }
   return out;
@@ -99,13 +100,15 @@ using std::array;
   4 If octomap is available, there should be functions between GEOM_OCTREE
     and every geometry type (in both orderings), with itself, and with each
     BV type (in both orderings).
+  5 There's a function between GEOM_COMPOUND and every geometry type and BV
+    type (in both orderings), and with itself.
 
  Primitive geometries: GEOM_BOX, GEOM_SPHERE, GEOM_ELLIPSOID, GEOM_CAPSULE,
                        GEOM_CONE, GEOM_CYLINDER, GEOM_CONVEX, GEOM_PLANE,
                        GEOM_HALFSPACE
  BV types: BV_AABB, BV_OBB, BV_RSS, BV_kIOS, BV_OBBRSS, BV_KDOP16, BV_KDOP18,
            BV_KDOP24
- Special: GEOM_TRIANGLE, GEOM_OCTREE, NODE_COUNT, BV_UNKNOWN
+ Special: GEOM_TRIANGLE, GEOM_OCTREE, GEOM_COMPOUND, NODE_COUNT, BV_UNKNOWN
 
  NODE_COUNT is merely a convenient symbol for reporting the number of enumerated
  values. BV_UNKNOWN and GEOM_TRIANGLE are not part of the function matrix. */
@@ -148,6 +151,19 @@ void ConfirmSupportedGeometryForSolver() {
     EXPECT_NE(matrix[bv][oct], nullptr) << "(" << bv << ", " << oct << ")";
   }
 #endif
+
+  // 5) Compounds have functions.
+  const NODE_TYPE compound = GEOM_COMPOUND;
+  EXPECT_NE(matrix[compound][compound], nullptr)
+      << "(" << compound << ", " << compound << ")";
+  for (const NODE_TYPE& g: geoms) {
+    EXPECT_NE(matrix[compound][g], nullptr) << "(" << compound << ", " << g << ")";
+    EXPECT_NE(matrix[g][compound], nullptr) << "(" << g << ", " << compound << ")";
+  }
+  for (const NODE_TYPE& bv: bvs) {
+    EXPECT_NE(matrix[compound][bv], nullptr) << "(" << compound << ", " << bv << ")";
+    EXPECT_NE(matrix[bv][compound], nullptr) << "(" << bv << ", " << compound << ")";
+  }
 }
 
 GTEST_TEST(CollisionFuncMatrix, LibCccdSolverSupport) {
@@ -0,0 +1,154 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "fcl/geometry/bvh/BVH_compressed.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/detail/traversal/collision_node.h"
+#include "test_fcl_utility.h"
+
+#include "fcl_resources/config.h"
+
+using namespace fcl;
+
+template <typename BV, typename Q>
+std::size_t collide_compressed_Test(
+    const BVHCompressed<BV, Q>& m1, const Transform3<typename BV::S>& tf1,
+    const BVHCompressed<BV, Q>& m2, const Transform3<typename BV::S>& tf2)
+{
+  using S = typename BV::S;
+
+  CollisionResult<S> local_result;
+  detail::MeshCompressedCollisionTraversalNode<BV, Q> node;
+
+  if(!detail::initialize(node, m1, tf1, m2, tf2,
+                         CollisionRequest<S>(std::numeric_limits<int>::max(), false), local_result))
+    std::cout << "initialize error" << std::endl;
+
+  detail::collide(&node);
+
+  return local_result.numContacts();
+}
+
+template <typename BV>
+void test_compressed_collision()
+{
+  using S = typename BV::S;
+
+  std::vector<Vector3<S>> p1, p2;
+  std::vector<Triangle> t1, t2;
+
+  test::loadOBJFile(TEST_RESOURCES_DIR"/env.obj", p1, t1);
+  test::loadOBJFile(TEST_RESOURCES_DIR"/rob.obj", p2, t2);
+
+  BVHModel<BV> m1;
+  m1.beginModel();
+  m1.addSubModel(p1, t1);
+  m1.endModel();
+
+  BVHModel<BV> m2;
+  m2.beginModel();
+  m2.addSubModel(p2, t2);
+  m2.endModel();
+
+  BVHCompressed16<BV> c1_16(m1);
+  BVHCompressed16<BV> c2_16(m2);
+  BVHCompressed8<BV> c1_8(m1);
+  BVHCompressed8<BV> c2_8(m2);
+
+  EXPECT_EQ(c1_16.getNumBVs(), m1.getNumBVs());
+  EXPECT_LT(c1_16.hierarchyMemUsage() * 2,
+            sizeof(BVNode<BV>) * m1.getNumBVs());
+  EXPECT_LT(c1_8.hierarchyMemUsage(), c1_16.hierarchyMemUsage());
+
+  aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-3000, -3000, 0, 3000, 3000, 3000};
+#ifdef NDEBUG
+  std::size_t n = 100;
+#else
+  std::size_t n = 10;
+#endif
+
+  test::generateRandomTransforms(extents, transforms, n);
+
+  const Transform3<S> pose1 = Transform3<S>::Identity();
+  std::size_t num_colliding = 0;
+  for(std::size_t i = 0; i < transforms.size(); ++i)
+  {
+    // The culling of the compressed trees is conservative and the leaf tests
+    // are exact, so the same triangle pairs must be reported
+    CollisionRequest<S> request(std::numeric_limits<int>::max(), false);
+    CollisionResult<S> result;
+    collide(&m1, pose1, &m2, transforms[i], request, result);
+
+    EXPECT_EQ(collide_compressed_Test(c1_16, pose1, c2_16, transforms[i]),
+              result.numContacts());
+    EXPECT_EQ(collide_compressed_Test(c1_8, pose1, c2_8, transforms[i]),
+              result.numContacts());
+
+    if(result.isCollision()) ++num_colliding;
+  }
+
+  EXPECT_GT(num_colliding, 0u);
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BVH_COMPRESSED, collision_obbrss)
+{
+  test_compressed_collision<OBBRSS<double>>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BVH_COMPRESSED, collision_aabb)
+{
+  test_compressed_collision<AABB<double>>();
+}
+
+//==============================================================================
+GTEST_TEST(FCL_BVH_COMPRESSED, invalid_model)
+{
+  BVHModel<OBBRSS<double>> model;
+  BVHCompressed16<OBBRSS<double>> compressed(model);
+  EXPECT_FALSE(compressed.isValid());
+  EXPECT_EQ(compressed.getNumBVs(), 0);
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -38,6 +38,8 @@
 
 #include "fcl/config.h"
 #include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/narrowphase/collision.h"
 #include "test_fcl_utility.h"
 #include <iostream>
 
@@ -194,6 +196,289 @@ void testBVHModelSubModel()
   EXPECT_EQ(model->build_state, BVH_BUILD_STATE_PROCESSED);
 }
 
+template<typename BV>
+void expectSameHierarchy(const BVHModel<BV>& model1, const BVHModel<BV>& model2)
+{
+  ASSERT_EQ(model1.getNumBVs(), model2.getNumBVs());
+  for(int i = 0; i < model1.getNumBVs(); ++i)
+  {
+    EXPECT_EQ(model1.getBV(i).first_child, model2.getBV(i).first_child);
+    EXPECT_TRUE(model1.getBV(i).bv.min_ == model2.getBV(i).bv.min_);
+    EXPECT_TRUE(model1.getBV(i).bv.max_ == model2.getBV(i).bv.max_);
+  }
+}
+
+template<typename BV>
+void testBVHModelUpdateVertices()
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> model;
+  generateBVHModel(model, Sphere<S>(1.0), Transform3<S>::Identity(), 32, 32);
+
+  std::vector<Vector3<S>> points(model.vertices, model.vertices + model.num_vertices);
+
+  // Bring the internal nodes to the bottom-up fit, which updateVertices()
+  // maintains
+  EXPECT_EQ(model.beginReplaceModel(), BVH_OK);
+  EXPECT_EQ(model.replaceSubModel(points), BVH_OK);
+  EXPECT_EQ(model.endReplaceModel(true, true), BVH_OK);
+
+  BVHModel<BV> reference(model);
+
+  std::vector<int> indices;
+  std::vector<Vector3<S>> moved;
+  for(int i = 0; i < model.num_vertices; i += 7)
+  {
+    indices.push_back(i);
+    moved.push_back(points[i] * 1.1 + Vector3<S>(0.01, 0.02, -0.03));
+    points[i] = moved.back();
+  }
+
+  EXPECT_EQ(model.updateVertices(indices, moved), BVH_OK);
+  EXPECT_EQ(model.build_state, BVH_BUILD_STATE_UPDATED);
+
+  EXPECT_EQ(reference.beginReplaceModel(), BVH_OK);
+  EXPECT_EQ(reference.replaceSubModel(points), BVH_OK);
+  EXPECT_EQ(reference.endReplaceModel(true, true), BVH_OK);
+
+  expectSameHierarchy(model, reference);
+
+  // Invalid input leaves the model untouched
+  indices.push_back(model.num_vertices);
+  moved.push_back(Vector3<S>::Zero());
+  EXPECT_EQ(model.updateVertices(indices, moved), BVH_ERR_INCORRECT_DATA);
+  EXPECT_EQ(model.updateVertices(indices, std::vector<Vector3<S>>()), BVH_ERR_INCORRECT_DATA);
+
+  BVHModel<BV> empty;
+  EXPECT_EQ(empty.updateVertices(std::vector<int>(), std::vector<Vector3<S>>()), BVH_ERR_BUILD_OUT_OF_SEQUENCE);
+}
+
+template<typename BV>
+void testBVHModelUpdateVerticesWithPrevious()
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> model;
+  generateBVHModel(model, Sphere<S>(1.0), Transform3<S>::Identity(), 32, 32);
+
+  // Give the model a previous frame
+  std::vector<Vector3<S>> points(model.vertices, model.vertices + model.num_vertices);
+  for(auto& p : points)
+    p *= 1.05;
+  EXPECT_EQ(model.beginUpdateModel(), BVH_OK);
+  EXPECT_EQ(model.updateSubModel(points), BVH_OK);
+  EXPECT_EQ(model.endUpdateModel(true, true), BVH_OK);
+  ASSERT_TRUE(model.prev_vertices != nullptr);
+
+  for(int step = 0; step < 2; ++step)
+  {
+    const std::vector<Vector3<S>> before(model.vertices, model.vertices + model.num_vertices);
+    const std::vector<Vector3<S>> prev_before(model.prev_vertices, model.prev_vertices + model.num_vertices);
+
+    std::vector<int> indices;
+    std::vector<Vector3<S>> moved;
+    for(int i = step; i < model.num_vertices; i += 11)
+    {
+      indices.push_back(i);
+      moved.push_back(before[i] + Vector3<S>(0.02, -0.01, 0.03));
+    }
+
+    EXPECT_EQ(model.updateVertices(indices, moved), BVH_OK);
+
+    std::vector<bool> is_moved(model.num_vertices, false);
+    for(int i : indices)
+      is_moved[i] = true;
+
+    // The triangles using a moved vertex start their step from the position
+    // before the call, the other ones are untouched
+    std::vector<bool> in_dirty_triangle(model.num_vertices, false);
+    for(int i = 0; i < model.num_tris; ++i)
+    {
+      const Triangle& t = model.tri_indices[i];
+      if(is_moved[t[0]] || is_moved[t[1]] || is_moved[t[2]])
+      {
+        for(int k = 0; k < 3; ++k)
+          in_dirty_triangle[t[k]] = true;
+      }
+    }
+
+    for(int i = 0; i < model.num_vertices; ++i)
+    {
+      if(in_dirty_triangle[i])
+      {
+        EXPECT_TRUE(model.prev_vertices[i] == before[i]);
+      }
+      else
+      {
+        EXPECT_TRUE(model.prev_vertices[i] == prev_before[i]);
+      }
+    }
+
+    // Every leaf contains its triangle in both frames
+    for(int i = 0; i < model.getNumBVs(); ++i)
+    {
+      const BVNode<BV>& node = model.getBV(i);
+      if(!node.isLeaf())
+        continue;
+      const Triangle& t = model.tri_indices[node.primitiveId()];
+      for(int k = 0; k < 3; ++k)
+      {
+        EXPECT_TRUE(node.bv.contain(model.vertices[t[k]]));
+        EXPECT_TRUE(node.bv.contain(model.prev_vertices[t[k]]));
+      }
+    }
+  }
+
+  // A vertex given twice is rejected and nothing moves
+  const std::vector<Vector3<S>> before(model.vertices, model.vertices + model.num_vertices);
+  std::vector<int> indices = {3, 5, 3};
+  std::vector<Vector3<S>> moved(3, Vector3<S>::Zero());
+  EXPECT_EQ(model.updateVertices(indices, moved), BVH_ERR_INCORRECT_DATA);
+  for(int i = 0; i < model.num_vertices; ++i)
+    EXPECT_TRUE(model.vertices[i] == before[i]);
+}
+
+template<typename BV>
+void testBVHModelParallelRefit()
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> model;
+  generateBVHModel(model, Sphere<S>(1.0), Transform3<S>::Identity(), 32, 32);
+
+  std::vector<Vector3<S>> points(model.vertices, model.vertices + model.num_vertices);
+  for(auto& p : points)
+    p = Vector3<S>(p[0] * 2, p[1], p[2] + p[0] * p[1]);
+
+  BVHModel<BV> reference(model);
+
+  EXPECT_EQ(model.beginUpdateModel(), BVH_OK);
+  EXPECT_EQ(model.updateSubModel(points), BVH_OK);
+  EXPECT_EQ(model.endUpdateModel(true, true, 4), BVH_OK);
+
+  EXPECT_EQ(reference.beginUpdateModel(), BVH_OK);
+  EXPECT_EQ(reference.updateSubModel(points), BVH_OK);
+  EXPECT_EQ(reference.endUpdateModel(true, true), BVH_OK);
+
+  expectSameHierarchy(model, reference);
+}
+
+template<typename BV>
+std::size_t countContacts(const BVHModel<BV>& model, const BVHModel<BV>& other)
+{
+  using S = typename BV::S;
+
+  CollisionRequest<S> request(std::numeric_limits<int>::max(), false);
+  CollisionResult<S> result;
+  collide(&model, Transform3<S>::Identity(), &other, Transform3<S>::Identity(), request, result);
+  return result.numContacts();
+}
+
+template<typename BV>
+void testBVHModelRebuildPolicy(bool asynchronous)
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> model;
+  generateBVHModel(model, Sphere<S>(1.0), Transform3<S>::Identity(), 32, 32);
+  EXPECT_LE(model.getQualityRatio(), 1.0);
+  EXPECT_GT(model.getHierarchyCost(), 0.0);
+
+  BVHModel<BV> box;
+  generateBVHModel(box, Box<S>(1.0, 1.0, 3.0), Transform3<S>::Identity());
+
+  // Scramble the vertices, the hierarchy of the sphere becomes useless
+  std::vector<int> indices(model.num_vertices);
+  std::vector<Vector3<S>> points(model.num_vertices);
+  for(int i = 0; i < model.num_vertices; ++i)
+  {
+    indices[i] = i;
+    points[i] = model.vertices[(i * 37) % model.num_vertices];
+  }
+
+  BVHModel<BV> degraded(model);
+  EXPECT_EQ(degraded.updateVertices(indices, points), BVH_OK);
+  EXPECT_GT(degraded.getQualityRatio(), 2.0);
+  EXPECT_FALSE(degraded.isRebuildPending());
+
+  model.setRebuildPolicy(2.0, asynchronous);
+  EXPECT_EQ(model.updateVertices(indices, points), BVH_OK);
+  if(asynchronous)
+  {
+    EXPECT_TRUE(model.isRebuildPending());
+    EXPECT_EQ(model.finishRebuild(), BVH_OK);
+  }
+  EXPECT_FALSE(model.isRebuildPending());
+  EXPECT_LE(model.getQualityRatio(), 1.0 + 1e-12);
+  EXPECT_LT(model.getHierarchyCost(), degraded.getHierarchyCost());
+
+  // The rebuilt hierarchy answers the same queries
+  BVHModel<BV> fresh;
+  fresh.beginModel();
+  fresh.addSubModel(points, std::vector<Triangle>(model.tri_indices, model.tri_indices + model.num_tris));
+  fresh.endModel();
+
+  EXPECT_EQ(countContacts(model, box), countContacts(fresh, box));
+  EXPECT_EQ(countContacts(degraded, box), countContacts(fresh, box));
+  EXPECT_GT(countContacts(fresh, box), 0u);
+}
+
+template<typename BV>
+class MedianSplitter : public detail::BVSplitter<BV>
+{
+public:
+  MedianSplitter() : detail::BVSplitter<BV>(detail::SPLIT_METHOD_MEDIAN) {}
+};
+
+template<typename BV>
+void testBVHModelRebuildDrop()
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> model;
+  generateBVHModel(model, Sphere<S>(1.0), Transform3<S>::Identity(), 32, 32);
+
+  std::vector<int> indices(model.num_vertices);
+  std::vector<Vector3<S>> points(model.num_vertices);
+  for(int i = 0; i < model.num_vertices; ++i)
+  {
+    indices[i] = i;
+    points[i] = model.vertices[(i * 37) % model.num_vertices];
+  }
+
+  // A full rebuild drops the background rebuild
+  BVHModel<BV> dropped(model);
+  dropped.setRebuildPolicy(2.0, true);
+  EXPECT_EQ(dropped.updateVertices(indices, points), BVH_OK);
+  EXPECT_TRUE(dropped.isRebuildPending());
+  EXPECT_EQ(dropped.beginUpdateModel(), BVH_OK);
+  EXPECT_EQ(dropped.updateSubModel(points), BVH_OK);
+  EXPECT_EQ(dropped.endUpdateModel(false), BVH_OK);
+  EXPECT_FALSE(dropped.isRebuildPending());
+  EXPECT_LE(dropped.getQualityRatio(), 1.0 + 1e-12);
+
+  // So does the destruction of the model
+  {
+    BVHModel<BV> destroyed(model);
+    destroyed.setRebuildPolicy(2.0, true);
+    EXPECT_EQ(destroyed.updateVertices(indices, points), BVH_OK);
+    EXPECT_TRUE(destroyed.isRebuildPending());
+  }
+
+  // A model with its own splitter is rebuilt in place
+  BVHModel<BV> custom;
+  custom.bv_splitter.reset(new MedianSplitter<BV>());
+  custom.beginModel();
+  custom.addSubModel(std::vector<Vector3<S>>(model.vertices, model.vertices + model.num_vertices),
+                     std::vector<Triangle>(model.tri_indices, model.tri_indices + model.num_tris));
+  custom.endModel();
+  custom.setRebuildPolicy(2.0, true);
+  EXPECT_EQ(custom.updateVertices(indices, points), BVH_OK);
+  EXPECT_FALSE(custom.isRebuildPending());
+  EXPECT_LE(custom.getQualityRatio(), 1.0 + 1e-12);
+}
+
 template<typename BV>
 void testBVHModel()
 {
@@ -223,6 +508,26 @@ GTEST_TEST(FCL_BVH_MODELS, building_bvh_models)
   testBVHModel<KDOP<double, 24> >();
 }
 
+GTEST_TEST(FCL_BVH_MODELS, update_vertices)
+{
+  testBVHModelUpdateVertices<AABB<double>>();
+  testBVHModelUpdateVerticesWithPrevious<AABB<double>>();
+}
+
+GTEST_TEST(FCL_BVH_MODELS, parallel_refit)
+{
+  testBVHModelParallelRefit<AABB<double>>();
+}
+
+GTEST_TEST(FCL_BVH_MODELS, rebuild_on_degradation)
+{
+  testBVHModelRebuildPolicy<AABB<double>>(false);
+  testBVHModelRebuildPolicy<OBBRSS<double>>(false);
+  testBVHModelRebuildPolicy<AABB<double>>(true);
+  testBVHModelRebuildPolicy<OBBRSS<double>>(true);
+  testBVHModelRebuildDrop<AABB<double>>();
+}
+
 //==============================================================================
 int main(int argc, char* argv[])
 {
@@ -0,0 +1,249 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "fcl/geometry/compound.h"
+#include "fcl/geometry/convex_decomposition.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+#include "test_fcl_utility.h"
+
+#include "fcl_resources/config.h"
+
+using namespace fcl;
+
+template <typename S>
+std::shared_ptr<Compound<S>> makeTwoBoxes()
+{
+  auto compound = std::make_shared<Compound<S>>();
+  Transform3<S> tf = Transform3<S>::Identity();
+  tf.translation() = Vector3<S>(-2, 0, 0);
+  compound->addChild(std::make_shared<Box<S>>(1, 1, 1), tf);
+  tf.translation() = Vector3<S>(2, 0, 0);
+  compound->addChild(std::make_shared<Box<S>>(1, 1, 1), tf);
+  compound->computeLocalAABB();
+  return compound;
+}
+
+//==============================================================================
+template <typename S>
+void test_compound_collision()
+{
+  auto compound = makeTwoBoxes<S>();
+  EXPECT_EQ(compound->getNumChildren(), 2);
+  EXPECT_EQ(compound->getNumBVs(), 3);
+  EXPECT_NEAR(compound->aabb_local.min_[0], -2.5, 1e-12);
+  EXPECT_NEAR(compound->aabb_local.max_[0], 2.5, 1e-12);
+
+  Sphere<S> sphere(0.5);
+  Transform3<S> tf = Transform3<S>::Identity();
+  Transform3<S> sphere_tf = Transform3<S>::Identity();
+
+  CollisionRequest<S> request(10, true);
+  CollisionResult<S> result;
+
+  // between the boxes
+  EXPECT_EQ(collide(compound.get(), tf, &sphere, sphere_tf, request, result), 0u);
+
+  // on the second box, from both sides of the call
+  sphere_tf.translation() = Vector3<S>(2.6, 0, 0);
+  result.clear();
+  EXPECT_GT(collide(compound.get(), tf, &sphere, sphere_tf, request, result), 0u);
+  EXPECT_EQ(result.getContact(0).o1, compound.get());
+  EXPECT_EQ(result.getContact(0).b1, 1);
+  EXPECT_EQ(result.getContact(0).o2, &sphere);
+
+  result.clear();
+  EXPECT_GT(collide(&sphere, sphere_tf, compound.get(), tf, request, result), 0u);
+  EXPECT_EQ(result.getContact(0).o2, compound.get());
+  EXPECT_EQ(result.getContact(0).b2, 1);
+
+  // the pose of the compound moves the children
+  tf.translation() = Vector3<S>(-4, 0, 0);
+  result.clear();
+  EXPECT_EQ(collide(compound.get(), tf, &sphere, sphere_tf, request, result), 0u);
+  sphere_tf.translation() = Vector3<S>(-2, 0, 0);
+  result.clear();
+  EXPECT_GT(collide(compound.get(), tf, &sphere, sphere_tf, request, result), 0u);
+  EXPECT_EQ(result.getContact(0).b1, 1);
+
+  // compound against compound and against a mesh
+  auto other = makeTwoBoxes<S>();
+  Transform3<S> other_tf = Transform3<S>::Identity();
+  other_tf.translation() = Vector3<S>(0, 0, 0.9);
+  tf.setIdentity();
+  result.clear();
+  EXPECT_GT(collide(compound.get(), tf, other.get(), other_tf, request, result), 0u);
+  for(std::size_t i = 0; i < result.numContacts(); ++i)
+  {
+    EXPECT_EQ(result.getContact(i).o1, compound.get());
+    EXPECT_EQ(result.getContact(i).o2, other.get());
+    EXPECT_EQ(result.getContact(i).b1, result.getContact(i).b2);
+  }
+
+  BVHModel<OBBRSS<S>> mesh;
+  generateBVHModel(mesh, Box<S>(1, 1, 1), Transform3<S>::Identity());
+  Transform3<S> mesh_tf = Transform3<S>::Identity();
+  mesh_tf.translation() = Vector3<S>(-2, 0.9, 0);
+  result.clear();
+  EXPECT_GT(collide(&mesh, mesh_tf, compound.get(), tf, request, result), 0u);
+  for(std::size_t i = 0; i < result.numContacts(); ++i)
+  {
+    EXPECT_EQ(result.getContact(i).o2, compound.get());
+    EXPECT_EQ(result.getContact(i).b2, 0);
+  }
+
+  mesh_tf.translation() = Vector3<S>(0, 0.9, 0);
+  result.clear();
+  EXPECT_EQ(collide(&mesh, mesh_tf, compound.get(), tf, request, result), 0u);
+}
+
+GTEST_TEST(FCL_COMPOUND, collision)
+{
+  test_compound_collision<double>();
+}
+
+//==============================================================================
+template <typename S>
+void test_compound_distance()
+{
+  auto compound = makeTwoBoxes<S>();
+
+  Sphere<S> sphere(0.5);
+  Transform3<S> tf = Transform3<S>::Identity();
+  Transform3<S> sphere_tf = Transform3<S>::Identity();
+  sphere_tf.translation() = Vector3<S>(-0.5, 0, 0);
+
+  DistanceRequest<S> request(true);
+  DistanceResult<S> result;
+  EXPECT_NEAR(distance(compound.get(), tf, &sphere, sphere_tf, request, result), 0.5, 1e-6);
+  EXPECT_EQ(result.o1, compound.get());
+  EXPECT_EQ(result.b1, 0);
+  EXPECT_NEAR(result.nearest_points[0][0], -1.5, 1e-6);
+
+  result.clear();
+  EXPECT_NEAR(distance(&sphere, sphere_tf, compound.get(), tf, request, result), 0.5, 1e-6);
+  EXPECT_EQ(result.o2, compound.get());
+  EXPECT_EQ(result.b2, 0);
+
+  auto other = makeTwoBoxes<S>();
+  Transform3<S> other_tf = Transform3<S>::Identity();
+  other_tf.translation() = Vector3<S>(0.5, 3, 0);
+  result.clear();
+  EXPECT_NEAR(distance(compound.get(), tf, other.get(), other_tf, request, result), 2.0, 1e-6);
+}
+
+GTEST_TEST(FCL_COMPOUND, distance)
+{
+  test_compound_distance<double>();
+}
+
+//==============================================================================
+template <typename S>
+bool insideConvex(const Convex<S>& convex, const Vector3<S>& p, S tolerance)
+{
+  const auto& vertices = convex.getVertices();
+  const auto& faces = convex.getFaces();
+  int index = 0;
+  for(int f = 0; f < convex.getFaceCount(); ++f)
+  {
+    const int n = faces[index];
+    const Vector3<S>& a = vertices[faces[index + 1]];
+    const Vector3<S>& b = vertices[faces[index + 2]];
+    const Vector3<S>& c = vertices[faces[index + 3]];
+    const Vector3<S> normal = (b - a).cross(c - a).normalized();
+    if(normal.dot(p - a) > tolerance)
+      return false;
+    index += n + 1;
+  }
+  return true;
+}
+
+template <typename S>
+void test_convex_decomposition()
+{
+  // a convex mesh stays in one piece
+  BVHModel<OBBRSS<S>> box;
+  generateBVHModel(box, Box<S>(1, 2, 3), Transform3<S>::Identity());
+  auto single = convexDecomposition(box, 1e-6);
+  ASSERT_TRUE(single != nullptr);
+  EXPECT_EQ(single->getNumChildren(), 1);
+
+  std::vector<Vector3<S>> points;
+  std::vector<Triangle> triangles;
+  test::loadOBJFile(TEST_RESOURCES_DIR"/rob.obj", points, triangles);
+  BVHModel<OBBRSS<S>> rob;
+  rob.beginModel();
+  rob.addSubModel(points, triangles);
+  rob.endModel();
+
+  auto pieces = convexDecomposition(rob, 1.0, 16);
+  ASSERT_TRUE(pieces != nullptr);
+  EXPECT_GT(pieces->getNumChildren(), 1);
+  EXPECT_LE(pieces->getNumChildren(), 16);
+
+  // every vertex of the mesh is covered by a piece
+  for(const auto& p : points)
+  {
+    bool covered = false;
+    for(int i = 0; i < pieces->getNumChildren() && !covered; ++i)
+    {
+      const auto* convex = static_cast<const Convex<S>*>(pieces->getChild(i).get());
+      covered = insideConvex(*convex, p, S(1e-6));
+    }
+    EXPECT_TRUE(covered);
+  }
+
+  // flat meshes cannot be decomposed
+  BVHModel<OBBRSS<S>> flat;
+  flat.beginModel();
+  flat.addTriangle(Vector3<S>(0, 0, 0), Vector3<S>(1, 0, 0), Vector3<S>(0, 1, 0));
+  flat.endModel();
+  EXPECT_TRUE(convexDecomposition(flat, 1.0) == nullptr);
+}
+
+GTEST_TEST(FCL_COMPOUND, convex_decomposition)
+{
+  test_convex_decomposition<double>();
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
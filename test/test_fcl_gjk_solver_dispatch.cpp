@@ -0,0 +1,179 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "fcl/geometry/bvh/BVH_model.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/distance.h"
+#include "fcl/narrowphase/gjk_solver_dispatch.h"
+
+using namespace fcl;
+
+//==============================================================================
+void checkTable(const GJKSolverDispatch& dispatch)
+{
+  for(int i = 0; i < NODE_COUNT; ++i)
+  {
+    for(int j = 0; j < NODE_COUNT; ++j)
+    {
+      const GJKSolverType type = dispatch.getSolverType(
+          static_cast<NODE_TYPE>(i), static_cast<NODE_TYPE>(j));
+      EXPECT_TRUE(type == GST_LIBCCD || type == GST_INDEP);
+      EXPECT_EQ(type, dispatch.getSolverType(static_cast<NODE_TYPE>(j),
+                                             static_cast<NODE_TYPE>(i)));
+    }
+  }
+}
+
+//==============================================================================
+GTEST_TEST(FCL_GJK_SOLVER_DISPATCH, table)
+{
+  GJKSolverDispatch dispatch;
+  checkTable(dispatch);
+
+  dispatch.setSolverType(GEOM_CONE, GEOM_ELLIPSOID, GST_INDEP);
+  EXPECT_EQ(dispatch.getSolverType(GEOM_ELLIPSOID, GEOM_CONE), GST_INDEP);
+  dispatch.setSolverType(GEOM_ELLIPSOID, GEOM_CONE, GST_LIBCCD);
+  EXPECT_EQ(dispatch.getSolverType(GEOM_CONE, GEOM_ELLIPSOID), GST_LIBCCD);
+
+  // GST_AUTO is not stored
+  dispatch.setSolverType(GEOM_CONE, GEOM_ELLIPSOID, GST_AUTO);
+  EXPECT_EQ(dispatch.getSolverType(GEOM_CONE, GEOM_ELLIPSOID), GST_LIBCCD);
+
+  EXPECT_EQ(resolveGJKSolverType(GST_INDEP, GEOM_BOX, GEOM_SPHERE), GST_INDEP);
+  EXPECT_EQ(resolveGJKSolverType(GST_AUTO, GEOM_BOX, GEOM_SPHERE),
+            GJKSolverDispatch::getDefault().getSolverType(GEOM_BOX,
+                                                          GEOM_SPHERE));
+}
+
+//==============================================================================
+GTEST_TEST(FCL_GJK_SOLVER_DISPATCH, calibrate)
+{
+  GJKSolverDispatch dispatch;
+  dispatch.calibrate<double>(20);
+  checkTable(dispatch);
+
+  // Pairs that calibrate() does not measure keep the bundled choice
+  const GJKSolverDispatch bundled;
+  EXPECT_EQ(dispatch.getSolverType(GEOM_HALFSPACE, GEOM_BOX),
+            bundled.getSolverType(GEOM_HALFSPACE, GEOM_BOX));
+  EXPECT_EQ(dispatch.getSolverType(BV_OBBRSS, BV_OBBRSS),
+            bundled.getSolverType(BV_OBBRSS, BV_OBBRSS));
+
+  dispatch.reset();
+  for(int i = 0; i < NODE_COUNT; ++i)
+  {
+    for(int j = 0; j < NODE_COUNT; ++j)
+    {
+      EXPECT_EQ(dispatch.getSolverType(static_cast<NODE_TYPE>(i),
+                                       static_cast<NODE_TYPE>(j)),
+                bundled.getSolverType(static_cast<NODE_TYPE>(i),
+                                      static_cast<NODE_TYPE>(j)));
+    }
+  }
+}
+
+//==============================================================================
+// With GST_AUTO, a query gives the result of the solver the default table
+// picks for the pair.
+template <typename S>
+void checkAutoQueries(const CollisionGeometry<S>* o1, const Transform3<S>& tf1,
+                      const CollisionGeometry<S>* o2, const Transform3<S>& tf2)
+{
+  const GJKSolverType type = resolveGJKSolverType(
+      GST_AUTO, o1->getNodeType(), o2->getNodeType());
+
+  CollisionRequest<S> collision_request;
+  collision_request.num_max_contacts = 10;
+  collision_request.enable_contact = true;
+  collision_request.gjk_solver_type = GST_AUTO;
+  CollisionResult<S> auto_collision;
+  collide(o1, tf1, o2, tf2, collision_request, auto_collision);
+  collision_request.gjk_solver_type = type;
+  CollisionResult<S> collision;
+  collide(o1, tf1, o2, tf2, collision_request, collision);
+  ASSERT_EQ(auto_collision.numContacts(), collision.numContacts());
+  for(std::size_t i = 0; i < collision.numContacts(); ++i)
+  {
+    EXPECT_EQ(auto_collision.getContact(i).penetration_depth,
+              collision.getContact(i).penetration_depth);
+  }
+
+  DistanceRequest<S> distance_request;
+  distance_request.gjk_solver_type = GST_AUTO;
+  DistanceResult<S> auto_distance;
+  distance(o1, tf1, o2, tf2, distance_request, auto_distance);
+  distance_request.gjk_solver_type = type;
+  DistanceResult<S> result;
+  distance(o1, tf1, o2, tf2, distance_request, result);
+  EXPECT_EQ(auto_distance.min_distance, result.min_distance);
+}
+
+//==============================================================================
+template <typename S>
+void test_auto_queries()
+{
+  Box<S> box(1, 2, 3);
+  Capsule<S> capsule(0.5, 2);
+  Cone<S> cone(1, 2);
+  BVHModel<OBBRSS<S>> mesh;
+  generateBVHModel(mesh, Sphere<S>(1), Transform3<S>::Identity(), 16, 16);
+
+  Transform3<S> tf1 = Transform3<S>::Identity();
+  Transform3<S> tf2 = Transform3<S>::Identity();
+  for(const S x : {S(0.5), S(1.2), S(3)})
+  {
+    tf2.translation() << x, 0.2, 0.1;
+    checkAutoQueries<S>(&box, tf1, &capsule, tf2);
+    checkAutoQueries<S>(&cone, tf1, &box, tf2);
+    checkAutoQueries<S>(&mesh, tf1, &capsule, tf2);
+    checkAutoQueries<S>(&capsule, tf1, &mesh, tf2);
+  }
+}
+
+//==============================================================================
+GTEST_TEST(FCL_GJK_SOLVER_DISPATCH, auto_queries)
+{
+  test_auto_queries<double>();
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,284 @@
+/*
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2011-2014, Willow Garage, Inc.
+ *  Copyright (c) 2014-2016, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of Open Source Robotics Foundation nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include "fcl/geometry/bvh/BVH_signed_distance.h"
+#include "fcl/geometry/geometric_shape_to_BVH_model.h"
+#include "fcl/narrowphase/collision.h"
+#include "fcl/narrowphase/mesh_signed_distance.h"
+#include "test_fcl_utility.h"
+
+using namespace fcl;
+
+template <typename BV>
+void makeBox(BVHModel<BV>& model, typename BV::S size)
+{
+  using S = typename BV::S;
+  generateBVHModel(model, Box<S>(size, size, size), Transform3<S>::Identity());
+}
+
+template <typename BV>
+void makeSphere(BVHModel<BV>& model, typename BV::S radius)
+{
+  using S = typename BV::S;
+  generateBVHModel(model, Sphere<S>(radius), Transform3<S>::Identity(), 32, 32);
+}
+
+//==============================================================================
+template <typename BV>
+void test_point_queries()
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> box;
+  makeBox(box, 2);
+  BVHSignedDistance<BV> sdf(box);
+  EXPECT_TRUE(sdf.isClosed());
+
+  // face, edge and vertex regions, inside and outside
+  EXPECT_NEAR(sdf.signedDistance(Vector3<S>(0, 0, 0)), -1, 1e-12);
+  EXPECT_NEAR(sdf.signedDistance(Vector3<S>(0.5, 0.2, -0.1)), -0.5, 1e-12);
+  EXPECT_NEAR(sdf.signedDistance(Vector3<S>(0.9, 0.9, 0)), -0.1, 1e-12);
+  EXPECT_NEAR(sdf.signedDistance(Vector3<S>(3, 0, 0)), 2, 1e-12);
+  EXPECT_NEAR(sdf.signedDistance(Vector3<S>(2, 2, 0)), std::sqrt(2.0), 1e-12);
+  EXPECT_NEAR(sdf.signedDistance(Vector3<S>(2, 2, 2)), std::sqrt(3.0), 1e-12);
+  EXPECT_NEAR(sdf.signedDistance(Vector3<S>(-2, 0.5, 2)), std::sqrt(2.0), 1e-12);
+
+  Vector3<S> closest;
+  int tri_id;
+  sdf.signedDistance(Vector3<S>(0.2, -3, 0.4), closest, tri_id);
+  EXPECT_TRUE(closest.isApprox(Vector3<S>(0.2, -1, 0.4)));
+  EXPECT_GE(tri_id, 0);
+
+  EXPECT_TRUE(sdf.isInside(Vector3<S>(0.99, -0.99, 0.99)));
+  EXPECT_FALSE(sdf.isInside(Vector3<S>(1.01, 0, 0)));
+
+  // against the analytic sphere, away from the tessellation error
+  BVHModel<BV> sphere;
+  makeSphere(sphere, 1);
+  BVHSignedDistance<BV> sphere_sdf(sphere);
+  EXPECT_TRUE(sphere_sdf.isClosed());
+
+  aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-2, -2, -2, 2, 2, 2};
+  test::generateRandomTransforms(extents, transforms, 200);
+  for(const auto& tf : transforms)
+  {
+    const Vector3<S> p = tf.translation();
+    const S expected = p.norm() - 1;
+    if(std::abs(expected) < 0.02) continue;
+    EXPECT_NEAR(sphere_sdf.signedDistance(p), expected, 0.01);
+  }
+}
+
+GTEST_TEST(FCL_MESH_SIGNED_DISTANCE, point_queries)
+{
+  test_point_queries<OBBRSS<double>>();
+  test_point_queries<AABB<double>>();
+}
+
+//==============================================================================
+template <typename BV>
+void test_mesh_mesh()
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> big, small;
+  makeBox(big, 2);
+  makeBox(small, 1);
+  BVHSignedDistance<BV> big_sdf(big);
+  BVHSignedDistance<BV> small_sdf(small);
+
+  DistanceRequest<S> request(true);
+  const Transform3<S> identity = Transform3<S>::Identity();
+
+  // separated: the regular distance
+  {
+    Transform3<S> tf = identity;
+    tf.translation() = Vector3<S>(2.5, 0, 0);
+    DistanceResult<S> result;
+    EXPECT_NEAR(meshSignedDistance(big_sdf, identity, small_sdf, tf, request, result), 1, 1e-12);
+  }
+
+  // face overlap: the corners of the small box are the deepest points
+  {
+    Transform3<S> tf = identity;
+    tf.translation() = Vector3<S>(1.2, 0, 0);
+    DistanceResult<S> result;
+    EXPECT_NEAR(meshSignedDistance(big_sdf, identity, small_sdf, tf, request, result), -0.3, 1e-12);
+    EXPECT_NEAR(result.nearest_points[1][0], 0.7, 1e-12);
+    EXPECT_NEAR(result.nearest_points[0][0], 1, 1e-12);
+    EXPECT_EQ(result.o1, &big);
+    EXPECT_EQ(result.o2, &small);
+
+    // the pair order does not change the value
+    DistanceResult<S> swapped;
+    EXPECT_NEAR(meshSignedDistance(small_sdf, tf, big_sdf, identity, request, swapped), -0.3, 1e-12);
+    EXPECT_NEAR(swapped.nearest_points[0][0], 0.7, 1e-12);
+  }
+
+  // containment: no surface contact, the deepest corner is 0.5 inside
+  {
+    Transform3<S> tf = identity;
+    tf.translation() = Vector3<S>(0.1, 0, 0);
+    DistanceResult<S> plain;
+    EXPECT_GT(distance(&big, identity, &small, tf, request, plain), 0);
+
+    DistanceResult<S> result;
+    EXPECT_NEAR(meshSignedDistance(big_sdf, identity, small_sdf, tf, request, result), -0.5, 1e-12);
+  }
+}
+
+GTEST_TEST(FCL_MESH_SIGNED_DISTANCE, mesh_mesh)
+{
+  test_mesh_mesh<OBBRSS<double>>();
+  test_mesh_mesh<RSS<double>>();
+}
+
+GTEST_TEST(FCL_MESH_SIGNED_DISTANCE, invalid_model)
+{
+  using S = double;
+
+  BVHModel<OBBRSS<S>> empty;
+  BVHSignedDistance<OBBRSS<S>> invalid(empty);
+  EXPECT_FALSE(invalid.isValid());
+  EXPECT_EQ(invalid.signedDistance(Vector3<S>::Zero()), std::numeric_limits<S>::max());
+  EXPECT_FALSE(invalid.isInside(Vector3<S>::Zero()));
+  EXPECT_FALSE(invalid.getRootBox().contain(Vector3<S>::Zero()));
+  EXPECT_EQ(invalid.getVertexTriangle(0), -1);
+
+  BVHModel<OBBRSS<S>> box;
+  makeBox(box, 1.0);
+  BVHSignedDistance<OBBRSS<S>> valid(box);
+  EXPECT_TRUE(valid.isValid());
+
+  const Transform3<S> identity = Transform3<S>::Identity();
+  DistanceRequest<S> request;
+  DistanceResult<S> result;
+  EXPECT_EQ(meshSignedDistance(valid, identity, invalid, identity, request, result),
+            std::numeric_limits<S>::max());
+  EXPECT_EQ(meshSignedDistance(invalid, identity, valid, identity, request, result),
+            std::numeric_limits<S>::max());
+
+  int vertex_id = 0;
+  int tri_id = 0;
+  Vector3<S> surface_point;
+  EXPECT_EQ(detail::deepestVertexInside(valid, invalid, identity, vertex_id, surface_point, tri_id), 0.0);
+  EXPECT_EQ(vertex_id, -1);
+  EXPECT_EQ(tri_id, -1);
+}
+
+//==============================================================================
+// Compares against the contact based estimate, the largest per triangle pair
+// penetration depth reported by collide().
+template <typename BV>
+void test_penetration_benchmark()
+{
+  using S = typename BV::S;
+
+  BVHModel<BV> m1, m2;
+  makeSphere(m1, 1);
+  makeSphere(m2, 0.8);
+  BVHSignedDistance<BV> sdf1(m1);
+  BVHSignedDistance<BV> sdf2(m2);
+
+  aligned_vector<Transform3<S>> transforms;
+  S extents[] = {-1.2, -1.2, -1.2, 1.2, 1.2, 1.2};
+#ifdef NDEBUG
+  std::size_t n = 200;
+#else
+  std::size_t n = 20;
+#endif
+  test::generateRandomTransforms(extents, transforms, n);
+
+  const Transform3<S> identity = Transform3<S>::Identity();
+  DistanceRequest<S> request;
+  CollisionRequest<S> collision_request(std::numeric_limits<int>::max(), true);
+
+  double sdf_time = 0;
+  double contact_time = 0;
+  S sdf_error = 0;
+  S contact_error = 0;
+  std::size_t num_tests = 0;
+
+  for(const auto& tf : transforms)
+  {
+    const S expected = 1 + 0.8 - tf.translation().norm();
+    // keep away from grazing and from deep containment
+    if(expected < 0.1 || expected > 0.95) continue;
+    ++num_tests;
+
+    test::Timer timer_sdf;
+    timer_sdf.start();
+    DistanceResult<S> result;
+    const S d = meshSignedDistance(sdf1, identity, sdf2, tf, request, result);
+    timer_sdf.stop();
+    sdf_time += timer_sdf.getElapsedTimeInSec();
+
+    test::Timer timer_contact;
+    timer_contact.start();
+    CollisionResult<S> collision_result;
+    collide(&m1, identity, &m2, tf, collision_request, collision_result);
+    S max_depth = 0;
+    for(std::size_t i = 0; i < collision_result.numContacts(); ++i)
+      max_depth = std::max(max_depth, collision_result.getContact(i).penetration_depth);
+    timer_contact.stop();
+    contact_time += timer_contact.getElapsedTimeInSec();
+
+    EXPECT_NEAR(-d, expected, 0.05);
+    sdf_error += std::abs(-d - expected);
+    contact_error += std::abs(max_depth - expected);
+  }
+
+  if(num_tests == 0) return;
+  std::cout << "mesh signed distance: " << sdf_time << " sec, mean error "
+            << sdf_error / num_tests << std::endl;
+  std::cout << "contact penetration: " << contact_time << " sec, mean error "
+            << contact_error / num_tests << std::endl;
+}
+
+GTEST_TEST(FCL_MESH_SIGNED_DISTANCE, penetration_benchmark)
+{
+  test_penetration_benchmark<OBBRSS<double>>();
+}
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -174,6 +174,8 @@ std::string getNodeTypeName(NODE_TYPE node_type)
     return std::string("GEOM_TRIANGLE");
   else if (node_type == GEOM_OCTREE)
     return std::string("GEOM_OCTREE");
+  else if (node_type == GEOM_COMPOUND)
+    return std::string("GEOM_COMPOUND");
   else
     return std::string("invalid");
 }